@@ -0,0 +1,278 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file resolves host names and opens TCP connections without blocking
+ * the main loop, so keys (especially ESTOP) are handled while connecting.
+ */
+
+#include <Arduino.h>
+#include <lwip/sockets.h>
+#include <lwip/dns.h>
+#include <lwip/priv/tcpip_priv.h>
+#include <mdns.h>
+
+#include "asyncConnect.h"
+
+/**
+ * Socket of the running connection attempt, -1 if none
+ */
+int connectFd = -1;
+
+/**
+ * millis() value when the running connection attempt has been started
+ */
+uint32_t connectStart;
+
+/**
+ * State of the running DNS request, set from the lwIP thread
+ */
+volatile asyncResult resolveState = ASYNC_FAILED;
+
+/**
+ * Result of the running DNS request
+ */
+ip_addr_t resolvedAddr;
+
+/**
+ * Incremented for each request, so late answers to cancelled requests are ignored
+ */
+volatile uint32_t resolveRequest = 0;
+
+/**
+ * Running mDNS request for .local names, nullptr if none
+ */
+mdns_search_once_t * mdnsResolve = nullptr;
+
+/**
+ * millis() value when the running name resolution has been started
+ */
+uint32_t resolveStart;
+
+typedef struct
+{
+  struct tcpip_api_call_data call;
+  const char * host;
+  err_t err;
+} dnsStartRequest;
+
+/**
+ * Called by lwIP when a DNS answer (or timeout) arrives
+ */
+static void dnsFound(const char * name, const ip_addr_t * ipaddr, void * arg)
+{
+  if((uint32_t) (uintptr_t) arg != resolveRequest)
+  {
+    return;
+  }
+  if(ipaddr != nullptr && IP_IS_V4(ipaddr))
+  {
+    resolvedAddr = *ipaddr;
+    resolveState = ASYNC_DONE;
+  }
+  else
+  {
+    (void) name; // log_d() drops its arguments unless debug logging is enabled
+    log_d("No IPv4 address found for %s", name);
+    resolveState = ASYNC_FAILED;
+  }
+}
+
+/**
+ * Runs in the lwIP thread, dns_gethostbyname() must not be called from elsewhere
+ */
+static err_t dnsStart(struct tcpip_api_call_data * data)
+{
+  dnsStartRequest * request = (dnsStartRequest *) data;
+  request->err = dns_gethostbyname(request->host, &resolvedAddr, dnsFound, (void *) (uintptr_t) resolveRequest);
+  return request->err;
+}
+
+/**
+ * Start resolving a host name (through DNS, or mDNS for names ending in .local)
+ *
+ * @returns false if the request could not be started
+ */
+bool startResolve(const char * host)
+{
+  abortConnect();
+  resolveStart = millis();
+
+  size_t length = strlen(host);
+  if(length > 6 && !strcasecmp(host + length - 6, ".local"))
+  {
+    char name[64];
+    snprintf(name, sizeof(name), "%.*s", (int) (length - 6), host);
+    mdnsResolve = mdns_query_async_new(name, nullptr, nullptr, MDNS_TYPE_A, RESOLVE_TIMEOUT_MS, 1, nullptr);
+    resolveState = ASYNC_PENDING;
+    return mdnsResolve != nullptr;
+  }
+
+  dnsStartRequest request;
+  request.host = host;
+  resolveState = ASYNC_PENDING;
+  tcpip_api_call(dnsStart, &request.call);
+
+  if(request.err == ERR_OK)
+  {
+    // answer was in the DNS cache
+    resolveState = IP_IS_V4(&resolvedAddr) ? ASYNC_DONE : ASYNC_FAILED;
+  }
+  else if(request.err != ERR_INPROGRESS)
+  {
+    resolveState = ASYNC_FAILED;
+  }
+  return resolveState != ASYNC_FAILED;
+}
+
+/**
+ * Check the name resolution started by startResolve()
+ *
+ * @param ip receives the address if ASYNC_DONE is returned
+ */
+asyncResult pollResolve(IPAddress & ip)
+{
+  if(mdnsResolve != nullptr)
+  {
+    mdns_result_t * results = nullptr;
+    uint8_t numResults = 0;
+    if(!mdns_query_async_get_results(mdnsResolve, 0, &results, &numResults))
+    {
+      return ASYNC_PENDING;
+    }
+    mdns_query_async_delete(mdnsResolve);
+    mdnsResolve = nullptr;
+    resolveState = ASYNC_FAILED;
+    for(mdns_ip_addr_t * a = results != nullptr ? results->addr : nullptr; a != nullptr; a = a->next)
+    {
+      if(a->addr.type == ESP_IPADDR_TYPE_V4)
+      {
+        ip = IPAddress(a->addr.u_addr.ip4.addr);
+        resolveState = ASYNC_DONE;
+        break;
+      }
+    }
+    mdns_query_results_free(results);
+    return resolveState;
+  }
+
+  if(resolveState == ASYNC_PENDING && millis() - resolveStart > RESOLVE_TIMEOUT_MS)
+  {
+    resolveRequest++;
+    resolveState = ASYNC_FAILED;
+  }
+  if(resolveState == ASYNC_DONE)
+  {
+    ip = IPAddress(ip_2_ip4(&resolvedAddr)->addr);
+  }
+  return resolveState;
+}
+
+/**
+ * Start opening a TCP connection
+ *
+ * @returns false if the connection could not be started
+ */
+bool startConnect(IPAddress ip, uint16_t port)
+{
+  abortConnect();
+
+  connectFd = socket(AF_INET, SOCK_STREAM, 0);
+  if(connectFd < 0)
+  {
+    return false;
+  }
+  fcntl(connectFd, F_SETFL, fcntl(connectFd, F_GETFL, 0) | O_NONBLOCK);
+
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = (uint32_t) ip;
+  address.sin_port = htons(port);
+
+  if(connect(connectFd, (struct sockaddr *) &address, sizeof(address)) < 0 && errno != EINPROGRESS)
+  {
+    log_d("connect() failed: %d", errno);
+    abortConnect();
+    return false;
+  }
+  connectStart = millis();
+  return true;
+}
+
+/**
+ * Check the connection started by startConnect()
+ *
+ * @param client receives the connection if ASYNC_DONE is returned
+ */
+asyncResult pollConnect(WiFiClient & client)
+{
+  if(connectFd < 0)
+  {
+    return ASYNC_FAILED;
+  }
+
+  fd_set writable;
+  FD_ZERO(&writable);
+  FD_SET(connectFd, &writable);
+  struct timeval noWait = { 0, 0 };
+
+  int ready = select(connectFd + 1, nullptr, &writable, nullptr, &noWait);
+  if(ready == 0)
+  {
+    if(millis() - connectStart < CONNECT_TIMEOUT_MS)
+    {
+      return ASYNC_PENDING;
+    }
+    log_d("connect() timed out");
+    abortConnect();
+    return ASYNC_FAILED;
+  }
+
+  int error = 0;
+  socklen_t length = sizeof(error);
+  if(ready < 0 || getsockopt(connectFd, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0)
+  {
+    log_d("connect() failed: %d", error);
+    abortConnect();
+    return ASYNC_FAILED;
+  }
+
+  // WiFiClient expects a blocking socket, just like after WiFiClient::connect()
+  fcntl(connectFd, F_SETFL, fcntl(connectFd, F_GETFL, 0) & ~O_NONBLOCK);
+  client = WiFiClient(connectFd);
+  connectFd = -1;
+  return ASYNC_DONE;
+}
+
+/**
+ * Cancel running name resolutions and connection attempts
+ */
+void abortConnect(void)
+{
+  if(connectFd >= 0)
+  {
+    close(connectFd);
+    connectFd = -1;
+  }
+  if(mdnsResolve != nullptr)
+  {
+    mdns_query_async_delete(mdnsResolve);
+    mdnsResolve = nullptr;
+  }
+  resolveRequest++;
+  resolveState = ASYNC_FAILED;
+}
@@ -0,0 +1,74 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file resolves host names and opens TCP connections without blocking
+ * the main loop, so keys (especially ESTOP) are handled while connecting.
+ */
+
+#ifndef _ASYNC_CONNECT_H_
+#define _ASYNC_CONNECT_H_
+
+#include <stdint.h>
+#include <WiFiClient.h>
+#include <IPAddress.h>
+
+/**
+ * Time to wait for a TCP connection to be established
+ */
+#define CONNECT_TIMEOUT_MS 3000
+
+/**
+ * Time to wait for a host name to be resolved
+ */
+#define RESOLVE_TIMEOUT_MS 5000
+
+enum asyncResult { ASYNC_PENDING, ASYNC_DONE, ASYNC_FAILED };
+
+/**
+ * Start resolving a host name (through DNS, or mDNS for names ending in .local)
+ *
+ * @returns false if the request could not be started
+ */
+bool startResolve(const char * host);
+
+/**
+ * Check the name resolution started by startResolve()
+ *
+ * @param ip receives the address if ASYNC_DONE is returned
+ */
+asyncResult pollResolve(IPAddress & ip);
+
+/**
+ * Start opening a TCP connection
+ *
+ * @returns false if the connection could not be started
+ */
+bool startConnect(IPAddress ip, uint16_t port);
+
+/**
+ * Check the connection started by startConnect()
+ *
+ * @param client receives the connection if ASYNC_DONE is returned
+ */
+asyncResult pollConnect(WiFiClient & client);
+
+/**
+ * Cancel running name resolutions and connection attempts
+ */
+void abortConnect(void);
+
+#endif
@@ -30,6 +30,7 @@
 #include "wifiHandling.h"
 #include "locoHandling.h"
 #include "throttleHandling.h"
+#include "speedFilter.h"
 
 char * throttleName;
 
@@ -100,6 +101,11 @@ void initConfig(void)
         throttleName = strdup(s);
       }
       centerFunction = doc[FIELD_CONFIG_CENTERSWITCH] | CENTER_FUNCTION_IGNORE;
+      speedHoldoffMin = doc[FIELD_CONFIG_HOLDOFF_MIN] | SPEED_HOLDOFF_MIN_DEFAULT;
+      speedHoldoffMax = doc[FIELD_CONFIG_HOLDOFF_MAX] | SPEED_HOLDOFF_MAX_DEFAULT;
+      speedFilter.medianLength = doc[FIELD_CONFIG_FILTER_MEDIAN] | SPEED_MEDIAN_DEFAULT;
+      speedFilter.iirShift = doc[FIELD_CONFIG_FILTER_IIR] | SPEED_IIR_SHIFT_DEFAULT;
+      speedFilter.binning = doc[FIELD_CONFIG_FILTER_BINNING] | SPEED_BINNING_DEFAULT;
     }
     f.close();
   }
@@ -165,6 +171,52 @@ void initConfig(void)
     }
   }
 
+// read the automatically found server from the last connection
+  if(File f = SPIFFS.open(FN_SERVERCACHE, "r"))
+  {
+    if(!deserializeJson(doc, f))
+    {
+      const char * s = doc[FIELD_SERVERCACHE_HOSTNAME];
+      const char * ssid = doc[FIELD_SERVERCACHE_SSID];
+      // entries without the network they belong to (older firmware) are ignored
+      if(s != nullptr && ssid != nullptr && serverCache.ip.fromString(doc[FIELD_SERVERCACHE_IP] | "")
+         && sscanf(doc[FIELD_SERVERCACHE_BSSID] | "", "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
+                   &serverCache.bssid[0], &serverCache.bssid[1], &serverCache.bssid[2],
+                   &serverCache.bssid[3], &serverCache.bssid[4], &serverCache.bssid[5]) == 6)
+      {
+        strncpy(serverCache.hostname, s, sizeof(serverCache.hostname) - 1);
+        serverCache.hostname[sizeof(serverCache.hostname) - 1] = '\0';
+        strncpy(serverCache.ssid, ssid, sizeof(serverCache.ssid) - 1);
+        serverCache.ssid[sizeof(serverCache.ssid) - 1] = '\0';
+        serverCache.port = doc[FIELD_SERVERCACHE_PORT];
+        serverCache.guessed = false;
+        serverCache.valid = true;
+      }
+    }
+    f.close();
+  }
+
+// read the access point of the last successful connection for a quick reconnect
+  if(File f = SPIFFS.open(FN_LASTAP, "r"))
+  {
+    if(!deserializeJson(doc, f))
+    {
+      const char * s = doc[FIELD_LASTAP_SSID];
+      int channel = doc[FIELD_LASTAP_CHANNEL] | 0;
+      if(s != nullptr && channel > 0
+         && sscanf(doc[FIELD_LASTAP_BSSID] | "", "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx",
+                   &lastAP.bssid[0], &lastAP.bssid[1], &lastAP.bssid[2],
+                   &lastAP.bssid[3], &lastAP.bssid[4], &lastAP.bssid[5]) == 6)
+      {
+        strncpy(lastAP.ssid, s, sizeof(lastAP.ssid) - 1);
+        lastAP.ssid[sizeof(lastAP.ssid) - 1] = '\0';
+        lastAP.channel = channel;
+        lastAP.valid = true;
+      }
+    }
+    f.close();
+  }
+
   // read four loco configurations from SPIFFS if available
   for(uint8_t i = 0; i < 4; i++)
   {
@@ -269,6 +321,11 @@ void saveGeneralConfig(void)
 
   doc[FIELD_NAME_NAME] = throttleName;
   doc[FIELD_CONFIG_CENTERSWITCH] = centerFunction;
+  doc[FIELD_CONFIG_HOLDOFF_MIN] = speedHoldoffMin;
+  doc[FIELD_CONFIG_HOLDOFF_MAX] = speedHoldoffMax;
+  doc[FIELD_CONFIG_FILTER_MEDIAN] = speedFilter.medianLength;
+  doc[FIELD_CONFIG_FILTER_IIR] = speedFilter.iirShift;
+  doc[FIELD_CONFIG_FILTER_BINNING] = speedFilter.binning;
 
   if(File f = SPIFFS.open(FN_CONFIG, "w"))
   {
@@ -363,6 +420,70 @@ void saveWiFiConfig()
   SPIFFS.end();
 }
 
+void saveServerCache()
+{
+  if(!SPIFFS.begin(true))
+  {
+    return;
+  }
+
+  // the LNWI/DCCEX default address is only a guess, do not keep it
+  if(!serverCache.valid || serverCache.guessed)
+  {
+    SPIFFS.remove(FN_SERVERCACHE);
+    SPIFFS.end();
+    return;
+  }
+
+  JsonDocument doc;
+  char bssid[18];
+
+  snprintf(bssid, sizeof(bssid), "%02x:%02x:%02x:%02x:%02x:%02x",
+           serverCache.bssid[0], serverCache.bssid[1], serverCache.bssid[2],
+           serverCache.bssid[3], serverCache.bssid[4], serverCache.bssid[5]);
+
+  doc[FIELD_SERVERCACHE_HOSTNAME] = serverCache.hostname;
+  doc[FIELD_SERVERCACHE_IP] = serverCache.ip.toString();
+  doc[FIELD_SERVERCACHE_PORT] = serverCache.port;
+  doc[FIELD_SERVERCACHE_SSID] = serverCache.ssid;
+  doc[FIELD_SERVERCACHE_BSSID] = bssid;
+
+  if(File f = SPIFFS.open(FN_SERVERCACHE, "w"))
+  {
+    serializeJson(doc, f);
+    f.close();
+  }
+
+  SPIFFS.end();
+}
+
+void saveLastAP()
+{
+  if(!SPIFFS.begin(true))
+  {
+    return;
+  }
+
+  JsonDocument doc;
+  char bssid[18];
+
+  snprintf(bssid, sizeof(bssid), "%02x:%02x:%02x:%02x:%02x:%02x",
+           lastAP.bssid[0], lastAP.bssid[1], lastAP.bssid[2],
+           lastAP.bssid[3], lastAP.bssid[4], lastAP.bssid[5]);
+
+  doc[FIELD_LASTAP_SSID] = lastAP.ssid;
+  doc[FIELD_LASTAP_BSSID] = bssid;
+  doc[FIELD_LASTAP_CHANNEL] = lastAP.channel;
+
+  if(File f = SPIFFS.open(FN_LASTAP, "w"))
+  {
+    serializeJson(doc, f);
+    f.close();
+  }
+
+  SPIFFS.end();
+}
+
 void saveAnalogConfig()
 {
   if(!SPIFFS.begin(true))
@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include "wifiHandling.h"
 #include "locoHandling.h"
+#include "serverDiscovery.h"
 
 // Filenames and field names on SPIFFS
 #define FN_SERVER "/server.txt"
@@ -56,6 +57,23 @@
 
 #define FN_CONFIG "/config.txt"
 #define FIELD_CONFIG_CENTERSWITCH "centerSwitch"
+#define FIELD_CONFIG_HOLDOFF_MIN "speedHoldoffMin"
+#define FIELD_CONFIG_HOLDOFF_MAX "speedHoldoffMax"
+#define FIELD_CONFIG_FILTER_MEDIAN "filterMedian"
+#define FIELD_CONFIG_FILTER_IIR "filterIIR"
+#define FIELD_CONFIG_FILTER_BINNING "filterBinning"
+
+#define FN_SERVERCACHE "/servercache.txt"
+#define FIELD_SERVERCACHE_HOSTNAME "hostname"
+#define FIELD_SERVERCACHE_IP "ip"
+#define FIELD_SERVERCACHE_PORT "port"
+#define FIELD_SERVERCACHE_SSID "ssid"
+#define FIELD_SERVERCACHE_BSSID "bssid"
+
+#define FN_LASTAP "/lastap.txt"
+#define FIELD_LASTAP_SSID "ssid"
+#define FIELD_LASTAP_BSSID "bssid"
+#define FIELD_LASTAP_CHANNEL "channel"
 
 /**
  * A user-given name for this device
@@ -89,6 +107,16 @@ void saveLocoConfig(uint8_t loco);
  */
 void saveWiFiConfig();
 
+/**
+ * Save the automatically found wiThrottle server (removes the file if the cache is not valid)
+ */
+void saveServerCache();
+
+/**
+ * Save the access point of the last successful connection
+ */
+void saveLastAP();
+
 /**
  * Save reference factors for analog inputs
  */
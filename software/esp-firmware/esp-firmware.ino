@@ -55,6 +55,8 @@
 #include "lowbat.h"
 #include "stateMachine.h"
 #include "throttleHandling.h"
+#include "eventHandling.h"
+#include "serverDiscovery.h"
 
 #define DEBUG
 
@@ -69,7 +71,9 @@ void setup() {
   Serial.begin(115200);
   Serial.setTimeout(10);
   initConfig();
+  log_d("Boot phase: configuration read at %u ms", millis());
 
+  initEvents();
   initThrottle();
   
   #ifdef DEBUG
@@ -87,6 +91,8 @@ void setup() {
 void loop() {
   // put your main code here, to run repeatedly:
   handleWiFi();
+  handleDeferredWork();
+  handleServerDiscovery();
   handleThrottle();
 
   // check for empty battery
@@ -98,7 +104,7 @@ void loop() {
       wiFredState != STATE_WAIT_ON_RED_KEY &&
       wiFredState != STATE_STARTUP)
   {
-    switchState(STATE_LOWPOWER_WAITING, 100);
+    switchState(STATE_LOWPOWER_WAITING);
   }
   
   static uint32_t nextOutput = 0;
@@ -107,225 +113,242 @@ void loop() {
   {
     nextOutput = millis() + 5000;
     log_d("Heap: %d", ESP.getFreeHeap());
+    log_d("wiThrottle: %u commands in %u writes", txCommandCount, txWriteCount);
+    log_d("Loop passes per second: %u", loopsPerSecond);
   }
 
-  switch(wiFredState)
+  runStateMachine();
+
+  // send everything generated during this pass in one go
+  locoFlush();
+
+  // sleep until a key or speed change, a state timeout or the next polling interval
+  waitForEvent(stateTimeout);
+}
+
+/**
+ * Handler functions for all states, called once per main loop pass
+ * while in the respective state (see stateTable below)
+ */
+void stateStartup(void)
+{
+  if(getInputState(KEY_ESTOP))
+  {
+    switchState(STATE_WAIT_ON_RED_KEY);
+  }
+  else if(getInputState(KEY_SHIFT))
+  {
+    switchState(STATE_WAIT_ON_YELLOW_KEY);
+  }
+  else
   {
-    case STATE_STARTUP:
-      showVoltageIfOff("0/0", "0/0", "100/200");
-      if(getInputState(KEY_ESTOP))
-      {
-        switchState(STATE_WAIT_ON_RED_KEY, WAIT_ON_KEY_TIMEOUT);
-      }
-      else if(getInputState(KEY_SHIFT))
-      {
-        switchState(STATE_WAIT_ON_YELLOW_KEY, WAIT_ON_KEY_TIMEOUT);
-      }
-      else
-      {
-        switchState(STATE_CONNECTING, TOTAL_NETWORK_TIMEOUT_MS);
-        initWiFiSTA();
-      }
-      break;
-      
-    case STATE_CONNECTING:
-      showVoltageIfOff("0/0", "0/0", "100/200");
-      if(WiFi.status() == WL_CONNECTED)
-      {
-        initMDNS();
-        if(getInputState(KEY_F0))
-        {
-          switchState(STATE_WAIT_ON_F0_KEY, WAIT_ON_KEY_TIMEOUT);
-        }
-        else
-        {
-          switchState(STATE_CONNECTED, TOTAL_NETWORK_TIMEOUT_MS);
-          broadcastUDP();
-        }
-      }
-      else if(millis() > stateTimeout)
-      {
-        initWiFiAP();
-        switchState(STATE_CONFIG_AP);
-      }
-      break;
+    switchState(STATE_CONNECTING);
+  }
+}
 
-    case STATE_CONNECTED:
-      showVoltageIfOff("0/0", "0/0", "25/50");
-      if(WiFi.status() != WL_CONNECTED)
-      {
-        switchState(STATE_STARTUP);
-      }
-      locoConnect();
-      if(millis() > stateTimeout)
-      {
-        initWiFiConfigSTA();
-        switchState(STATE_CONFIG_STATION_WAITING, 120 * 1000);
-      }
-      break;
+void stateConnecting(void)
+{
+  if(WiFi.status() == WL_CONNECTED)
+  {
+    wifiConnected();
+    initMDNS();
+    if(getInputState(KEY_F0))
+    {
+      switchState(STATE_WAIT_ON_F0_KEY);
+    }
+    else
+    {
+      switchState(STATE_CONNECTED);
+      broadcastUDP();
+    }
+  }
+  else if(millis() > stateTimeout)
+  {
+    switchState(STATE_CONFIG_AP);
+  }
+}
 
-    case STATE_LOCO_CONNECTING:
-      if(WiFi.status() != WL_CONNECTED)
-      {
-        switchState(STATE_STARTUP);
-      }
-      locoRegister();
-      if(millis() > stateTimeout)
-      {
-        initWiFiConfigSTA();
-        switchState(STATE_CONFIG_STATION_WAITING, 120 * 1000);
-      }
-      break;
+void stateConnected(void)
+{
+  if(WiFi.status() != WL_CONNECTED)
+  {
+    switchState(STATE_STARTUP);
+  }
+  locoConnect();
+  if(millis() > stateTimeout)
+  {
+    switchState(STATE_CONFIG_STATION_WAITING);
+  }
+}
 
-    case STATE_LOCO_WAITFORTIMEOUT:
-      if(WiFi.status() != WL_CONNECTED)
-      {
-        switchState(STATE_STARTUP);
-      }
-      if(timeoutReceived() || millis() > stateTimeout)
-      {
-        switchState(STATE_LOCO_ONLINE);      
-      }
-      break;
+void stateLocoConnecting(void)
+{
+  if(WiFi.status() != WL_CONNECTED)
+  {
+    switchState(STATE_STARTUP);
+  }
+  locoRegister();
+  if(millis() > stateTimeout)
+  {
+    switchState(STATE_CONFIG_STATION_WAITING);
+  }
+}
 
-    case STATE_LOCO_ONLINE:
-      if(WiFi.status() != WL_CONNECTED)
-      {
-        switchState(STATE_STARTUP);
-      }
-      locoHandler();
-      break;
-    
-    case STATE_CONFIG_STATION_WAITING:
-      showVoltageIfOff("200/200", "200/200", "200/200");
-      if(WiFi.status() != WL_CONNECTED)
-      {
-        switchState(STATE_STARTUP);
-      }
-      if(millis() > stateTimeout)
-      {
-        shutdownWiFiConfigSTA();
-        switchState(STATE_LOCO_ONLINE);
-      }
-      break;
+void stateLocoWaitForTimeout(void)
+{
+  if(WiFi.status() != WL_CONNECTED)
+  {
+    switchState(STATE_STARTUP);
+  }
+  if(timeoutReceived() || millis() > stateTimeout)
+  {
+    switchState(STATE_LOCO_ONLINE);
+  }
+}
 
-    case STATE_CONFIG_STATION:
-      showVoltageIfOff("200/200", "200/200", "200/200");
-      if(WiFi.status() != WL_CONNECTED)
-      {
-        initWiFiAP();
-        switchState(STATE_STARTUP);
-      }
-      break;
+void stateLocoOnline(void)
+{
+  if(WiFi.status() != WL_CONNECTED)
+  {
+    switchState(STATE_STARTUP);
+  }
+  locoHandler();
+}
 
-    case STATE_LOCOS_OFF:
-      showVoltage();
-      if(millis() > stateTimeout)
-      {
-        locoDisconnect();
-        switchState(STATE_LOWPOWER_WAITING, 100);
-      }
-      if(!allLocosInactive())
-      {
-        switchState(STATE_LOCO_ONLINE);
-      }
-      break;
+void stateConfigStationWaiting(void)
+{
+  if(WiFi.status() != WL_CONNECTED)
+  {
+    switchState(STATE_STARTUP);
+  }
+  if(millis() > stateTimeout)
+  {
+    shutdownWiFiConfigSTA();
+    switchState(STATE_LOCO_ONLINE);
+  }
+}
 
-    case STATE_LOWPOWER_WAITING:
-      setLEDvalues("0/0", "0/0", "1/250");
-      if(millis() > stateTimeout)
-      {
-        shutdownWiFiSTA();
-        switchState(STATE_LOWPOWER, 60000);
-      }
-      if(!allLocosInactive() && !lowBattery && !emptyBattery)
-      {
-        switchState(STATE_LOCO_ONLINE);
-      }
-      break;
-    
-    case STATE_LOWPOWER:
-      setLEDvalues("0/0", "0/0", "1/250");
-      // shut down ESP if low on battery or inactivity timeout plus delay reached
-      if(lowBattery || emptyBattery || millis() > stateTimeout)
-      {
-        delay(1000);
-        ESP.deepSleep(0);
-      }
-      // restart when user reenables a loco switch
-      else if(!allLocosInactive())
-      {
-        ESP.restart();
-      }
-      // else wait for RC delay to switch off power
-      break;
-      
-    case STATE_CONFIG_AP:
-    // no way to get out of here except for restart
-      showVoltageIfOff("0/0", "0/0", "200/200");
-      break;
+void stateConfigStation(void)
+{
+  if(WiFi.status() != WL_CONNECTED)
+  {
+    initWiFiAP();
+    switchState(STATE_STARTUP);
+  }
+}
 
-    case STATE_WAIT_ON_RED_KEY:
-      setLEDvalues("0/0", "25/50", "25/50");
-      if(!getInputState(KEY_ESTOP))
-      {
-        showVoltageIfOff("0/0", "0/0", "100/200");
-        initWiFiSTA();
-        switchState(STATE_CONNECTING, TOTAL_NETWORK_TIMEOUT_MS);
-      }
-      else if(millis() > stateTimeout)
-      {
-        // delete all configuration info
-        deleteAllConfig();
-        // wait for key release, then restart
-        while(getInputState(KEY_ESTOP))
-        {
-          setLEDvalues("0/0", "0/0", "0/0");
-        }
-        ESP.restart();
-      }
-      break;
+void stateLocosOff(void)
+{
+  if(millis() > stateTimeout)
+  {
+    locoDisconnect();
+    switchState(STATE_LOWPOWER_WAITING);
+  }
+  if(!allLocosInactive())
+  {
+    switchState(STATE_LOCO_ONLINE);
+  }
+}
 
-    case STATE_WAIT_ON_YELLOW_KEY:
-      setLEDvalues("25/50", "0/0", "25/50");
-      if(!getInputState(KEY_SHIFT))
-      {
-        showVoltageIfOff("0/0", "0/0", "100/200");
-        initWiFiSTA();
-        switchState(STATE_CONNECTING, TOTAL_NETWORK_TIMEOUT_MS);
-      }
-      else if(millis() > stateTimeout)
-      {
-        initWiFiAP();
-        switchState(STATE_CONFIG_AP);
-      }
-      break;
+void stateLowpowerWaiting(void)
+{
+  if(millis() > stateTimeout)
+  {
+    shutdownWiFiSTA();
+    switchState(STATE_LOWPOWER);
+  }
+  if(!allLocosInactive() && !lowBattery && !emptyBattery)
+  {
+    switchState(STATE_LOCO_ONLINE);
+  }
+}
 
-    case STATE_WAIT_ON_F0_KEY:
-      setLEDvalues("25/50", "25/50", "0/0");
-      if(!getInputState(KEY_F0))
-      {
-        switchState(STATE_CONNECTED, TOTAL_NETWORK_TIMEOUT_MS);
-      }
-      else if(millis() > stateTimeout)
-      {
-        initWiFiConfigSTA();
-        switchState(STATE_CONFIG_STATION);
-      }
-      break;
+void stateLowpower(void)
+{
+  // shut down ESP if low on battery or inactivity timeout plus delay reached
+  if(lowBattery || emptyBattery || millis() > stateTimeout)
+  {
+    delay(1000);
+    ESP.deepSleep(0);
   }
+  // restart when user reenables a loco switch
+  else if(!allLocosInactive())
+  {
+    ESP.restart();
+  }
+  // else wait for RC delay to switch off power
 }
 
-void switchState(state newState, uint32_t timeout)
+void stateConfigAP(void)
 {
-  log_d("Old state: %d, New state: %d", wiFredState, newState);
-  wiFredState = newState;
-  if(timeout == UINT32_MAX)
+  // no way to get out of here except for restart
+}
+
+void stateWaitOnRedKey(void)
+{
+  if(!getInputState(KEY_ESTOP))
   {
-    stateTimeout = timeout;
+    switchState(STATE_CONNECTING);
   }
-  else
+  else if(millis() > stateTimeout)
+  {
+    // delete all configuration info
+    deleteAllConfig();
+    // wait for key release, then restart
+    while(getInputState(KEY_ESTOP))
+    {
+      setLEDvalues("0/0", "0/0", "0/0");
+      processInputEvents();
+    }
+    ESP.restart();
+  }
+}
+
+void stateWaitOnYellowKey(void)
+{
+  if(!getInputState(KEY_SHIFT))
+  {
+    switchState(STATE_CONNECTING);
+  }
+  else if(millis() > stateTimeout)
+  {
+    switchState(STATE_CONFIG_AP);
+  }
+}
+
+void stateWaitOnF0Key(void)
+{
+  if(!getInputState(KEY_F0))
+  {
+    switchState(STATE_CONNECTED);
+  }
+  else if(millis() > stateTimeout)
   {
-    stateTimeout = millis() + timeout;
+    initWiFiConfigSTA();
+    switchState(STATE_CONFIG_STATION);
   }
 }
+
+/**
+ * Description of all states: name, handler, entry action, default timeout and LED pattern
+ *
+ * Must be in the same order as enum state
+ */
+const stateInfo stateTable[NUM_STATES] =
+{
+  { "STARTUP", stateStartup, nullptr, NO_TIMEOUT, LEDS_VOLTAGE_IF_OFF, "0/0", "0/0", "100/200" },
+  { "CONNECTING", stateConnecting, initWiFiSTA, TOTAL_NETWORK_TIMEOUT_MS, LEDS_VOLTAGE_IF_OFF, "0/0", "0/0", "100/200" },
+  { "CONNECTED", stateConnected, locoConnectReset, TOTAL_NETWORK_TIMEOUT_MS, LEDS_VOLTAGE_IF_OFF, "0/0", "0/0", "25/50" },
+  { "LOCO_CONNECTING", stateLocoConnecting, nullptr, 10 * 1000, LEDS_UNCHANGED, nullptr, nullptr, nullptr },
+  { "LOCO_WAITFORTIMEOUT", stateLocoWaitForTimeout, nullptr, 1000, LEDS_UNCHANGED, nullptr, nullptr, nullptr },
+  { "LOCO_ONLINE", stateLocoOnline, nullptr, NO_TIMEOUT, LEDS_UNCHANGED, nullptr, nullptr, nullptr },
+  { "LOCOS_OFF", stateLocosOff, nullptr, 6000, LEDS_VOLTAGE, nullptr, nullptr, nullptr },
+  { "CONFIG_AP", stateConfigAP, initWiFiAP, NO_TIMEOUT, LEDS_VOLTAGE_IF_OFF, "0/0", "0/0", "200/200" },
+  { "CONFIG_STATION_WAITING", stateConfigStationWaiting, initWiFiConfigSTA, 120 * 1000, LEDS_VOLTAGE_IF_OFF, "200/200", "200/200", "200/200" },
+  { "CONFIG_STATION", stateConfigStation, nullptr, NO_TIMEOUT, LEDS_VOLTAGE_IF_OFF, "200/200", "200/200", "200/200" },
+  { "LOWPOWER_WAITING", stateLowpowerWaiting, nullptr, 100, LEDS_FIXED, "0/0", "0/0", "1/250" },
+  { "LOWPOWER", stateLowpower, nullptr, 60000, LEDS_FIXED, "0/0", "0/0", "1/250" },
+  { "WAIT_ON_RED_KEY", stateWaitOnRedKey, nullptr, WAIT_ON_KEY_TIMEOUT, LEDS_FIXED, "0/0", "25/50", "25/50" },
+  { "WAIT_ON_YELLOW_KEY", stateWaitOnYellowKey, nullptr, WAIT_ON_KEY_TIMEOUT, LEDS_FIXED, "25/50", "0/0", "25/50" },
+  { "WAIT_ON_F0_KEY", stateWaitOnF0Key, nullptr, WAIT_ON_KEY_TIMEOUT, LEDS_FIXED, "25/50", "25/50", "0/0" },
+};
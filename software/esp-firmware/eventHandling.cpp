@@ -0,0 +1,187 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file lets the main loop sleep until there is something to do
+ * instead of spinning continuously.
+ */
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "eventHandling.h"
+#include "stateMachine.h"
+
+/**
+ * Task running setup() and loop(), woken up by postEvent()
+ */
+TaskHandle_t loopTask = nullptr;
+
+/**
+ * Number of main loop passes during the last full second
+ */
+uint32_t loopsPerSecond = 0;
+
+/**
+ * Histogram of the time each main loop pass took (not counting the sleep)
+ */
+uint32_t loopLatency[LOOP_LATENCY_BUCKETS];
+
+/**
+ * Longest main loop pass since boot in ms
+ */
+uint32_t loopLatencyMax = 0;
+
+/**
+ * millis() value when the current main loop pass has started
+ */
+uint32_t loopPassStart = 0;
+
+/**
+ * Work handed over to the main loop by runInMainLoop(), the mutex lets only
+ * one task at a time hand over work, workDone is given when it has been run
+ */
+std::atomic<std::function<void(void)> *> pendingWork(nullptr);
+SemaphoreHandle_t workMutex = nullptr;
+SemaphoreHandle_t workDone = nullptr;
+
+/**
+ * Remember the main loop task, call from setup() before any event can be posted
+ */
+void initEvents(void)
+{
+  loopTask = xTaskGetCurrentTaskHandle();
+  workMutex = xSemaphoreCreateMutex();
+  workDone = xSemaphoreCreateBinary();
+}
+
+/**
+ * Wake up the main loop, i.e. after a key or speed change
+ *
+ * Safe to call from Ticker callbacks
+ */
+void postEvent(void)
+{
+  if(loopTask != nullptr)
+  {
+    xTaskNotifyGive(loopTask);
+  }
+}
+
+/**
+ * Wake up the main loop from interrupt context, i.e. when the A/D converter
+ * has finished a block
+ */
+void ARDUINO_ISR_ATTR postEventFromISR(void)
+{
+  if(loopTask != nullptr)
+  {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(loopTask, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+  }
+}
+
+/**
+ * Run work in the main loop and wait until it is done
+ *
+ * Call from other tasks (i.e. the web server) for anything changing state
+ * the main loop works with, runs work directly if called from the main loop
+ */
+void runInMainLoop(std::function<void(void)> work)
+{
+  if(xTaskGetCurrentTaskHandle() == loopTask)
+  {
+    work();
+    return;
+  }
+
+  xSemaphoreTake(workMutex, portMAX_DELAY);
+  pendingWork = &work;
+  postEvent();
+  xSemaphoreTake(workDone, portMAX_DELAY);
+  xSemaphoreGive(workMutex);
+}
+
+/**
+ * Run the work handed over by runInMainLoop(), if any
+ *
+ * Call once per main loop pass
+ */
+void handleDeferredWork(void)
+{
+  std::function<void(void)> * work = pendingWork.exchange(nullptr);
+  if(work != nullptr)
+  {
+    (*work)();
+    xSemaphoreGive(workDone);
+  }
+}
+
+/**
+ * Sleep until an event has been posted or the timeout has passed
+ *
+ * @param deadline millis() value at which to wake up at the latest,
+ *                 will be capped at LOOP_MAX_WAIT_MS from now
+ */
+void waitForEvent(uint32_t deadline)
+{
+  static uint32_t loopCounter = 0;
+  static uint32_t nextSecond = 0;
+
+  uint32_t now = millis();
+
+  // the first pass would include setup()
+  if(loopPassStart != 0)
+  {
+    uint32_t passTime = now - loopPassStart;
+    uint8_t bucket = 0;
+    while(bucket < LOOP_LATENCY_BUCKETS - 1 && passTime >= LOOP_LATENCY_LIMITS[bucket])
+    {
+      bucket++;
+    }
+    loopLatency[bucket]++;
+    if(passTime > loopLatencyMax)
+    {
+      loopLatencyMax = passTime;
+      log_d("Longest loop pass so far: %u ms in state %s", passTime, getStateName(wiFredState));
+    }
+  }
+
+  loopCounter++;
+  if((int32_t) (now - nextSecond) >= 0)
+  {
+    loopsPerSecond = loopCounter;
+    loopCounter = 0;
+    nextSecond = now + 1000;
+  }
+
+  // same (non-wrapping) comparison as used for stateTimeout
+  uint32_t wait = LOOP_MAX_WAIT_MS;
+  if(deadline <= now)
+  {
+    wait = 0;
+  }
+  else if(deadline - now < wait)
+  {
+    wait = deadline - now;
+  }
+  if(wait > 0)
+  {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+  }
+  loopPassStart = millis();
+}
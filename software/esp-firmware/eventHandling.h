@@ -0,0 +1,95 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file lets the main loop sleep until there is something to do
+ * instead of spinning continuously.
+ */
+
+#ifndef _EVENT_HANDLING_H_
+#define _EVENT_HANDLING_H_
+
+#include <stdint.h>
+#include <functional>
+
+/**
+ * Longest time the main loop sleeps without an event
+ * (network sockets and WiFi scans are polled at least this often)
+ */
+#define LOOP_MAX_WAIT_MS 10
+
+/**
+ * Number of main loop passes during the last full second
+ */
+extern uint32_t loopsPerSecond;
+
+/**
+ * Histogram of the time each main loop pass took (not counting the sleep),
+ * bucket n counts passes shorter than LOOP_LATENCY_LIMITS[n] ms, the last
+ * bucket counts all longer passes
+ */
+#define LOOP_LATENCY_BUCKETS 10
+const uint16_t LOOP_LATENCY_LIMITS[LOOP_LATENCY_BUCKETS - 1] = { 1, 2, 5, 10, 20, 50, 100, 500, 1000 };
+
+extern uint32_t loopLatency[LOOP_LATENCY_BUCKETS];
+
+/**
+ * Longest main loop pass since boot in ms
+ */
+extern uint32_t loopLatencyMax;
+
+/**
+ * Remember the main loop task, call from setup() before any event can be posted
+ */
+void initEvents(void);
+
+/**
+ * Wake up the main loop, i.e. after a key or speed change
+ *
+ * Safe to call from Ticker callbacks
+ */
+void postEvent(void);
+
+/**
+ * Wake up the main loop from interrupt context, i.e. when the A/D converter
+ * has finished a block
+ */
+void postEventFromISR(void);
+
+/**
+ * Run work in the main loop and wait until it is done
+ *
+ * Call from other tasks (i.e. the web server) for anything changing state
+ * the main loop works with, runs work directly if called from the main loop
+ */
+void runInMainLoop(std::function<void(void)> work);
+
+/**
+ * Run the work handed over by runInMainLoop(), if any
+ *
+ * Call once per main loop pass
+ */
+void handleDeferredWork(void);
+
+/**
+ * Sleep until an event has been posted or the timeout has passed
+ *
+ * @param deadline millis() value at which to wake up at the latest,
+ *                 will be capped at LOOP_MAX_WAIT_MS from now
+ */
+void waitForEvent(uint32_t deadline);
+
+#endif
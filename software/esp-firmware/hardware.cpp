@@ -0,0 +1,159 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the only place accessing GPIO pins and A/D converter inputs
+ * directly. All other code uses the functions below, so the keys, LEDs and
+ * analog inputs can be replaced by other implementations (i.e. a simulation).
+ */
+
+#include <Arduino.h>
+
+#include "hardware.h"
+
+/**
+ * Set from interrupt context when the A/D converter has finished a block
+ */
+volatile bool analogBlockReady = false;
+
+/**
+ * Called when a block is ready, i.e. to wake up the main loop
+ */
+void (*analogBlockCallback)(void) = nullptr;
+
+/**
+ * Set up all key inputs, LED outputs and analog inputs
+ */
+void initHardware(void)
+{
+  // Set all LED ports as outputs
+  pinMode(LED_STOP, OUTPUT);
+  pinMode(LED_FWD, OUTPUT);
+  pinMode(LED_REV, OUTPUT);
+  pinMode(FLASHLIGHT, OUTPUT);
+
+  // Set all key inputs to pullup, all loco selection switch inputs to floating
+  for(int k = KEY_F0; k <= KEY_REV; k++)
+  {
+    pinMode(KEY_PIN[k], INPUT_PULLUP);
+  }
+  for(int k = KEY_LOCO1; k <= KEY_LOCO4; k++)
+  {
+    pinMode(KEY_PIN[k], INPUT);
+  }
+}
+
+/**
+ * Read the raw state of a key or switch input (not debounced)
+ *
+ * @param key the key to query
+ * @returns true if the key is pressed (pin value is low)
+ */
+bool readKey(keys key)
+{
+  return digitalRead(KEY_PIN[key]) == LOW;
+}
+
+/**
+ * Switch one of the LEDs (LEDs are active low)
+ */
+void setLED(uint8_t ledPin, bool on)
+{
+  digitalWrite(ledPin, on ? LOW : HIGH);
+}
+
+/**
+ * Switch the flashlight
+ */
+void setFlashlight(bool on)
+{
+  digitalWrite(FLASHLIGHT, on ? HIGH : LOW);
+}
+
+/**
+ * A/D converter interrupt: a new block of conversions is ready
+ */
+void ARDUINO_ISR_ATTR analogComplete(void)
+{
+  analogBlockReady = true;
+  if(analogBlockCallback != nullptr)
+  {
+    analogBlockCallback();
+  }
+}
+
+/**
+ * Start sampling the speed potentiometer and the battery voltage input in
+ * the background
+ *
+ * @param onBlockReady called from interrupt context whenever a new block is ready
+ */
+void startAnalogSampling(void (*onBlockReady)(void))
+{
+  const uint8_t pins[] = { ANALOG_PIN_POTI, ANALOG_PIN_VBATT };
+
+  analogBlockCallback = onBlockReady;
+
+  // Set ADC attenuation for the two pins used
+  analogContinuousSetAtten(ADC_11db);
+  if(!analogContinuous(pins, sizeof(pins), ADC_CONVERSIONS_PER_PIN, ADC_SAMPLE_FREQ_HZ, &analogComplete))
+  {
+    log_e("Could not set up continuous A/D conversion");
+    return;
+  }
+  analogContinuousStart();
+}
+
+/**
+ * Get the latest block of A/D converter results, if there is a new one
+ *
+ * @param potiRaw averaged raw A/D converter value of the speed potentiometer
+ * @param battMilliVolts averaged voltage at the battery A/D converter input in milliVolt
+ *                       (before the voltage divider is taken into account)
+ * @returns true if a new block has been read
+ */
+bool readAnalogBlock(uint16_t &potiRaw, uint16_t &battMilliVolts)
+{
+  adc_continuous_data_t *result = nullptr;
+
+  if(!analogBlockReady)
+  {
+    return false;
+  }
+  analogBlockReady = false;
+
+  if(!analogContinuousRead(&result, 0))
+  {
+    return false;
+  }
+
+  bool havePoti = false;
+  bool haveBatt = false;
+  for(int i = 0; i < 2; i++)
+  {
+    if(result[i].pin == ANALOG_PIN_POTI)
+    {
+      potiRaw = result[i].avg_read_raw;
+      havePoti = true;
+    }
+    else if(result[i].pin == ANALOG_PIN_VBATT)
+    {
+      battMilliVolts = result[i].avg_read_mvolts;
+      haveBatt = true;
+    }
+  }
+  return havePoti && haveBatt;
+}
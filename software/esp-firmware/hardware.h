@@ -0,0 +1,97 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the only place accessing GPIO pins and A/D converter inputs
+ * directly. All other code uses the functions below, so the keys, LEDs and
+ * analog inputs can be replaced by other implementations (i.e. a simulation).
+ */
+
+#ifndef _HARDWARE_H_
+#define _HARDWARE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LED_STOP 14
+#define LED_FWD 39
+#define LED_REV 15
+#define FLASHLIGHT 33
+
+enum keys { KEY_F0, KEY_F1, KEY_F2, KEY_F3, KEY_F4, KEY_F5, KEY_F6, KEY_F7, KEY_F8,
+            KEY_ESTOP, KEY_SHIFT, KEY_FWD, KEY_REV,
+            KEY_LOCO1, KEY_LOCO2, KEY_LOCO3, KEY_LOCO4 };
+
+const int KEY_PIN[] = { 3, 11, 4, 37, 12, 5, 38, 13, 6,
+            10, 40, 16, 36,
+            34, 35, 2, 1 };
+
+#define ANALOG_PIN_VBATT 8
+#define ANALOG_PIN_POTI 9
+
+/**
+ * Set up all key inputs, LED outputs and analog inputs
+ */
+void initHardware(void);
+
+/**
+ * Read the raw state of a key or switch input (not debounced)
+ *
+ * @param key the key to query
+ * @returns true if the key is pressed (pin value is low)
+ */
+bool readKey(keys key);
+
+/**
+ * Switch one of the LEDs
+ *
+ * @param ledPin LED_STOP, LED_FWD or LED_REV
+ * @param on true to turn the LED on
+ */
+void setLED(uint8_t ledPin, bool on);
+
+/**
+ * Switch the flashlight
+ */
+void setFlashlight(bool on);
+
+/**
+ * Continuous A/D conversion: conversions per second (both pins together) and
+ * number of conversions per pin averaged into one block, giving a new block
+ * every 2 * ADC_CONVERSIONS_PER_PIN * 1000 / ADC_SAMPLE_FREQ_HZ ms
+ */
+#define ADC_SAMPLE_FREQ_HZ 1000
+#define ADC_CONVERSIONS_PER_PIN 32
+
+/**
+ * Start sampling the speed potentiometer and the battery voltage input in
+ * the background
+ *
+ * @param onBlockReady called from interrupt context whenever a new block is ready
+ */
+void startAnalogSampling(void (*onBlockReady)(void));
+
+/**
+ * Get the latest block of A/D converter results, if there is a new one
+ *
+ * @param potiRaw averaged raw A/D converter value of the speed potentiometer
+ * @param battMilliVolts averaged voltage at the battery A/D converter input in milliVolt
+ *                       (before the voltage divider is taken into account)
+ * @returns true if a new block has been read
+ */
+bool readAnalogBlock(uint16_t &potiRaw, uint16_t &battMilliVolts);
+
+#endif
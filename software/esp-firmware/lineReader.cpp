@@ -0,0 +1,147 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides an incremental, non-blocking splitter for the line
+ * based wiThrottle protocol. It collects whatever bytes are available and
+ * hands out complete lines without copying them.
+ */
+
+#include "lineReader.h"
+
+lineReader::lineReader(void)
+{
+  droppedLines = 0;
+  clear();
+}
+
+/**
+ * Throw away all buffered data, including partial lines
+ */
+void lineReader::clear(void)
+{
+  start = end = scanned = 0;
+  skipToLineEnd = false;
+}
+
+/**
+ * Move unprocessed data to the start of the buffer
+ */
+void lineReader::compact(void)
+{
+  if(start == 0)
+  {
+    return;
+  }
+  memmove(buffer, buffer + start, end - start);
+  end -= start;
+  scanned -= start;
+  start = 0;
+}
+
+/**
+ * Add received bytes
+ *
+ * @returns number of bytes taken, less than length if the buffer is full
+ */
+size_t lineReader::feed(const char * data, size_t length)
+{
+  compact();
+  // keep one byte for zero-terminating the last line
+  size_t space = LINE_BUFFER_SIZE - 1 - end;
+  if(length > space)
+  {
+    length = space;
+  }
+  memcpy(buffer + end, data, length);
+  end += length;
+  return length;
+}
+
+/**
+ * Read all bytes currently available from the client without blocking
+ */
+void lineReader::poll(Client & input)
+{
+  while(input.available() > 0)
+  {
+    compact();
+    // keep one byte for zero-terminating the last line
+    size_t space = LINE_BUFFER_SIZE - 1 - end;
+    if(space == 0)
+    {
+      if(memchr(buffer, '\n', end) != nullptr)
+      {
+        // complete lines need to be processed first
+        return;
+      }
+      // line too long, drop everything up to the next line end
+      if(!skipToLineEnd)
+      {
+        droppedLines++;
+      }
+      clear();
+      skipToLineEnd = true;
+      space = LINE_BUFFER_SIZE - 1;
+    }
+    int n = input.read((uint8_t *) buffer + end, space);
+    if(n <= 0)
+    {
+      break;
+    }
+    end += n;
+  }
+}
+
+/**
+ * Get the next complete line
+ *
+ * @returns false if there is no complete line left
+ */
+bool lineReader::nextLine(lineView & line)
+{
+  while(true)
+  {
+    char * lineEnd = (char *) memchr(buffer + scanned, '\n', end - scanned);
+    if(lineEnd == nullptr)
+    {
+      scanned = end;
+      if(skipToLineEnd)
+      {
+        start = scanned = end;
+      }
+      return false;
+    }
+
+    size_t lineStart = start;
+    start = scanned = lineEnd - buffer + 1;
+
+    if(skipToLineEnd)
+    {
+      skipToLineEnd = false;
+      continue;
+    }
+
+    *lineEnd = '\0';
+    if(lineEnd > buffer + lineStart && *(lineEnd - 1) == '\r')
+    {
+      *--lineEnd = '\0';
+    }
+    line.text = buffer + lineStart;
+    line.length = lineEnd - (buffer + lineStart);
+    return true;
+  }
+}
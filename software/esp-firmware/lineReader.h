@@ -0,0 +1,112 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides an incremental, non-blocking splitter for the line
+ * based wiThrottle protocol. It collects whatever bytes are available and
+ * hands out complete lines without copying them.
+ */
+
+#ifndef _LINE_READER_H_
+#define _LINE_READER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <Client.h>
+
+/**
+ * Longest line that can be received - longer lines will be dropped
+ * (roster and turnout lists from large layouts can get long)
+ */
+#define LINE_BUFFER_SIZE 1024
+
+/**
+ * A complete line in the receive buffer, without line end and zero-terminated
+ *
+ * Only valid until the next call to poll(), feed(), nextLine() or clear()
+ */
+typedef struct
+{
+  const char * text;
+  size_t length;
+} lineView;
+
+/**
+ * Check if a received line starts with the given text
+ */
+inline bool startsWith(const lineView & line, const char * prefix)
+{
+  return strncmp(line.text, prefix, strlen(prefix)) == 0;
+}
+
+/**
+ * Get a character of a received line, zero if index is beyond the end of the line
+ */
+inline char charAt(const lineView & line, size_t index)
+{
+  return index < line.length ? line.text[index] : '\0';
+}
+
+class lineReader
+{
+  public:
+    lineReader(void);
+
+    /**
+     * Read all bytes currently available from the client without blocking
+     */
+    void poll(Client & input);
+
+    /**
+     * Add received bytes
+     *
+     * @returns number of bytes taken, less than length if the buffer is full
+     */
+    size_t feed(const char * data, size_t length);
+
+    /**
+     * Get the next complete line
+     *
+     * @returns false if there is no complete line left
+     */
+    bool nextLine(lineView & line);
+
+    /**
+     * Throw away all buffered data, including partial lines
+     */
+    void clear(void);
+
+    /**
+     * Number of lines dropped because they did not fit into the buffer
+     */
+    uint32_t droppedLines;
+
+  private:
+    /**
+     * Move unprocessed data to the start of the buffer
+     */
+    void compact(void);
+
+    char buffer[LINE_BUFFER_SIZE];
+    size_t start;
+    size_t end;
+    size_t scanned;
+    bool skipToLineEnd;
+};
+
+#endif
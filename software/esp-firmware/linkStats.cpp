@@ -0,0 +1,136 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file collects round trip times of the wiThrottle session and other
+ * link quality figures to correlate lag with network conditions.
+ */
+
+#include <WiFi.h>
+#include <lwip/stats.h>
+#include <stdlib.h>
+
+#include "linkStats.h"
+
+/**
+ * Ring buffer of the last RTT_SAMPLES round trip times in ms
+ */
+uint16_t rttSamples[RTT_SAMPLES];
+
+uint32_t rttSampleCount = 0;
+
+int8_t linkRSSI = 0;
+
+/**
+ * millis() value when the running probe has been sent, 0 if none is running,
+ * and the loco it has asked about
+ */
+uint32_t rttProbeSent = 0;
+uint8_t rttProbeLoco = 0;
+
+/**
+ * Add a round trip time sample
+ */
+void addRTTSample(uint32_t rtt)
+{
+  rttSamples[rttSampleCount % RTT_SAMPLES] = rtt > UINT16_MAX ? UINT16_MAX : rtt;
+  rttSampleCount++;
+  linkRSSI = WiFi.RSSI();
+}
+
+/**
+ * Start a round trip measurement when sending a speed query for a loco
+ *
+ * Ignored if a probe is already waiting for its answer
+ */
+void startRTTProbe(uint8_t loco)
+{
+  uint32_t now = millis();
+  if(rttProbeSent == 0 || now - rttProbeSent > RTT_PROBE_TIMEOUT)
+  {
+    // avoid 0 as it marks "no probe running"
+    rttProbeSent = now | 1;
+    rttProbeLoco = loco;
+  }
+}
+
+/**
+ * Finish the running round trip measurement when the speed of a loco is reported,
+ * ignored if the probe has not asked about this loco
+ */
+void finishRTTProbe(uint8_t loco)
+{
+  if(rttProbeSent != 0 && loco == rttProbeLoco)
+  {
+    addRTTSample(millis() - rttProbeSent);
+    rttProbeSent = 0;
+  }
+}
+
+/**
+ * Drop the running round trip measurement, i.e. when sending a speed command
+ * whose echo could not be told apart from the answer to the probe
+ */
+void cancelRTTProbe(void)
+{
+  rttProbeSent = 0;
+}
+
+static int compareSamples(const void * a, const void * b)
+{
+  return *(const uint16_t *) a - *(const uint16_t *) b;
+}
+
+/**
+ * @returns min/avg/p99/max of the last RTT_SAMPLES round trip times
+ */
+rttSummary getRTTSummary(void)
+{
+  rttSummary summary = { 0, 0, 0, 0, 0 };
+  uint16_t sorted[RTT_SAMPLES];
+
+  summary.count = rttSampleCount < RTT_SAMPLES ? rttSampleCount : RTT_SAMPLES;
+  if(summary.count == 0)
+  {
+    return summary;
+  }
+
+  memcpy(sorted, rttSamples, summary.count * sizeof(sorted[0]));
+  qsort(sorted, summary.count, sizeof(sorted[0]), compareSamples);
+
+  uint32_t sum = 0;
+  for(uint16_t i = 0; i < summary.count; i++)
+  {
+    sum += sorted[i];
+  }
+  summary.min = sorted[0];
+  summary.avg = sum / summary.count;
+  summary.p99 = sorted[(summary.count * 99) / 100];
+  summary.max = sorted[summary.count - 1];
+  return summary;
+}
+
+/**
+ * @returns number of TCP retransmissions since boot, -1 if not available (LWIP_STATS disabled)
+ */
+int32_t getTCPRetransmits(void)
+{
+#if LWIP_STATS && TCP_STATS
+  return lwip_stats.tcp.rexmit;
+#else
+  return -1;
+#endif
+}
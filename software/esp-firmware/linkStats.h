@@ -0,0 +1,94 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file collects round trip times of the wiThrottle session and other
+ * link quality figures to correlate lag with network conditions.
+ */
+
+#ifndef _LINK_STATS_H_
+#define _LINK_STATS_H_
+
+#include <stdint.h>
+
+/**
+ * Number of round trip samples the statistics are calculated from
+ */
+#define RTT_SAMPLES 64
+
+/**
+ * Give up waiting for the answer to a probe after this time in ms
+ */
+#define RTT_PROBE_TIMEOUT 5000
+
+/**
+ * Send a round trip probe with every n-th heartbeat only
+ */
+#define RTT_PROBE_HEARTBEATS 4
+
+/**
+ * Summary of the last RTT_SAMPLES round trip times in ms
+ */
+typedef struct
+{
+  uint16_t count;
+  uint16_t min;
+  uint16_t avg;
+  uint16_t p99;
+  uint16_t max;
+} rttSummary;
+
+/**
+ * Total number of round trip samples, RSSI at the last sample in dBm
+ */
+extern uint32_t rttSampleCount;
+extern int8_t linkRSSI;
+
+/**
+ * Add a round trip time sample
+ */
+void addRTTSample(uint32_t rtt);
+
+/**
+ * Start a round trip measurement when sending a speed query for a loco
+ *
+ * Ignored if a probe is already waiting for its answer
+ */
+void startRTTProbe(uint8_t loco);
+
+/**
+ * Finish the running round trip measurement when the speed of a loco is reported,
+ * ignored if the probe has not asked about this loco
+ */
+void finishRTTProbe(uint8_t loco);
+
+/**
+ * Drop the running round trip measurement, i.e. when sending a speed command
+ * whose echo could not be told apart from the answer to the probe
+ */
+void cancelRTTProbe(void);
+
+/**
+ * @returns min/avg/p99/max of the last RTT_SAMPLES round trip times
+ */
+rttSummary getRTTSummary(void);
+
+/**
+ * @returns number of TCP retransmissions since boot, -1 if not available (LWIP_STATS disabled)
+ */
+int32_t getTCPRetransmits(void);
+
+#endif
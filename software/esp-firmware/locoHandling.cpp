@@ -26,13 +26,18 @@
 #include <ESPmDNS.h>
 //sloeber>> #include <esp32-hal-log.h>    // log_d()
 
-#include <string.h> // strcmp()
+#include <string.h> // strcmp(), strncmp(), strncpy()
+#include <stdlib.h> // atoi()
 
 #include "locoHandling.h"
 #include "lowbat.h"
 #include "config.h"
 #include "stateMachine.h"
 #include "throttleHandling.h"
+#include "serverDiscovery.h"
+#include "asyncConnect.h"
+#include "linkStats.h"
+#include "speedFilter.h"
 
 // see jmri.jmrit.withrottle.ThrottleController#decodeSpeedStepMode()
 // and jmri.SpeedStepMode.
@@ -60,9 +65,14 @@ const ModeEntry_t MODES[MODES_LENGTH]
 locoInfo locos[4];
 
 /** 
- * String keeping the Loco Address plus its prefix (L or S) 
+ * Loco Address plus its prefix (L or S) 
  */
-String locoThrottleID[4];
+char locoThrottleID[4][THROTTLE_ID_LENGTH];
+
+/**
+ * Precomputed "MTA<locoThrottleID><;>" prefix for commands to a single loco
+ */
+char locoPrefix[4][LOCO_PREFIX_LENGTH];
 
 /**
  * Remember ESTOP setting
@@ -74,6 +84,11 @@ bool eSTOP = true;
  */
 uint32_t lastHeartBeat = 0;
 
+/**
+ * Number of heartbeats sent, every RTT_PROBE_HEARTBEATS-th carries a round trip probe
+ */
+uint32_t heartbeatCount = 0;
+
 /**
  * Timeout for keep alive
  */
@@ -84,6 +99,59 @@ uint32_t keepAliveTimeout = 5000;
  */
 uint32_t lastSpeedUpdate = 0;
 
+uint16_t speedHoldoffMin = SPEED_HOLDOFF_MIN_DEFAULT;
+uint16_t speedHoldoffMax = SPEED_HOLDOFF_MAX_DEFAULT;
+
+/**
+ * Smoothed speed command round trip time in ms, starts at the former fixed holdoff of 150 ms
+ */
+uint32_t speedRoundTrip = 75;
+
+/**
+ * Speed value waiting for its echo from the server (-1 if none) and time it has been sent
+ */
+int16_t speedEcho = -1;
+uint32_t speedEchoSent = 0;
+
+/**
+ * @returns time to wait between two speed commands in ms
+ */
+uint32_t getSpeedHoldoff(void)
+{
+  return constrain(2 * speedRoundTrip, (uint32_t) speedHoldoffMin, (uint32_t) speedHoldoffMax);
+}
+
+/**
+ * @returns number of speed steps of the coarsest acquired loco as reported by the server
+ *          or configured, 126 if not known
+ */
+uint8_t getSpeedSteps(void)
+{
+  uint8_t steps = 126;
+
+  for(uint8_t l = 0; l < 4; l++)
+  {
+    if(!isAcquired(l) || locoState[l] == LOCO_DEACTIVATE)
+    {
+      continue;
+    }
+    uint8_t locoSteps = speedStepModeSteps(locoStatus[l].speedStepMode);
+    if(locoSteps == 0)
+    {
+      // not reported (yet), use the configured mode
+      locoSteps = configuredModeSteps(locos[l].mode);
+    }
+    if(locoSteps != 0 && locoSteps < steps)
+    {
+      steps = locoSteps;
+    }
+  }
+  return steps;
+}
+
+uint32_t speedCommandsSent = 0;
+uint32_t speedCommandsSuppressed = 0;
+
 /**
  * Auto Sleep activity timer
  */
@@ -95,6 +163,97 @@ uint32_t lastActivity = 0;
  */
 WiFiClient client;
 
+/**
+ * Splits data received from the wiThrottle server into lines
+ */
+lineReader rxLines;
+
+/**
+ * Loco state as reported by the wiThrottle server
+ */
+locoStatusInfo locoStatus[4];
+
+/**
+ * Number of entries in the server roster
+ */
+uint16_t rosterSize = 0;
+
+/**
+ * Last alert or info message from the server
+ */
+char serverMessage[SERVER_MESSAGE_LENGTH] = "";
+
+/**
+ * Outgoing data collected during one loop() pass, written to the server by locoFlush()
+ */
+char txBuffer[TX_BUFFER_SIZE];
+size_t txLength = 0;
+
+/**
+ * Statistics on outgoing wiThrottle traffic
+ */
+uint32_t txCommandCount = 0;
+uint32_t txWriteCount = 0;
+
+/**
+ * Queue data for the wiThrottle server, flushing the queue first if it does not fit
+ */
+void queueData(const char * data, size_t length)
+{
+  if(txLength + length > TX_BUFFER_SIZE)
+  {
+    locoFlush();
+  }
+  if(length > TX_BUFFER_SIZE)
+  {
+    client.write(data, length);
+    txWriteCount++;
+    return;
+  }
+  memcpy(txBuffer + txLength, data, length);
+  txLength += length;
+}
+
+/**
+ * Queue a complete command line for the wiThrottle server
+ */
+void sendCommand(wiThrottleCommand & command)
+{
+  command.end();
+  queueData(command.c_str(), command.length());
+  txCommandCount++;
+}
+
+/**
+ * Queue a constant command line (including newline) for the wiThrottle server
+ */
+void sendCommand(const char * line)
+{
+  size_t length = strlen(line);
+  queueData(line, length);
+  if(length > 0 && line[length - 1] == '\n')
+  {
+    txCommandCount++;
+  }
+}
+
+/**
+ * Write all queued commands to the wiThrottle server in a single write
+ */
+void locoFlush(void)
+{
+  if(txLength == 0)
+  {
+    return;
+  }
+  if(client.connected())
+  {
+    client.write(txBuffer, txLength);
+    txWriteCount++;
+  }
+  txLength = 0;
+}
+
 /**
  * Speed of all currently attached locos
  */
@@ -105,6 +264,11 @@ uint8_t speed = 0;
  */
 volatile uint8_t newSpeed = 0;
 
+/**
+ * Speed value last sent to the server (quantised to the speed steps of the coarsest loco)
+ */
+uint8_t sentSpeed = 0;
+
 /**
  * Current "reverse setting" sent out to all locos
  */
@@ -116,24 +280,34 @@ bool myReverse = false;
 serverInfo locoServer;
 
 /**
- * If server shall be found automatically, this will be the place to save its name
+ * Events from throttle
  */
-char * automaticServer;
+eLocoState locoState[4] = { LOCO_INACTIVE, LOCO_INACTIVE, LOCO_INACTIVE, LOCO_INACTIVE };
 
 /**
- * If server shall be found automatically, this will be the place to save its IP address
+ * locoState timeouts
  */
-IPAddress automaticServerIP;
+uint32_t locoTimeout[4] = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
 
 /**
- * Events from throttle
+ * Time when acquiring each loco was started, to measure time until it is drivable
  */
-eLocoState locoState[4] = { LOCO_INACTIVE, LOCO_INACTIVE, LOCO_INACTIVE, LOCO_INACTIVE };
+uint32_t acquireStart[4];
 
 /**
- * locoState timeouts
+ * Waiting for the first reply after acquiring a loco, to measure the round trip time
  */
-uint32_t locoTimeout[4] = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+bool acquireReplyPending[4];
+
+/**
+ * millis() value of the last pass with a working connection to the server,
+ * start of the outage when the connection is lost
+ */
+uint32_t lastOnline = 0;
+uint32_t outageStart = 0;
+
+uint32_t sessionResumes = 0;
+uint32_t lastOutageTime = 0;
 
 /**
  * Remember status of functions
@@ -163,24 +337,27 @@ void locoHandler(void)
     if(allInactive)
     {
       locoDisconnect();
-      switchState(STATE_LOWPOWER_WAITING, 100);
+      switchState(STATE_LOWPOWER_WAITING);
       return;
     }
   }
 
-  // handle lost connection to server
+  // handle lost connection to server, active locos will be resumed by locoConnectReset()
   if(!client.connected() && !emptyBattery)
   {
-    for(uint8_t loco = 0; loco < 4; loco++)
-    {
-      if(locoState[loco] == LOCO_ACTIVE)
-      {
-        locoState[loco] = LOCO_ACTIVATE;
-      }
-    }
-    switchState(STATE_CONNECTED, 60 * 1000);
+    client.stop();
+    switchState(STATE_CONNECTED);
     return;
   }
+  lastOnline = now;
+
+  // process everything the server sent since the last call
+  rxLines.poll(client);
+  lineView line;
+  while(rxLines.nextLine(line))
+  {
+    handleServerLine(line);
+  }
 
   // remove ESTOP setting if poti turned to zero
   if(eSTOP && newSpeed == 0 && !blockDirectionChange())
@@ -189,39 +366,76 @@ void locoHandler(void)
   }
 
   // send new speed, if changed, and past holdoff-period
-  if(!eSTOP && speed != newSpeed && now - lastSpeedUpdate >= SPEED_HOLDOFF_PERIOD)
+  // the first change after a pause goes out at once, the last one of a burst after at most one holdoff
+  // only send changes that move the coarsest loco to a different speed step
+  if(!eSTOP && speed != newSpeed && now - lastSpeedUpdate >= getSpeedHoldoff())
   {
+    uint8_t steps = getSpeedSteps();
+    uint8_t step = speedToStep(newSpeed, steps);
     speed = newSpeed;
-    client.print(String("MTA*<;>V") + speed + "\n");
-    lastSpeedUpdate = lastHeartBeat = lastActivity = now;
+    if(step == speedToStep(sentSpeed, steps))
+    {
+      speedCommandsSuppressed++;
+    }
+    else
+    {
+      sentSpeed = stepToSpeed(step, steps);
+      sendCommand(wiThrottleCommand("MTA*<;>V").add(sentSpeed));
+      cancelRTTProbe();
+      speedCommandsSent++;
+      lastSpeedUpdate = lastHeartBeat = lastActivity = now;
+      // measure the round trip of one command at a time
+      if(speedEcho < 0 || now - speedEchoSent > SPEED_ECHO_TIMEOUT)
+      {
+        speedEcho = sentSpeed;
+        speedEchoSent = now;
+      }
+    }
   }
 
   // sending heart-beat regurarly
   if(now - lastHeartBeat >= keepAliveTimeout)
   {
-    client.print("*\n");
+    sendCommand("*\n");
     lastHeartBeat = now;
+    // the server does not answer heartbeats, so measure the round trip with a speed query
+    // for one loco every few heartbeats - no speed command is in flight as these
+    // reset the heartbeat timer, the probe is dropped when one is sent before the answer
+    heartbeatCount++;
+    for(uint8_t loco = 0; loco < 4 && heartbeatCount % RTT_PROBE_HEARTBEATS == 0; loco++)
+    {
+      if(locoState[loco] == LOCO_ACTIVE && isAcquired(loco))
+      {
+        sendCommand(wiThrottleCommand(locoPrefix[loco]).add("qV"));
+        startRTTProbe(loco);
+        break;
+      }
+    }
   }
       
   // check if any of the loco selectors have been changed
+  // all locos are handled in parallel, replies are told apart by handleServerLine()
+  bool resumed = false;
   for(uint8_t currentLoco = 0; currentLoco < 4; currentLoco++)
   {
-    if(locoState[currentLoco] == LOCO_LEAVE_FUNCTIONS)
+    if(locoState[currentLoco] == LOCO_RESUME)
+    {
+      resumeLoco(currentLoco);
+      resumed = true;
+    }
+    else if(locoState[currentLoco] == LOCO_LEAVE_FUNCTIONS)
     {
       setLocoFunctions(currentLoco);
-      break;
     }
     else if(locoState[currentLoco] == LOCO_FUNCTIONS)
     {
       getLocoFunctions(currentLoco);
-      break;
     }
     else if(locoState[currentLoco] == LOCO_ACTIVATE && locos[currentLoco].address != -1)
     {
       // make sure no loco (currently attached) is moving
       setESTOP();
       requestLoco(currentLoco);
-      break;
     }
     else if(locoState[currentLoco] == LOCO_DEACTIVATE)
     {
@@ -243,7 +457,7 @@ void locoHandler(void)
             case THROTTLE_MOMENTARY:
             case THROTTLE_LOCKING:
             case THROTTLE:
-              client.print(String("MTA") + locoThrottleID[currentLoco] + "<;>F0" + centerFunction + "\n");
+              sendCommand(wiThrottleCommand(locoPrefix[currentLoco]).add("F0").add(centerFunction));
               break;
 
             case ALWAYS_ON:
@@ -252,23 +466,25 @@ void locoHandler(void)
               break;
           }
         }
-        client.print(String("MT-") + locoThrottleID[currentLoco] + "<;>r\n");
+        sendCommand(wiThrottleCommand("MT-").add(locoThrottleID[currentLoco]).add("<;>r"));
       }
 
       locoState[currentLoco] = LOCO_INACTIVE;
       if(allLocosInactive())
       {
-        switchState(STATE_LOCOS_OFF, 6000);
+        switchState(STATE_LOCOS_OFF);
       }
     }
-    else if(currentLoco == 3)
-    {
-      // if none of the locos had any status change,
-      // flush all input data
-      client.flush();
-      while (client.read() > -1)
-        ;
-    }
+  }
+
+  // all previously active locos have been acquired again in this pass, they have been
+  // stopped by resumeLoco() and only drive again once the speed knob has been turned to zero
+  if(resumed)
+  {
+    eSTOP = true;
+    sessionResumes++;
+    lastOutageTime = now - outageStart;
+    log_d("Session resumed after %u ms outage", lastOutageTime);
   }
 
   String ledForward, ledReverse;
@@ -303,68 +519,177 @@ void locoHandler(void)
 }
 
 /**
- * Connect to wiThrottle server
+ * Phases of connecting to the wiThrottle server, each lasting several main loop passes
  */
-void locoConnect(void)
+enum eConnectPhase { CONNECT_IDLE, CONNECT_DISCOVERY, CONNECT_RESOLVING, CONNECT_IN_PROGRESS };
+
+eConnectPhase connectPhase = CONNECT_IDLE;
+
+/**
+ * millis() value when the current connection attempt has been started
+ */
+uint32_t connectAttemptStart;
+
+/**
+ * Earliest millis() value for the next connection attempt after a failed one
+ */
+uint32_t nextConnectAttempt = 0;
+
+/**
+ * Forget about any connection attempt in progress, called when entering STATE_CONNECTED
+ */
+void locoConnectReset(void)
 {
-  if(locoServer.automatic && automaticServer != nullptr)
+  abortConnect();
+  connectPhase = CONNECT_IDLE;
+
+  // the connection to the server has been lost, remember which locos to resume
+  for(uint8_t loco = 0; loco < 4; loco++)
+  {
+    if(locoState[loco] == LOCO_ACTIVE && locos[loco].address != -1)
     {
-      log_d("Trying to connect to automatic server %s...", automaticServer);
-      if(client.connect(automaticServerIP, locoServer.port))
-	    {
-        log_d("...succeeded.");
-	      client.setNoDelay(true);
-	      client.setTimeout(10);
-	      switchState(STATE_LOCO_CONNECTING, 10 * 1000);
-	    }
-      else
+      if(outageStart != lastOnline)
       {
-        log_d("...failed. Resetting server info.");
-        free(automaticServer);
-        automaticServer = nullptr;
+        outageStart = lastOnline;
+        log_d("Connection lost, resuming session after reconnect");
       }
+      locoState[loco] = LOCO_RESUME;
     }
-  else if(!locoServer.automatic)
+    else if(locoState[loco] == LOCO_FUNCTIONS || locoState[loco] == LOCO_LEAVE_FUNCTIONS)
     {
-      log_d("Trying to connect to server %s...", locoServer.name);
-      if(client.connect(locoServer.name, locoServer.port))
-	    {
-        log_d("...succeeded.");
-	      client.setNoDelay(true);
-	      client.setTimeout(10);
-	      switchState(STATE_LOCO_CONNECTING, 10 * 1000);
-	    }
+      // readout was interrupted, start over
+      locoState[loco] = LOCO_ACTIVATE;
     }
+  }
+}
 
-  if(locoServer.automatic && automaticServer == nullptr
-     && (wiFredState == STATE_CONNECTED || wiFredState == STATE_CONFIG_AP) )
-    {
-      log_d("Looking for automatic server.");
-      uint32_t n = MDNS.queryService("withrottle", "tcp");
-      for(uint32_t i = 0; i < n; i++)
+/**
+ * Note a failed connection attempt and wait a bit before retrying
+ */
+void locoConnectFailed(void)
+{
+  log_d("...failed.");
+  if(locoServer.automatic)
+  {
+    serverConnectFailed();
+  }
+  connectPhase = CONNECT_IDLE;
+  nextConnectAttempt = millis() + CONNECT_RETRY_DELAY_MS;
+}
+
+/**
+ * Start connecting to the given address or note the failure
+ */
+void locoConnectTo(IPAddress ip, uint16_t port)
+{
+  log_d("Trying to connect to %s:%u...", ip.toString().c_str(), port);
+  if(startConnect(ip, port))
+  {
+    connectPhase = CONNECT_IN_PROGRESS;
+  }
+  else
+  {
+    locoConnectFailed();
+  }
+}
+
+/**
+ * Connect to wiThrottle server
+ *
+ * Never blocks, call repeatedly until the state switches to STATE_LOCO_CONNECTING
+ */
+void locoConnect(void)
+{
+  IPAddress ip;
+
+  switch(connectPhase)
+  {
+    case CONNECT_IDLE:
+      if((int32_t) (millis() - nextConnectAttempt) < 0)
       {
-        log_d("Hostname: %s IP: %s Port: %u", MDNS.hostname(i).c_str(), MDNS.address(i).toString().c_str(), MDNS.port(i));
-        if(MDNS.port(i) == locoServer.port)
-	      {
-	        automaticServer = strdup(MDNS.hostname(i).c_str());
-	        automaticServerIP = MDNS.address(i);
-//	        MDNS.removeQuery();
-	        break;          
-	      }
+        break;
       }
-      if(n == 0)
+      // port has been changed since the server was found, or it has been found in another network
+      if(serverCache.valid && (serverCache.port != locoServer.port || !serverCacheMatchesNetwork()))
       {
-        automaticServerIP = WiFi.localIP();
-        IPAddress netmask = WiFi.subnetMask();
-        for(uint32_t i=0; i<=3; i++)
-        {
-          automaticServerIP[i] &= netmask[i];
-        }
-        automaticServerIP[3] += 1;
-        automaticServer = strdup(automaticServerIP.toString().c_str());
-        log_d("No MDNS-announced wiThrottle server found. Trying LNWI/DCCEX at %s.", automaticServer);
+        forgetServer();
       }
-    }
+      connectAttemptStart = millis();
+      if(locoServer.automatic && serverCache.valid)
+      {
+        log_d("Using automatic server %s", serverCache.hostname);
+        locoConnectTo(serverCache.ip, serverCache.port);
+      }
+      else if(locoServer.automatic)
+      {
+        startDiscovery();
+        connectPhase = CONNECT_DISCOVERY;
+      }
+      else if(ip.fromString(locoServer.name))
+      {
+        locoConnectTo(ip, locoServer.port);
+      }
+      else if(startResolve(locoServer.name))
+      {
+        connectPhase = CONNECT_RESOLVING;
+      }
+      else
+      {
+        locoConnectFailed();
+      }
+      break;
+
+    case CONNECT_DISCOVERY:
+      if(pollDiscovery())
+      {
+        // connect on the next pass
+        connectPhase = CONNECT_IDLE;
+      }
+      break;
+
+    case CONNECT_RESOLVING:
+      switch(pollResolve(ip))
+      {
+        case ASYNC_DONE:
+          log_d("Resolved %s to %s after %u ms", locoServer.name, ip.toString().c_str(), millis() - connectAttemptStart);
+          locoConnectTo(ip, locoServer.port);
+          break;
+        case ASYNC_FAILED:
+          log_d("Could not resolve %s", locoServer.name);
+          locoConnectFailed();
+          break;
+        case ASYNC_PENDING:
+          break;
+      }
+      break;
+
+    case CONNECT_IN_PROGRESS:
+      switch(pollConnect(client))
+      {
+        case ASYNC_DONE:
+          log_d("...succeeded.");
+          if(locoServer.automatic)
+          {
+            serverConnected(millis() - connectAttemptStart);
+          }
+          else
+          {
+            log_d("Connected to %s in %u ms", locoServer.name, millis() - connectAttemptStart);
+          }
+          connectPhase = CONNECT_IDLE;
+          rxLines.clear();
+          client.setNoDelay(true);
+          client.setTimeout(10);
+          switchState(STATE_LOCO_CONNECTING);
+          break;
+        case ASYNC_FAILED:
+          locoConnectFailed();
+          break;
+        case ASYNC_PENDING:
+          break;
+      }
+      break;
+  }
   lastActivity = millis();
 }
 
@@ -380,7 +705,7 @@ void locoDisconnect(void)
       locoState[loco] = LOCO_ACTIVATE;
     }
   }
-  client.print("Q\n");
+  sendCommand("Q\n");
 }
 
 /**
@@ -390,24 +715,34 @@ void locoRegister(void)
 {
   if(client.connected())
   {
-    client.print(String("N") + throttleName + "\n");
+    // throttle name might be longer than a command buffer
+    sendCommand("N");
+    sendCommand(throttleName);
+    sendCommand("\n");
     uint8_t mac[6];
     WiFi.macAddress(mac);
-    String id = String(mac[0], 16) + String(mac[1], 16) + String(mac[2], 16) + String(mac[3], 16) + String(mac[4], 16) + String(mac[5], 16);
-    client.print("HU" + id + "\n");
+    wiThrottleCommand id("HU");
+    for(uint8_t i = 0; i < 6; i++)
+    {
+      id.addHex(mac[i]);
+    }
+    sendCommand(id);
   
-    if(client.available())
+    rxLines.poll(client);
+    lineView line;
+    while(rxLines.nextLine(line))
     {
-      String line = client.readStringUntil('\n');
-      if (line.startsWith("VN2.0"))
+      if (startsWith(line, "VN2.0"))
       {
-        switchState(STATE_LOCO_WAITFORTIMEOUT, 1000);
+        // leave the remaining lines for timeoutReceived()
+        switchState(STATE_LOCO_WAITFORTIMEOUT);
+        break;
       }
     }
   }
   else
   {
-    switchState(STATE_CONNECTED, 60 * 1000);
+    switchState(STATE_CONNECTED);
   }
 }
 
@@ -419,19 +754,90 @@ void locoRegister(void)
 bool timeoutReceived(void)
 {
   bool success = false;
-  while(client.available())
+  rxLines.poll(client);
+  lineView line;
+  while(rxLines.nextLine(line))
   {
-    String line = client.readStringUntil('\n');
-    if(line.charAt(0) == '*')
+    if(charAt(line, 0) == '*')
     {
-      keepAliveTimeout = 400 * line.substring(1).toInt();
-      client.print("*+\n");
+      sendCommand("*+\n");
       success = true;
     }
+    handleServerLine(line);
   }
   return success;
 }
 
+/**
+ * Has this loco been acquired on the server, i.e. will it react to "MTA*" commands?
+ */
+bool isAcquired(uint8_t loco)
+{
+  if(locos[loco].address == -1)
+  {
+    return false;
+  }
+  switch(locoState[loco])
+  {
+    case LOCO_FUNCTIONS:
+    case LOCO_LEAVE_FUNCTIONS:
+    case LOCO_ACTIVE:
+    case LOCO_DEACTIVATE:
+      return true;
+
+    case LOCO_ACTIVATE:
+    case LOCO_INACTIVE:
+    case LOCO_RESUME:
+      break;
+  }
+  return false;
+}
+
+/**
+ * Send the same action to a group of locos
+ * 
+ * Uses a single "MTA*" line if all acquired locos are active and want the same value,
+ * one line per loco otherwise. Mixing a wildcard line with per-loco corrections is
+ * avoided on purpose as it would briefly apply the wrong action to the other locos.
+ * 
+ * @param action  Action to send, i.e. "F1" or "R"
+ * @param values  Value to append to action for each loco, -1 to leave this loco alone
+ */
+void sendToLocos(const char * action, const int values[4])
+{
+  bool wildcard = true;
+  int commonValue = -1;
+  uint8_t numLocos = 0;
+
+  for(uint8_t l = 0; l < 4; l++)
+  {
+    if(!isAcquired(l))
+    {
+      continue;
+    }
+    if(locoState[l] != LOCO_ACTIVE || values[l] == -1 || (commonValue != -1 && values[l] != commonValue))
+    {
+      wildcard = false;
+    }
+    commonValue = values[l];
+    numLocos++;
+  }
+
+  if(wildcard && numLocos > 1)
+  {
+    sendCommand(wiThrottleCommand("MTA*<;>").add(action).add(commonValue));
+    return;
+  }
+
+  for(uint8_t l = 0; l < 4; l++)
+  {
+    if(isAcquired(l) && values[l] != -1)
+    {
+      sendCommand(wiThrottleCommand(locoPrefix[l]).add(action).add(values[l]));
+    }
+  }
+}
+
 /**
  * Activate function (only of currently connected and function is throttle controlled)
  */
@@ -442,6 +848,7 @@ void setFunction(uint8_t f)
     return;
   }
   bool firstLoco = true;
+  int values[4] = { -1, -1, -1, -1 };
   for(uint8_t l = 0; l < 4 && f <= MAX_FUNCTION; l++)
   {
     // skip inactive locos
@@ -478,7 +885,7 @@ void setFunction(uint8_t f)
         // intentionally fall through
 
       case THROTTLE_MOMENTARY:
-        client.print(String("MTA") + locoThrottleID[l] + "<;>F1" + f + "\n");
+        values[l] = f;
         break;
 
       case ALWAYS_ON:
@@ -487,6 +894,7 @@ void setFunction(uint8_t f)
         break;
     }
   }
+  sendToLocos("F1", values);
   lastActivity = lastHeartBeat = millis();
 }
 
@@ -499,6 +907,7 @@ void clearFunction(uint8_t f)
   {
     return;
   }
+  int values[4] = { -1, -1, -1, -1 };
   for(uint8_t l = 0; l < 4 && f <= MAX_FUNCTION; l++)
   {
     // skip inactive locos
@@ -519,7 +928,7 @@ void clearFunction(uint8_t f)
       case THROTTLE:
       case THROTTLE_LOCKING:
       case THROTTLE_MOMENTARY:
-        client.print(String("MTA") + locoThrottleID[l] + "<;>F0" + f + "\n");
+        values[l] = f;
         break;
 
       case ALWAYS_ON:
@@ -528,6 +937,7 @@ void clearFunction(uint8_t f)
         break;
     }
   }
+  sendToLocos("F0", values);
   lastActivity = lastHeartBeat = millis();
 }
 
@@ -548,6 +958,7 @@ void setReverse(bool newReverse)
     {
       return;
     }
+    int values[4] = { -1, -1, -1, -1 };
     for(uint8_t l = 0; l < 4; l++)
     {
       if(locoState[l] != LOCO_ACTIVE)
@@ -556,13 +967,14 @@ void setReverse(bool newReverse)
       }
       if(myReverse ^ locos[l].reverse)
       {
-        client.print(String("MTA") + locoThrottleID[l] + "<;>R0\n");
+        values[l] = 0;
       }
       else
       {
-        client.print(String("MTA") + locoThrottleID[l] + "<;>R1\n");
+        values[l] = 1;
       }
     }
+    sendToLocos("R", values);
   }
 }
 
@@ -589,7 +1001,10 @@ void setESTOP(void)
 {
   if(wiFredState == STATE_LOCO_ONLINE && !eSTOP)
   {
-    client.print("MTA*<;>X\n");
+    sendCommand("MTA*<;>X\n");
+    cancelRTTProbe();
+    // do not wait for the end of the loop pass
+    locoFlush();
   }
   eSTOP = true;
 }
@@ -612,26 +1027,54 @@ void requestLoco(uint8_t loco)
   }
   
   // first step for new loco: Send "loco acquire" command, set speed mode and send ESTOP command right afterwards to make sure loco is not moving
-  if(locos[loco].longAddress)
-  {
-    locoThrottleID[loco] = String("L") + locos[loco].address;
-  }
-  else
-  {
-    locoThrottleID[loco] = String("S") + locos[loco].address;      
-  }
+  wiThrottleCommand id(locos[loco].longAddress ? "L" : "S");
+  id.add(locos[loco].address);
+  strncpy(locoThrottleID[loco], id.c_str(), THROTTLE_ID_LENGTH - 1);
+  locoThrottleID[loco][THROTTLE_ID_LENGTH - 1] = '\0';
+  wiThrottleCommand prefix("MTA");
+  prefix.add(locoThrottleID[loco]).add("<;>");
+  strncpy(locoPrefix[loco], prefix.c_str(), LOCO_PREFIX_LENGTH - 1);
+  locoPrefix[loco][LOCO_PREFIX_LENGTH - 1] = '\0';
+
   // '+' - Add a locomotive to the throttle
-  client.print(String("MT+") + locoThrottleID[loco] + "<;>" + locoThrottleID[loco] + "\n");
+  sendCommand(wiThrottleCommand("MT+").add(locoThrottleID[loco]).add("<;>").add(locoThrottleID[loco]));
   // 'A' - Action, 's' - set speed step mode
   if (strcmp(MODE_DO_NOT_SEND, locos[loco].mode) != 0)
   {
-    client.print(String("MTA") + locoThrottleID[loco] + "<;>s" + locos[loco].mode + "\n");
+    sendCommand(wiThrottleCommand(locoPrefix[loco]).add('s').add(locos[loco].mode));
   }
   // 'A' - Action, 'X' - emergency stop
-  client.print(String("MTA") + locoThrottleID[loco] + "<;>X\n");
+  sendCommand(wiThrottleCommand(locoPrefix[loco]).add('X'));
+  locoStatus[loco].functions = locoStatus[loco].functionsKnown = 0;
+  locoStatus[loco].speed = -1;
+  locoStatus[loco].forward = true;
+  locoStatus[loco].speedStepMode = 0;
   setESTOP();
   locoState[loco] = LOCO_FUNCTIONS;
-  locoTimeout[loco] = millis() + 500;
+  acquireStart[loco] = millis();
+  acquireReplyPending[loco] = true;
+  locoTimeout[loco] = acquireStart[loco] + 500;
+}
+
+/**
+ * Acquire a loco again after the connection to the server has been lost
+ *
+ * Direction and function states are known from before the outage,
+ * so they are restored right away without waiting for a readout.
+ * The loco is stopped, it may have been stopped by the server during the
+ * outage and must not start moving again without the operator.
+ */
+void resumeLoco(uint8_t loco)
+{
+  sendCommand(wiThrottleCommand("MT+").add(locoThrottleID[loco]).add("<;>").add(locoThrottleID[loco]));
+  if (strcmp(MODE_DO_NOT_SEND, locos[loco].mode) != 0)
+  {
+    sendCommand(wiThrottleCommand(locoPrefix[loco]).add('s').add(locos[loco].mode));
+  }
+  sendCommand(wiThrottleCommand(locoPrefix[loco]).add('X'));
+  acquireStart[loco] = millis();
+  acquireReplyPending[loco] = true;
+  setLocoFunctions(loco);
 }
 
 /**
@@ -645,12 +1088,12 @@ void setLocoFunctions(uint8_t loco)
     switch(locos[loco].functions[f])
     {
       case THROTTLE_MOMENTARY:
-        client.print(String("MTA") + locoThrottleID[loco] + "<;>m1" + f + "\n");
+        sendCommand(wiThrottleCommand(locoPrefix[loco]).add("m1").add(f));
         break;
       
       case THROTTLE_LOCKING:
       case THROTTLE_SINGLE:
-        client.print(String("MTA") + locoThrottleID[loco] + "<;>m0" + f + "\n");
+        sendCommand(wiThrottleCommand(locoPrefix[loco]).add("m0").add(f));
         break;
 
       case THROTTLE:
@@ -667,20 +1110,20 @@ void setLocoFunctions(uint8_t loco)
       case THROTTLE_LOCKING:
         if(globalFunctionStatus[f] == ALWAYS_ON)
         {
-          client.print(String("MTA") + locoThrottleID[loco] + "<;>f1" + f + "\n");
+          sendCommand(wiThrottleCommand(locoPrefix[loco]).add("f1").add(f));
         }
         if(globalFunctionStatus[f] == ALWAYS_OFF)
         {
-          client.print(String("MTA") + locoThrottleID[loco] + "<;>f0" + f + "\n");
+          sendCommand(wiThrottleCommand(locoPrefix[loco]).add("f0").add(f));
         }
         break;
 
       case ALWAYS_ON:
-        client.print(String("MTA") + locoThrottleID[loco] + "<;>f1" + f + "\n");
+        sendCommand(wiThrottleCommand(locoPrefix[loco]).add("f1").add(f));
         break;
 
       case ALWAYS_OFF:
-        client.print(String("MTA") + locoThrottleID[loco] + "<;>f0" + f + "\n");
+        sendCommand(wiThrottleCommand(locoPrefix[loco]).add("f0").add(f));
         break;
 
       case THROTTLE_SINGLE:
@@ -693,7 +1136,7 @@ void setLocoFunctions(uint8_t loco)
       case THROTTLE_MOMENTARY:
         if(centerPosition && centerFunction == f)
         {
-          client.print(String("MTA") + locoThrottleID[loco] + "<;>F1" + f + "\n");
+          sendCommand(wiThrottleCommand(locoPrefix[loco]).add("F1").add(f));
         }
         break;
         
@@ -720,99 +1163,215 @@ void setLocoFunctions(uint8_t loco)
   // Set correct direction
   if(myReverse ^ locos[loco].reverse)
   {
-    client.print(String("MTA") + locoThrottleID[loco] + "<;>R0\n");
+    sendCommand(wiThrottleCommand(locoPrefix[loco]).add("R0"));
   }
   else
   {
-    client.print(String("MTA") + locoThrottleID[loco] + "<;>R1\n");
+    sendCommand(wiThrottleCommand(locoPrefix[loco]).add("R1"));
   }
 
-  // flush all client data
-  client.flush();
-  while(client.read() > -1)
-    ;
   locoState[loco] = LOCO_ACTIVE;
+  log_d("Loco %u drivable after %u ms (%u ms since boot)", loco + 1, millis() - acquireStart[loco], millis());
 }
 
 /**
- * Read functions on newly acquired loco
+ * Wait for the function readout of a newly acquired loco
+ * (the readout itself is processed by readLocoFunctions)
  */
 void getLocoFunctions(uint8_t loco)
 {
-  if(!client.available())
+  if(locoTimeout[loco] < millis())
   {
-    if(locoTimeout[loco] < millis())
-    {
-      locoTimeout[loco] = UINT32_MAX;
-      locoState[loco] = LOCO_LEAVE_FUNCTIONS;
-    }
+    locoTimeout[loco] = UINT32_MAX;
+    locoState[loco] = LOCO_LEAVE_FUNCTIONS;
   }
-  else
-  {
-    String line = client.readStringUntil('\n');
-#ifdef DEBUG
-    Serial.println();
-    Serial.println(line);
-#endif
-    if(line.startsWith(String("MTA") + locoThrottleID[loco]))
-    {
+}
+
+/**
+ * Evaluate the readout of functions and direction on a newly acquired loco
+ * 
+ * @param loco     Loco the reply refers to
+ * @param command  Reply without "MTA<locoThrottleID><;>" prefix
+ */
+void readLocoFunctions(uint8_t loco, const char * command)
+{
 #ifdef DEBUG
-      Serial.println(line);
-      Serial.println(locoThrottleID[loco]);
-      Serial.println(String("") + loco + " " + line.charAt(6 + locoThrottleID[loco].length()));
+  Serial.println(String("") + loco + " " + command);
 #endif
 
-      bool set = false;
-      uint8_t f = 0;
+  uint8_t f = 0;
       
-      switch(line.charAt(6 + locoThrottleID[loco].length()))
+  switch(command[0])
+  {
+    // responding with function status
+    case 'F':
+      f = atoi(command + 2);
+      // only work on functions up to our maximum
+      if(f > MAX_FUNCTION)
       {
-        // responding with function status
-        case 'F':
-          f = line.substring(8 + locoThrottleID[loco].length()).toInt();
-          // only work on functions up to our maximum
-          if(f > MAX_FUNCTION)
+        break;
+      }
+      if(locos[loco].functions[f] == THROTTLE || locos[loco].functions[f] == THROTTLE_LOCKING)
+      {
+        // if this is the first loco that has this function controlled by our function keys, copy state
+        if(globalFunctionStatus[f] == UNKNOWN)
+        {
+          if(command[1] == '1')
           {
-            break;
+            globalFunctionStatus[f] = ALWAYS_ON;
           }
-          if(line.charAt(7 + locoThrottleID[loco].length()) == '1')
+          else
           {
-            set = true;
+            globalFunctionStatus[f] = ALWAYS_OFF;
           }
-          if(locos[loco].functions[f] == THROTTLE || locos[loco].functions[f] == THROTTLE_LOCKING)
+        }
+      }
+      break;
+  
+    // responding with direction status - if this loco should keep its direction, set its reverse parameter accordingly
+    case 'R':
+      if(locos[loco].direction == DIR_DONTCHANGE)
+      {
+        locos[loco].reverse = (command[1] == '0') ^ myReverse;
+      }
+      break;
+  
+    // last line of regular response, everything should be done by now, so switch to online state
+    case 's':
+      locoState[loco] = LOCO_LEAVE_FUNCTIONS;
+      locoTimeout[loco] = UINT32_MAX;
+      break;
+  }
+}
+
+/**
+ * Find the loco a reply from the server refers to
+ * 
+ * @param key     Start of the loco key in the reply, i.e. "L341<;>F112"
+ * @param length  Length of the loco key
+ * @returns loco index or -1 if this is not one of our locos
+ */
+int8_t findLoco(const char * key, size_t length)
+{
+  for(uint8_t l = 0; l < 4; l++)
+  {
+    if(isAcquired(l) && strlen(locoThrottleID[l]) == length && strncmp(locoThrottleID[l], key, length) == 0)
+    {
+      return l;
+    }
+  }
+  return -1;
+}
+
+/**
+ * Process a single line received from the wiThrottle server
+ */
+void handleServerLine(const lineView & line)
+{
+#ifdef DEBUG
+  Serial.println(line.text);
+#endif
+
+  switch(charAt(line, 0))
+  {
+    // new heartbeat timeout
+    case '*':
+      keepAliveTimeout = 400 * atoi(line.text + 1);
+      break;
+
+    // roster list
+    case 'R':
+      if(charAt(line, 1) == 'L')
+      {
+        rosterSize = atoi(line.text + 2);
+      }
+      break;
+
+    // alert and info messages
+    case 'H':
+      if(charAt(line, 1) == 'M' || charAt(line, 1) == 'm')
+      {
+        strncpy(serverMessage, line.text + 2, SERVER_MESSAGE_LENGTH - 1);
+        serverMessage[SERVER_MESSAGE_LENGTH - 1] = '\0';
+        log_i("Message from server: %s", serverMessage);
+      }
+      break;
+
+    // loco actions on our multi throttle
+    case 'M':
+    {
+      if(charAt(line, 1) != 'T' || charAt(line, 2) != 'A')
+      {
+        break;
+      }
+      const char * separator = strstr(line.text + 3, "<;>");
+      if(separator == nullptr)
+      {
+        break;
+      }
+      int8_t l = findLoco(line.text + 3, separator - (line.text + 3));
+      if(l < 0)
+      {
+        break;
+      }
+      const char * command = separator + 3;
+      int f;
+
+      if(acquireReplyPending[l])
+      {
+        addRTTSample(millis() - acquireStart[l]);
+        acquireReplyPending[l] = false;
+      }
+
+      switch(command[0])
+      {
+        case 'F':
+          f = atoi(command + 2);
+          if(0 <= f && f < 32)
           {
-            // if this is the first loco that has this function controlled by our function keys, copy state
-            if(globalFunctionStatus[f] == UNKNOWN)
+            if(command[1] == '1')
             {
-              if(set)
-              {
-                globalFunctionStatus[f] = ALWAYS_ON;
-              }
-              else
-              {
-                globalFunctionStatus[f] = ALWAYS_OFF;
-              }
+              locoStatus[l].functions |= (1UL << f);
             }
+            else
+            {
+              locoStatus[l].functions &= ~(1UL << f);
+            }
+            locoStatus[l].functionsKnown |= (1UL << f);
+          }
+          // keep track of changes made by other throttles to functions we control
+          if(locoState[l] == LOCO_ACTIVE && 0 <= f && f <= MAX_FUNCTION && globalFunctionStatus[f] != UNKNOWN
+             && (locos[l].functions[f] == THROTTLE || locos[l].functions[f] == THROTTLE_LOCKING))
+          {
+            globalFunctionStatus[f] = (command[1] == '1') ? ALWAYS_ON : ALWAYS_OFF;
           }
           break;
-  
-        // responding with direction status - if this loco should keep its direction, set its reverse parameter accordingly
+
         case 'R':
-          if(locos[loco].direction == DIR_DONTCHANGE)
+          locoStatus[l].forward = (command[1] == '1');
+          break;
+
+        case 'V':
+          finishRTTProbe(l);
+          locoStatus[l].speed = atoi(command + 1);
+          if(locoStatus[l].speed == speedEcho)
           {
-            locos[loco].reverse = (line.charAt(7 + locoThrottleID[loco].length()) == '0') ^ myReverse;
+            // exponentially weighted average over about 8 samples
+            speedRoundTrip = (7 * speedRoundTrip + (millis() - speedEchoSent) + 4) / 8;
+            speedEcho = -1;
           }
           break;
-  
-        // last line of regular response, everything should be done by now, so switch to online state and flush client buffer
+
         case 's':
-          locoState[loco] = LOCO_LEAVE_FUNCTIONS;
-          locoTimeout[loco] = UINT32_MAX;
-          // flush all input data
-          while (client.read() > -1)
-            ;
+          locoStatus[l].speedStepMode = atoi(command + 1);
           break;
       }
+
+      if(locoState[l] == LOCO_FUNCTIONS)
+      {
+        readLocoFunctions(l, command);
+      }
+      break;
     }
   }
 }
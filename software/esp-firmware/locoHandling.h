@@ -25,10 +25,27 @@
 
 #define MAX_FUNCTION 16
 
-/** 
- * Don't send speed commands more often than this (milliseconds)
+/**
+ * Default limits for the time between two speed commands in ms
+ * The holdoff actually used is twice the measured speed command round trip time within these limits
+ */
+#define SPEED_HOLDOFF_MIN_DEFAULT 50
+#define SPEED_HOLDOFF_MAX_DEFAULT 250
+
+/**
+ * Give up waiting for the echo of a speed command after this time in ms
+ */
+#define SPEED_ECHO_TIMEOUT 2000
+
+/**
+ * Size of the buffer collecting all outgoing wiThrottle commands of one loop() pass
+ */
+#define TX_BUFFER_SIZE 1024
+
+/**
+ * Keep this many characters of the last message (alert or info) from the server
  */
-#define SPEED_HOLDOFF_PERIOD 150
+#define SERVER_MESSAGE_LENGTH 64
 
 /**
  * Put wiFred to sleep if not in use for this long time
@@ -42,10 +59,12 @@
 #include <stdbool.h>
 
 #include "config.h"
+#include "wiThrottleCommand.h"
+#include "lineReader.h"
 
 enum functionInfo { THROTTLE, THROTTLE_MOMENTARY, THROTTLE_LOCKING, THROTTLE_SINGLE, ALWAYS_ON, ALWAYS_OFF, IGNORE, UNKNOWN = THROTTLE };
 enum eDirection { DIR_NORMAL, DIR_REVERSE, DIR_DONTCHANGE };
-enum eLocoState { LOCO_ACTIVATE, LOCO_FUNCTIONS, LOCO_LEAVE_FUNCTIONS, LOCO_ACTIVE, LOCO_DEACTIVATE, LOCO_INACTIVE };
+enum eLocoState { LOCO_ACTIVATE, LOCO_FUNCTIONS, LOCO_LEAVE_FUNCTIONS, LOCO_ACTIVE, LOCO_DEACTIVATE, LOCO_INACTIVE, LOCO_RESUME };
 
 extern eLocoState locoState[4];
 
@@ -81,20 +100,104 @@ typedef struct
 } locoInfo;
 
 extern locoInfo locos[4];
+
+/**
+ * Loco state as reported by the wiThrottle server, including changes by other throttles
+ */
+typedef struct
+{
+  uint32_t functions;      // bit n set if function n is on
+  uint32_t functionsKnown; // bit n set if the state of function n has been reported
+  int16_t speed;           // 0..126, negative if unknown or emergency stopped
+  bool forward;
+  uint8_t speedStepMode;   // as reported by the server (1, 2, 4, 8, 16), 0 if unknown
+} locoStatusInfo;
+
+extern locoStatusInfo locoStatus[4];
+
+/**
+ * Limits for the time between two speed commands in ms (configurable)
+ */
+extern uint16_t speedHoldoffMin;
+extern uint16_t speedHoldoffMax;
+
+/**
+ * Smoothed round trip time from a speed command to its echo from the server in ms
+ */
+extern uint32_t speedRoundTrip;
+
+/**
+ * @returns time to wait between two speed commands in ms
+ */
+uint32_t getSpeedHoldoff(void);
+
+/**
+ * @returns number of speed steps of the coarsest acquired loco as reported by the server
+ *          or configured, 126 if not known
+ */
+uint8_t getSpeedSteps(void);
+
+/**
+ * Number of speed commands sent and number of speed changes not sent
+ * because they would not have changed the speed step of any loco
+ */
+extern uint32_t speedCommandsSent;
+extern uint32_t speedCommandsSuppressed;
+
+/**
+ * Number of sessions resumed after a lost connection, duration of the last outage in ms
+ * (from the last pass online until all locos were acquired again)
+ */
+extern uint32_t sessionResumes;
+extern uint32_t lastOutageTime;
+
+/**
+ * Number of entries in the server roster, last alert or info message from the server
+ */
+extern uint16_t rosterSize;
+extern char serverMessage[SERVER_MESSAGE_LENGTH];
 extern serverInfo locoServer;
-extern char * automaticServer;
-extern IPAddress automaticServerIP;
 
 /**
  * Remember the Loco Address plus its prefix (L or S)
  */
-extern String locoThrottleID[4];
+extern char locoThrottleID[4][THROTTLE_ID_LENGTH];
+
+/**
+ * Precomputed "MTA<locoThrottleID><;>" prefix for commands to a single loco
+ */
+extern char locoPrefix[4][LOCO_PREFIX_LENGTH];
+
+/**
+ * Number of commands queued for and number of writes sent to the wiThrottle server
+ */
+extern uint32_t txCommandCount;
+extern uint32_t txWriteCount;
+
+/**
+ * Time to wait after a failed connection attempt before trying again
+ */
+#define CONNECT_RETRY_DELAY_MS 500
 
 /**
  * Connect to wiThrottle server
+ *
+ * Never blocks, call repeatedly until the state switches to STATE_LOCO_CONNECTING
  */
 void locoConnect(void);
 
+/**
+ * Forget about any connection attempt in progress, called when entering STATE_CONNECTED
+ */
+void locoConnectReset(void);
+
+/**
+ * Send out all commands queued during this loop() pass in a single write
+ * 
+ * Call once at the end of each loop() pass
+ */
+void locoFlush(void);
+
 /**
  * Disconnect from wiThrottle server
  */
@@ -163,16 +266,34 @@ void setESTOP(void);
  */
 void requestLoco(uint8_t loco);
 
+/**
+ * Acquire a loco again after the connection to the server has been lost,
+ * restoring direction and functions without a readout, the loco is stopped
+ */
+void resumeLoco(uint8_t loco);
+
 /**
  * Set correct function and direction settings on newly acquired loco
  */
 void setLocoFunctions(uint8_t loco);
 
 /**
- * Read current function and direction settings on newly acquired loco
+ * Wait for the function and direction readout of a newly acquired loco
+ * (the readout itself is processed by handleServerLine)
  */
 void getLocoFunctions(uint8_t loco);
 
+/**
+ * Process a single line received from the wiThrottle server
+ * and keep track of the loco states reported in it
+ */
+void handleServerLine(const lineView & line);
+
+/**
+ * Has this loco been acquired on the server, i.e. will it react to "MTA*" commands?
+ */
+bool isAcquired(uint8_t loco);
+
 /**
  * Are there any active locos left?
  * 
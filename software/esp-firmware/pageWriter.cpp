@@ -0,0 +1,102 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides a Print target that streams a web page to the client in
+ * fixed size chunks while it is being generated, instead of building the
+ * whole page in one String first.
+ */
+
+#include <string.h>
+
+#include "pageWriter.h"
+
+/**
+ * Start a chunked response
+ *
+ * @param server web server handling the current request
+ * @param contentType i.e. "text/html"
+ */
+pageWriter::pageWriter(WebServer &server, const char * contentType) : server(server)
+{
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, contentType, "");
+}
+
+/**
+ * Finish the response if end() has not been called yet
+ */
+pageWriter::~pageWriter()
+{
+  end();
+}
+
+size_t pageWriter::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t pageWriter::write(const uint8_t * data, size_t size)
+{
+  size_t written = 0;
+
+  if(ended)
+  {
+    return 0;
+  }
+
+  while(written < size)
+  {
+    size_t part = size - written;
+    if(part > PAGE_CHUNK_SIZE - length)
+    {
+      part = PAGE_CHUNK_SIZE - length;
+    }
+    memcpy(buffer + length, data + written, part);
+    length += part;
+    written += part;
+    if(length == PAGE_CHUNK_SIZE)
+    {
+      flush();
+    }
+  }
+  return written;
+}
+
+/**
+ * Send out everything buffered so far as one chunk
+ */
+void pageWriter::flush(void)
+{
+  if(length > 0)
+  {
+    server.sendContent(buffer, length);
+    length = 0;
+  }
+}
+
+/**
+ * Send the rest of the page and the final empty chunk
+ */
+void pageWriter::end(void)
+{
+  if(!ended)
+  {
+    flush();
+    server.sendContent("");
+    ended = true;
+  }
+}
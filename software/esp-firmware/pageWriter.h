@@ -0,0 +1,71 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides a Print target that streams a web page to the client in
+ * fixed size chunks while it is being generated, instead of building the
+ * whole page in one String first.
+ */
+
+#ifndef _PAGE_WRITER_H_
+#define _PAGE_WRITER_H_
+
+#include <Print.h>
+#include <WebServer.h>
+
+/**
+ * Size of one chunk sent to the client
+ */
+#define PAGE_CHUNK_SIZE 1024
+
+class pageWriter : public Print
+{
+  public:
+    /**
+     * Start a chunked response
+     *
+     * @param server web server handling the current request
+     * @param contentType i.e. "text/html"
+     */
+    pageWriter(WebServer &server, const char * contentType);
+
+    /**
+     * Finish the response if end() has not been called yet
+     */
+    ~pageWriter();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+
+    /**
+     * Send out everything buffered so far as one chunk
+     */
+    void flush(void) override;
+
+    /**
+     * Send the rest of the page and the final empty chunk
+     */
+    void end(void);
+
+  private:
+    WebServer &server;
+    char buffer[PAGE_CHUNK_SIZE];
+    size_t length = 0;
+    bool ended = false;
+};
+
+#endif
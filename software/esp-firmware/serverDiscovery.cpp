@@ -0,0 +1,315 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file finds the wiThrottle server through mDNS and keeps the result
+ * in a persistent cache, so reconnects can skip the discovery.
+ */
+
+#include <WiFi.h>
+#include <mdns.h>
+
+#include "serverDiscovery.h"
+#include "locoHandling.h"
+#include "config.h"
+#include "stateMachine.h"
+
+serverCacheInfo serverCache;
+
+serverDiscoveryStatistics discoveryStats;
+
+/**
+ * Running background query, nullptr if none
+ */
+mdns_search_once_t * revalidation = nullptr;
+
+/**
+ * Running discovery query, nullptr if none
+ */
+mdns_search_once_t * discovery = nullptr;
+
+/**
+ * millis() value when the running discovery has been started
+ */
+uint32_t discoveryStart;
+
+/**
+ * Start searching for a wiThrottle server on the configured port
+ */
+void startDiscovery(void)
+{
+  if(discovery != nullptr)
+  {
+    mdns_query_async_delete(discovery);
+  }
+  log_d("Looking for automatic server.");
+  discoveryStart = millis();
+  discovery = mdns_query_async_new(nullptr, "_withrottle", "_tcp", MDNS_TYPE_PTR,
+                                   SERVER_QUERY_TIMEOUT_MS, SERVER_QUERY_MAX_RESULTS, nullptr);
+}
+
+/**
+ * Check if the search started by startDiscovery() has finished
+ *
+ * @returns true if finished, the server is in serverCache then
+ */
+bool pollDiscovery(void)
+{
+  mdns_result_t * results = nullptr;
+  uint8_t numResults = 0;
+
+  if(discovery != nullptr)
+  {
+    if(!mdns_query_async_get_results(discovery, 0, &results, &numResults))
+    {
+      return false;
+    }
+    mdns_query_async_delete(discovery);
+    discovery = nullptr;
+  }
+
+  serverCache.valid = false;
+  for(mdns_result_t * r = results; r != nullptr && !serverCache.valid; r = r->next)
+  {
+    for(mdns_ip_addr_t * a = r->addr; a != nullptr; a = a->next)
+    {
+      if(a->addr.type != ESP_IPADDR_TYPE_V4)
+      {
+        continue;
+      }
+      IPAddress ip(a->addr.u_addr.ip4.addr);
+      log_d("Hostname: %s IP: %s Port: %u", r->hostname != nullptr ? r->hostname : "", ip.toString().c_str(), r->port);
+      if(r->port == locoServer.port)
+      {
+        strncpy(serverCache.hostname, r->hostname != nullptr ? r->hostname : ip.toString().c_str(), SERVER_HOSTNAME_LENGTH - 1);
+        serverCache.hostname[SERVER_HOSTNAME_LENGTH - 1] = '\0';
+        serverCache.ip = ip;
+        serverCache.guessed = false;
+        serverCache.valid = true;
+      }
+      break;
+    }
+  }
+  if(results == nullptr)
+  {
+    serverCache.ip = WiFi.localIP();
+    IPAddress netmask = WiFi.subnetMask();
+    for(uint32_t i=0; i<=3; i++)
+    {
+      serverCache.ip[i] &= netmask[i];
+    }
+    serverCache.ip[3] += 1;
+    strncpy(serverCache.hostname, serverCache.ip.toString().c_str(), SERVER_HOSTNAME_LENGTH - 1);
+    serverCache.hostname[SERVER_HOSTNAME_LENGTH - 1] = '\0';
+    serverCache.guessed = true;
+    serverCache.valid = true;
+    log_d("No MDNS-announced wiThrottle server found. Trying LNWI/DCCEX at %s.", serverCache.hostname);
+  }
+  mdns_query_results_free(results);
+
+  discoveryStats.discoveries++;
+  discoveryStats.lastDiscoveryTime = millis() - discoveryStart;
+  log_d("Server discovery took %u ms", discoveryStats.lastDiscoveryTime);
+
+  if(serverCache.valid)
+  {
+    uint8_t * bssid = WiFi.BSSID();
+    strncpy(serverCache.ssid, WiFi.SSID().c_str(), sizeof(serverCache.ssid) - 1);
+    serverCache.ssid[sizeof(serverCache.ssid) - 1] = '\0';
+    if(bssid != nullptr)
+    {
+      memcpy(serverCache.bssid, bssid, sizeof(serverCache.bssid));
+    }
+    serverCache.port = locoServer.port;
+    serverCache.failures = 0;
+    serverCache.lastSeen = millis();
+    serverCache.lastChecked = millis();
+    saveServerCache();
+  }
+  return true;
+}
+
+/**
+ * Report a successful connect to the cached server
+ *
+ * @param connectTime time taken by the TCP connect in ms
+ */
+void serverConnected(uint32_t connectTime)
+{
+  discoveryStats.cacheConnects++;
+  discoveryStats.lastConnectTime = connectTime;
+  serverCache.failures = 0;
+  serverCache.lastSeen = millis();
+  log_d("Connected to %s in %u ms", serverCache.hostname, connectTime);
+}
+
+/**
+ * Report a failed connect to the cached server, drops the cache after SERVER_CACHE_MAX_FAILURES
+ */
+void serverConnectFailed(void)
+{
+  discoveryStats.connectFailures++;
+  if(++serverCache.failures >= SERVER_CACHE_MAX_FAILURES)
+  {
+    log_d("Server %s failed %u times, resetting server info.", serverCache.hostname, serverCache.failures);
+    forgetServer();
+  }
+  else
+  {
+    // maybe the server has just moved, check in the background
+    serverCache.lastChecked = millis() - SERVER_REVALIDATE_INTERVAL_MS;
+  }
+}
+
+/**
+ * Drop the cached server, i.e. when switching to a manually configured server
+ */
+void forgetServer(void)
+{
+  if(serverCache.valid)
+  {
+    serverCache.valid = false;
+    saveServerCache();
+  }
+}
+
+/**
+ * @returns true if the cached server has been found in the network (SSID and
+ *          access point) the station is connected to now
+ */
+bool serverCacheMatchesNetwork(void)
+{
+  uint8_t * bssid = WiFi.BSSID();
+  return bssid != nullptr && !memcmp(serverCache.bssid, bssid, sizeof(serverCache.bssid))
+         && WiFi.SSID() == serverCache.ssid;
+}
+
+/**
+ * @returns true and the first IPv4 address of an mDNS result in ip if it has one
+ */
+static bool firstIPv4(mdns_result_t * r, IPAddress & ip)
+{
+  for(mdns_ip_addr_t * a = r->addr; a != nullptr; a = a->next)
+  {
+    if(a->addr.type == ESP_IPADDR_TYPE_V4)
+    {
+      ip = IPAddress(a->addr.u_addr.ip4.addr);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Check in the background if the cached server is still announced at the same address
+ */
+void handleServerDiscovery(void)
+{
+  if(revalidation == nullptr)
+  {
+    if(locoServer.automatic && serverCache.valid
+       && (wiFredState == STATE_CONNECTED || wiFredState == STATE_LOCO_ONLINE)
+       && millis() - serverCache.lastChecked >= SERVER_REVALIDATE_INTERVAL_MS)
+    {
+      serverCache.lastChecked = millis();
+      revalidation = mdns_query_async_new(nullptr, "_withrottle", "_tcp", MDNS_TYPE_PTR,
+                                          SERVER_QUERY_TIMEOUT_MS, SERVER_QUERY_MAX_RESULTS, nullptr);
+      discoveryStats.revalidations++;
+    }
+    return;
+  }
+
+  mdns_result_t * results = nullptr;
+  uint8_t numResults = 0;
+  if(!mdns_query_async_get_results(revalidation, 0, &results, &numResults))
+  {
+    return;
+  }
+  mdns_query_async_delete(revalidation);
+  revalidation = nullptr;
+
+  if(!serverCache.valid)
+  {
+    mdns_query_results_free(results);
+    return;
+  }
+
+  // other wiThrottle servers (a second JMRI, an LNWI) may answer first, so the
+  // cached server is looked up by host name (or by address while guessed)
+  mdns_result_t * found = nullptr;
+  IPAddress foundIP;
+  mdns_result_t * candidate = nullptr;
+  IPAddress candidateIP;
+  uint8_t candidates = 0;
+  for(mdns_result_t * r = results; r != nullptr; r = r->next)
+  {
+    IPAddress ip;
+    if(r->port != locoServer.port || !firstIPv4(r, ip))
+    {
+      continue;
+    }
+    if(r->hostname != nullptr && !serverCache.guessed && !strcasecmp(r->hostname, serverCache.hostname))
+    {
+      found = r;
+      foundIP = ip;
+      break;
+    }
+    if(serverCache.guessed && ip == serverCache.ip)
+    {
+      found = r;
+      foundIP = ip;
+    }
+    candidate = r;
+    candidateIP = ip;
+    candidates++;
+  }
+
+  // only a single remaining server can be told apart from the cached one having left
+  if(found == nullptr && candidates == 1)
+  {
+    found = candidate;
+    foundIP = candidateIP;
+  }
+  else if(found == nullptr)
+  {
+    log_d("Server %s not announced, %u other servers", serverCache.hostname, candidates);
+  }
+
+  if(found != nullptr)
+  {
+    serverCache.lastSeen = millis();
+    // a guessed LNWI/DCCEX address is confirmed (and can be saved) once announced
+    if(foundIP != serverCache.ip || serverCache.guessed)
+    {
+      if(foundIP != serverCache.ip)
+      {
+        log_d("Server moved from %s to %s", serverCache.ip.toString().c_str(), foundIP.toString().c_str());
+        discoveryStats.serverMoved++;
+      }
+      serverCache.ip = foundIP;
+      serverCache.guessed = false;
+      if(found->hostname != nullptr)
+      {
+        strncpy(serverCache.hostname, found->hostname, SERVER_HOSTNAME_LENGTH - 1);
+        serverCache.hostname[SERVER_HOSTNAME_LENGTH - 1] = '\0';
+      }
+      serverCache.failures = 0;
+      saveServerCache();
+    }
+  }
+
+  mdns_query_results_free(results);
+}
@@ -0,0 +1,126 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file finds the wiThrottle server through mDNS and keeps the result
+ * in a persistent cache, so reconnects can skip the discovery.
+ */
+
+#ifndef _SERVER_DISCOVERY_H_
+#define _SERVER_DISCOVERY_H_
+
+#include <stdint.h>
+#include <IPAddress.h>
+
+/**
+ * Number of failed connects to the cached server before the cache is dropped
+ * and the server is searched for again
+ */
+#define SERVER_CACHE_MAX_FAILURES 3
+
+/**
+ * Interval for checking in the background if the cached server is still announced
+ */
+#define SERVER_REVALIDATE_INTERVAL_MS (5 * 60 * 1000)
+
+/**
+ * Time to wait for answers to an mDNS query
+ */
+#define SERVER_QUERY_TIMEOUT_MS 3000
+
+/**
+ * Maximum number of servers collected by an mDNS query
+ */
+#define SERVER_QUERY_MAX_RESULTS 8
+
+#define SERVER_HOSTNAME_LENGTH 64
+
+/**
+ * The wiThrottle server found through mDNS (or the LNWI/DCCEX default address)
+ */
+typedef struct
+{
+  bool valid = false;
+  char hostname[SERVER_HOSTNAME_LENGTH];
+  IPAddress ip;
+  uint16_t port;
+  uint32_t lastSeen;        // millis() of the last successful connect or mDNS answer
+  uint32_t lastChecked;     // millis() of the last background query
+  uint8_t failures;         // failed connects since the last successful one
+  char ssid[33];            // network the server has been found in
+  uint8_t bssid[6];
+  bool guessed;             // LNWI/DCCEX default address, not found through mDNS (not saved)
+} serverCacheInfo;
+
+extern serverCacheInfo serverCache;
+
+/**
+ * Time spent finding and connecting to the server
+ */
+typedef struct
+{
+  uint32_t discoveries;       // mDNS queries without a cached server
+  uint32_t lastDiscoveryTime; // ms
+  uint32_t cacheConnects;     // successful connects using the cached server
+  uint32_t connectFailures;
+  uint32_t lastConnectTime;   // ms
+  uint32_t revalidations;     // background mDNS queries
+  uint32_t serverMoved;       // background queries which found a new address
+} serverDiscoveryStatistics;
+
+extern serverDiscoveryStatistics discoveryStats;
+
+/**
+ * Start searching for a wiThrottle server on the configured port
+ */
+void startDiscovery(void);
+
+/**
+ * Check if the search started by startDiscovery() has finished
+ *
+ * @returns true if finished, the server is in serverCache then
+ */
+bool pollDiscovery(void);
+
+/**
+ * Report a successful connect to the cached server
+ *
+ * @param connectTime time taken by the TCP connect in ms
+ */
+void serverConnected(uint32_t connectTime);
+
+/**
+ * Report a failed connect to the cached server, drops the cache after SERVER_CACHE_MAX_FAILURES
+ */
+void serverConnectFailed(void);
+
+/**
+ * Drop the cached server, i.e. when switching to a manually configured server
+ */
+void forgetServer(void);
+
+/**
+ * @returns true if the cached server has been found in the network (SSID and
+ *          access point) the station is connected to now
+ */
+bool serverCacheMatchesNetwork(void);
+
+/**
+ * Check in the background if the cached server is still announced at the same address
+ */
+void handleServerDiscovery(void);
+
+#endif
@@ -0,0 +1,234 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file contains the filter chain for the speed potentiometer: a median
+ * filter against single outliers, an exponential (IIR) low pass against noise
+ * and hysteresis binning to the speed steps of the loco, as well as the
+ * conversion between speed values and decoder speed steps. It does not access
+ * the hardware.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "speedFilter.h"
+
+speedFilterConfig speedFilter = { SPEED_MEDIAN_DEFAULT, SPEED_IIR_SHIFT_DEFAULT, SPEED_BINNING_DEFAULT };
+
+/**
+ * Last raw values for the median filter (ring buffer) and number of values stored
+ */
+uint16_t medianHistory[SPEED_MEDIAN_MAX];
+uint8_t medianCount = 0;
+uint8_t medianIndex = 0;
+
+/**
+ * IIR filter state (value << 4), -1 if not initialized
+ */
+int32_t iirState = -1;
+
+/**
+ * Current speed step of the binning filter
+ */
+uint8_t currentBin = 0;
+
+/**
+ * Run the median and IIR filters on a raw potentiometer value
+ *
+ * @param raw raw A/D converter value
+ * @returns filtered A/D converter value
+ */
+uint16_t filterPoti(uint16_t raw)
+{
+  uint16_t value = raw;
+
+  if(speedFilter.medianLength > 1)
+  {
+    uint8_t length = speedFilter.medianLength > SPEED_MEDIAN_MAX ? SPEED_MEDIAN_MAX : speedFilter.medianLength;
+
+    medianHistory[medianIndex] = raw;
+    medianIndex = (medianIndex + 1) % length;
+    if(medianCount < length)
+    {
+      medianCount++;
+    }
+
+    // insertion sort of a copy, at most SPEED_MEDIAN_MAX values
+    uint16_t sorted[SPEED_MEDIAN_MAX];
+    for(uint8_t i = 0; i < medianCount; i++)
+    {
+      uint16_t v = medianHistory[i];
+      uint8_t j = i;
+      while(j > 0 && sorted[j - 1] > v)
+      {
+        sorted[j] = sorted[j - 1];
+        j--;
+      }
+      sorted[j] = v;
+    }
+    value = sorted[medianCount / 2];
+  }
+
+  if(speedFilter.iirShift > 0)
+  {
+    uint8_t shift = speedFilter.iirShift > SPEED_IIR_SHIFT_MAX ? SPEED_IIR_SHIFT_MAX : speedFilter.iirShift;
+
+    if(iirState < 0)
+    {
+      iirState = (int32_t) value << 4;
+    }
+    else
+    {
+      iirState += (((int32_t) value << 4) - iirState) >> shift;
+    }
+    value = (iirState + 8) >> 4;
+  }
+
+  return value;
+}
+
+/**
+ * Bin a speed value to the nearest of the given number of speed steps,
+ * keeping the current step until the value has moved well past its boundary
+ *
+ * @param speed speed value (0..253)
+ * @param steps number of speed steps of the loco (i.e. 14, 28 or 126)
+ * @returns speed value (0..253) for the selected step
+ */
+uint8_t binSpeed(uint8_t speed, uint8_t steps)
+{
+  if(steps == 0)
+  {
+    return speed;
+  }
+  if(currentBin > steps)
+  {
+    currentBin = steps;
+  }
+
+  // work in units of 1/253 step: the current step is centered at currentBin * 253,
+  // its boundaries are half a step (126) away
+  int32_t scaled = (int32_t) speed * steps;
+  int32_t distance = scaled - (int32_t) currentBin * 253;
+  if(distance < 0)
+  {
+    distance = -distance;
+  }
+  if(distance > 126 + 253 / SPEED_BIN_HYSTERESIS)
+  {
+    currentBin = (scaled + 126) / 253;
+  }
+
+  // always reach the end positions
+  if(speed == 0 || speed == 253)
+  {
+    currentBin = speed == 0 ? 0 : steps;
+  }
+
+  return (uint32_t) currentBin * 253 / steps;
+}
+
+/**
+ * Forget the filter history, i.e. after changing the settings
+ */
+void resetSpeedFilter(void)
+{
+  medianCount = medianIndex = 0;
+  iirState = -1;
+}
+
+/**
+ * Number of speed steps of a speed step mode reported by the server
+ *
+ * @param speedStepMode see jmri.SpeedStepMode (1, 2, 4, 8, 16)
+ * @returns number of speed steps, 0 if not known
+ */
+uint8_t speedStepModeSteps(uint8_t speedStepMode)
+{
+  switch(speedStepMode)
+  {
+    case 1:
+      return 126;
+    case 2:
+    case 16:
+      return 28;
+    case 4:
+      return 27;
+    case 8:
+      return 14;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * Number of speed steps of a configured speed step mode
+ *
+ * @param mode value from MODES (i.e. "28", "motorola_28" or "2")
+ * @returns number of speed steps, 0 if not known or not set
+ */
+uint8_t configuredModeSteps(const char * mode)
+{
+  // names from jmri.jmrit.withrottle.ThrottleController#decodeSpeedStepMode()
+  if(!strcmp(mode, "128"))
+  {
+    return 126;
+  }
+  if(!strcmp(mode, "28") || !strcmp(mode, "motorola_28"))
+  {
+    return 28;
+  }
+  if(!strcmp(mode, "27"))
+  {
+    return 27;
+  }
+  if(!strcmp(mode, "14"))
+  {
+    return 14;
+  }
+  if(!strcmp(mode, "tmcc_32"))
+  {
+    return 32;
+  }
+  // numbers from jmri.SpeedStepMode, "" and "incremental" give 0
+  return speedStepModeSteps(atoi(mode));
+}
+
+/**
+ * Decoder speed step for a speed value
+ *
+ * @param speed speed value 0..126
+ * @param steps number of speed steps of the decoder
+ * @returns speed step 0..steps
+ */
+uint8_t speedToStep(uint8_t speed, uint8_t steps)
+{
+  if(speed == 0)
+  {
+    return 0;
+  }
+  uint8_t step = ((uint32_t) speed * steps + 63) / 126;
+  return step < 1 ? 1 : step;
+}
+
+/**
+ * Speed value in the middle of a speed step
+ */
+uint8_t stepToSpeed(uint8_t step, uint8_t steps)
+{
+  return ((uint32_t) step * 126 + steps / 2) / steps;
+}
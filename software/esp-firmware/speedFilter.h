@@ -0,0 +1,118 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file contains the filter chain for the speed potentiometer: a median
+ * filter against single outliers, an exponential (IIR) low pass against noise
+ * and hysteresis binning to the speed steps of the loco, as well as the
+ * conversion between speed values and decoder speed steps. It does not access
+ * the hardware.
+ */
+
+#ifndef _SPEED_FILTER_H_
+#define _SPEED_FILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Longest median filter (in A/D converter blocks)
+ */
+#define SPEED_MEDIAN_MAX 7
+
+/**
+ * Largest IIR shift, the filter takes 1/2^shift of each new value
+ */
+#define SPEED_IIR_SHIFT_MAX 4
+
+/**
+ * Hysteresis around a speed step boundary in 1/n of a step
+ */
+#define SPEED_BIN_HYSTERESIS 4
+
+/**
+ * Default filter settings
+ */
+#define SPEED_MEDIAN_DEFAULT 3
+#define SPEED_IIR_SHIFT_DEFAULT 0
+#define SPEED_BINNING_DEFAULT true
+
+/**
+ * Filter settings (configurable)
+ */
+typedef struct
+{
+  uint8_t medianLength; // 1 (off), 3, 5 or 7
+  uint8_t iirShift;     // 0 (off) to SPEED_IIR_SHIFT_MAX
+  bool binning;         // bin the speed to the speed steps of the loco
+} speedFilterConfig;
+
+extern speedFilterConfig speedFilter;
+
+/**
+ * Run the median and IIR filters on a raw potentiometer value
+ *
+ * @param raw raw A/D converter value
+ * @returns filtered A/D converter value
+ */
+uint16_t filterPoti(uint16_t raw);
+
+/**
+ * Bin a speed value to the nearest of the given number of speed steps,
+ * keeping the current step until the value has moved well past its boundary
+ *
+ * @param speed speed value (0..253)
+ * @param steps number of speed steps of the loco (i.e. 14, 28 or 126)
+ * @returns speed value (0..253) for the selected step
+ */
+uint8_t binSpeed(uint8_t speed, uint8_t steps);
+
+/**
+ * Forget the filter history, i.e. after changing the settings
+ */
+void resetSpeedFilter(void);
+
+/**
+ * Number of speed steps of a speed step mode reported by the server
+ *
+ * @param speedStepMode see jmri.SpeedStepMode (1, 2, 4, 8, 16)
+ * @returns number of speed steps, 0 if not known
+ */
+uint8_t speedStepModeSteps(uint8_t speedStepMode);
+
+/**
+ * Number of speed steps of a configured speed step mode
+ *
+ * @param mode value from MODES (i.e. "28", "motorola_28" or "2")
+ * @returns number of speed steps, 0 if not known or not set
+ */
+uint8_t configuredModeSteps(const char * mode);
+
+/**
+ * Decoder speed step for a speed value
+ *
+ * @param speed speed value 0..126
+ * @param steps number of speed steps of the decoder
+ * @returns speed step 0..steps
+ */
+uint8_t speedToStep(uint8_t speed, uint8_t steps);
+
+/**
+ * Speed value in the middle of a speed step
+ */
+uint8_t stepToSpeed(uint8_t step, uint8_t steps);
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides a lock-free queue to pass data from exactly one
+ * producer task (i.e. the Ticker callbacks) to exactly one consumer task
+ * (the main loop).
+ */
+
+#ifndef _SPSC_QUEUE_H_
+#define _SPSC_QUEUE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+/**
+ * Single producer, single consumer ring buffer
+ *
+ * push() may only be called from one task, pop() only from one (other) task.
+ * Neither blocks, a full queue drops the new entry and counts it in dropped.
+ *
+ * @tparam T  entry type, copied in and out
+ * @tparam N  number of entries, must be a power of two
+ */
+template<typename T, size_t N>
+class spscQueue
+{
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "spscQueue size must be a power of two");
+
+  public:
+    /**
+     * Add an entry (producer side)
+     *
+     * @returns false if the queue is full and the entry has been dropped
+     */
+    bool push(const T & entry)
+    {
+      size_t head = _head.load(std::memory_order_relaxed);
+      if(head - _tail.load(std::memory_order_acquire) >= N)
+      {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      _buffer[head & (N - 1)] = entry;
+      _head.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * Remove the oldest entry (consumer side)
+     *
+     * @returns false if the queue is empty
+     */
+    bool pop(T & entry)
+    {
+      size_t tail = _tail.load(std::memory_order_relaxed);
+      if(tail == _head.load(std::memory_order_acquire))
+      {
+        return false;
+      }
+      entry = _buffer[tail & (N - 1)];
+      _tail.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * Number of entries dropped because the queue was full
+     */
+    std::atomic<uint32_t> dropped { 0 };
+
+  private:
+    T _buffer[N];
+    std::atomic<size_t> _head { 0 };
+    std::atomic<size_t> _tail { 0 };
+};
+
+#endif
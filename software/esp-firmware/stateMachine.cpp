@@ -0,0 +1,112 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file runs the global state machine described by stateTable and
+ * records how long the wiFred stays in each state.
+ */
+
+#include <Arduino.h>
+
+#include "stateMachine.h"
+#include "throttleHandling.h"
+
+/**
+ * The wiFred starts in STATE_STARTUP without calling switchState()
+ */
+stateStatistics stateStats[NUM_STATES] = { { 1, 0, 0 } };
+
+uint16_t stateTransitions[NUM_STATES][NUM_STATES];
+
+uint32_t stateEntered = 0;
+
+/**
+ * Switch to a new state, start its timeout and run its entry action
+ *
+ * The entry action is run last, so it may switch to yet another state.
+ */
+void switchState(state newState)
+{
+  uint32_t now = millis();
+  state oldState = wiFredState;
+
+  log_d("State %s -> %s after %u ms (%u ms since boot)",
+        getStateName(oldState), getStateName(newState), now - stateEntered, now);
+
+  stateStats[oldState].totalTime += now - stateEntered;
+  if(stateTransitions[oldState][newState] < UINT16_MAX)
+  {
+    stateTransitions[oldState][newState]++;
+  }
+  if(stateStats[newState].entries == 0)
+  {
+    stateStats[newState].firstEntered = now;
+  }
+  stateStats[newState].entries++;
+  stateEntered = now;
+
+  wiFredState = newState;
+  if(stateTable[newState].timeout == NO_TIMEOUT)
+  {
+    stateTimeout = NO_TIMEOUT;
+  }
+  else
+  {
+    stateTimeout = now + stateTable[newState].timeout;
+  }
+
+  if(stateTable[newState].onEntry != nullptr)
+  {
+    stateTable[newState].onEntry();
+  }
+}
+
+/**
+ * Show the LED pattern of the current state and run its handler
+ */
+void runStateMachine(void)
+{
+  const stateInfo & s = stateTable[wiFredState];
+
+  switch(s.leds)
+  {
+    case LEDS_FIXED:
+      setLEDvalues(s.ledFwd, s.ledRev, s.ledStop);
+      break;
+    case LEDS_VOLTAGE_IF_OFF:
+      showVoltageIfOff(s.ledFwd, s.ledRev, s.ledStop);
+      break;
+    case LEDS_VOLTAGE:
+      showVoltage();
+      break;
+    case LEDS_UNCHANGED:
+      break;
+  }
+
+  s.handler();
+}
+
+/**
+ * @returns the name of the given state
+ */
+const char * getStateName(state s)
+{
+  if(s >= NUM_STATES)
+  {
+    return "unknown";
+  }
+  return stateTable[s].name;
+}
@@ -26,12 +26,103 @@
 enum state { STATE_STARTUP, STATE_CONNECTING, STATE_CONNECTED,
              STATE_LOCO_CONNECTING, STATE_LOCO_WAITFORTIMEOUT, STATE_LOCO_ONLINE, STATE_LOCOS_OFF,
              STATE_CONFIG_AP, STATE_CONFIG_STATION_WAITING, STATE_CONFIG_STATION, STATE_LOWPOWER_WAITING, STATE_LOWPOWER,
-             STATE_WAIT_ON_RED_KEY, STATE_WAIT_ON_YELLOW_KEY, STATE_WAIT_ON_F0_KEY };
+             STATE_WAIT_ON_RED_KEY, STATE_WAIT_ON_YELLOW_KEY, STATE_WAIT_ON_F0_KEY,
+             NUM_STATES };
 
 #define WAIT_ON_KEY_TIMEOUT 5000
 
+/**
+ * Marker for states without a timeout
+ */
+#define NO_TIMEOUT UINT32_MAX
+
+/**
+ * What the LEDs show while in a state
+ */
+enum ledMode { LEDS_UNCHANGED, LEDS_FIXED, LEDS_VOLTAGE_IF_OFF, LEDS_VOLTAGE };
+
+/**
+ * Static description of one state of the global state machine
+ */
+typedef struct
+{
+  /**
+   * Name for debug output and the state statistics page
+   */
+  const char * name;
+  /**
+   * Called once per main loop pass while in this state
+   */
+  void (*handler)(void);
+  /**
+   * Called once when entering this state (may be nullptr)
+   */
+  void (*onEntry)(void);
+  /**
+   * Default time before the state times out in ms (NO_TIMEOUT for none)
+   */
+  uint32_t timeout;
+  /**
+   * LED pattern shown while in this state
+   */
+  ledMode leds;
+  const char * ledFwd;
+  const char * ledRev;
+  const char * ledStop;
+} stateInfo;
+
+/**
+ * Time and transition statistics of one state
+ */
+typedef struct
+{
+  /**
+   * Number of times this state has been entered
+   */
+  uint32_t entries;
+  /**
+   * Total time spent in this state in ms (not including the current stay)
+   */
+  uint32_t totalTime;
+  /**
+   * millis() value at the first entry (only valid if entries > 0)
+   */
+  uint32_t firstEntered;
+} stateStatistics;
+
+/**
+ * Description of all states, indexed by state
+ */
+extern const stateInfo stateTable[NUM_STATES];
+
+extern stateStatistics stateStats[NUM_STATES];
+
+/**
+ * Number of transitions from state [i] to state [j]
+ */
+extern uint16_t stateTransitions[NUM_STATES][NUM_STATES];
+
+/**
+ * millis() value when the current state has been entered
+ */
+extern uint32_t stateEntered;
+
 extern state wiFredState;
+extern uint32_t stateTimeout;
 
-void switchState(state newState, uint32_t timeout = UINT32_MAX);
+/**
+ * Switch to a new state, start its timeout and run its entry action
+ */
+void switchState(state newState);
+
+/**
+ * Show the LED pattern of the current state and run its handler
+ */
+void runStateMachine(void);
+
+/**
+ * @returns the name of the given state
+ */
+const char * getStateName(state s);
 
 #endif
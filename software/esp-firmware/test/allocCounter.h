@@ -0,0 +1,136 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file counts heap use of a test executable: operator new and the C
+ * allocation functions are replaced by counting versions (the fake String
+ * allocates through realloc(), like the Arduino one). Include it in exactly
+ * one source file of a test.
+ */
+
+#ifndef _ALLOC_COUNTER_H_
+#define _ALLOC_COUNTER_H_
+
+#include <stdlib.h>
+#include <malloc.h>
+#include <new>
+
+extern "C"
+{
+  void * __libc_malloc(size_t size);
+  void * __libc_calloc(size_t count, size_t size);
+  void * __libc_realloc(void * ptr, size_t size);
+  void __libc_free(void * ptr);
+}
+
+/**
+ * Allocations (including reallocations) and heap bytes in use since the
+ * last resetAllocations(), peakBytes is the highest value of currentBytes
+ */
+static size_t allocations = 0;
+static long currentBytes = 0;
+static long peakBytes = 0;
+static bool counting = false;
+
+static inline void resetAllocations(void)
+{
+  allocations = 0;
+  currentBytes = 0;
+  peakBytes = 0;
+  counting = true;
+}
+
+static inline void countAllocation(void * ptr, long oldBytes)
+{
+  if(!counting || ptr == nullptr)
+  {
+    return;
+  }
+  allocations++;
+  currentBytes += malloc_usable_size(ptr) - oldBytes;
+  if(currentBytes > peakBytes)
+  {
+    peakBytes = currentBytes;
+  }
+}
+
+extern "C" void * malloc(size_t size)
+{
+  void * ptr = __libc_malloc(size);
+  countAllocation(ptr, 0);
+  return ptr;
+}
+
+extern "C" void * calloc(size_t count, size_t size)
+{
+  void * ptr = __libc_calloc(count, size);
+  countAllocation(ptr, 0);
+  return ptr;
+}
+
+extern "C" void * realloc(void * ptr, size_t size)
+{
+  long oldBytes = ptr != nullptr ? malloc_usable_size(ptr) : 0;
+  void * result = __libc_realloc(ptr, size);
+  countAllocation(result, oldBytes);
+  return result;
+}
+
+extern "C" void free(void * ptr)
+{
+  if(counting && ptr != nullptr)
+  {
+    currentBytes -= malloc_usable_size(ptr);
+  }
+  __libc_free(ptr);
+}
+
+void * operator new(size_t size)
+{
+  void * ptr = malloc(size);
+  if(ptr == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void * operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void * ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete(void * ptr, size_t size) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void * ptr, size_t size) noexcept
+{
+  free(ptr);
+}
+
+#endif
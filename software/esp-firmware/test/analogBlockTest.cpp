@@ -0,0 +1,207 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file feeds the speed knob traces in traces/ block by block into the
+ * A/D converter processing, without any hardware or timing, and checks the
+ * speed, battery and calibration updates it makes.
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+
+#include "hardware.h"
+#include "knobTrace.h"
+#include "lowbat.h"
+#include "throttleHandling.h"
+#include "hostFakes.h"
+#include "testing.h"
+
+/**
+ * Time between two blocks of the continuous A/D conversion
+ */
+#define BLOCK_MS (2 * ADC_CONVERSIONS_PER_PIN * 1000 / ADC_SAMPLE_FREQ_HZ)
+
+#define BATTERY_OK_MV 1900
+
+extern volatile uint8_t newSpeed;
+extern bool saveAnalog;
+
+/**
+ * What processAnalogBlock() passed on to the main loop state
+ */
+typedef struct
+{
+  uint32_t speedChanges;
+  int32_t lastSpeed;       // speed as passed to setSpeed(), -1 if unchanged
+  uint32_t batteryChanges;
+  uint16_t lastBattery;
+  uint32_t calibrations;
+} blockEvents;
+
+/**
+ * Process one block and add what changed to events
+ */
+static void processBlock(uint16_t potiRaw, uint16_t battMilliVolts, blockEvents & events)
+{
+  uint8_t speed = newSpeed;
+  uint16_t battery = batteryVoltage;
+  saveAnalog = false;
+  processAnalogBlock(potiRaw, battMilliVolts);
+  if(newSpeed != speed)
+  {
+    events.speedChanges++;
+    events.lastSpeed = newSpeed;
+  }
+  if(batteryVoltage != battery)
+  {
+    events.batteryChanges++;
+    events.lastBattery = batteryVoltage;
+  }
+  if(saveAnalog)
+  {
+    events.calibrations++;
+  }
+}
+
+/**
+ * Feed a number of blocks with the same values
+ */
+static blockEvents feed(uint16_t potiRaw, uint16_t battMilliVolts, int blocks)
+{
+  blockEvents events = { 0, -1, 0, 0, 0 };
+  for(int i = 0; i < blocks; i++)
+  {
+    processBlock(potiRaw, battMilliVolts, events);
+  }
+  return events;
+}
+
+static uint8_t knobSpeed(uint16_t raw)
+{
+  return map(raw, potiMin, potiMax, 253, 0) / 2;
+}
+
+TEST(stoppedKnobAndSteadyBatteryCauseNoEvents)
+{
+  potiMin = 100;
+  potiMax = 4000;
+  blockEvents events = feed(4000, BATTERY_OK_MV, 10);
+  CHECK_EQUAL(0, events.speedChanges);
+  CHECK_EQUAL(1, events.batteryChanges);
+  CHECK_EQUAL(BATTERY_OK_MV * 2, events.lastBattery);
+
+  events = feed(4000, BATTERY_OK_MV, 100);
+  CHECK_EQUAL(0, events.speedChanges);
+  CHECK_EQUAL(0, events.batteryChanges);
+  CHECK_EQUAL(0, events.calibrations);
+}
+
+TEST(singleBlockOutliersAreFiltered)
+{
+  blockEvents events = { 0, -1, 0, 0, 0 };
+  for(int i = 0; i < 50; i++)
+  {
+    processBlock(i % 10 == 5 ? 2000 : 4000, BATTERY_OK_MV, events);
+  }
+  CHECK_EQUAL(0, events.speedChanges);
+}
+
+TEST(tracesEndAtTheFinalKnobPosition)
+{
+  for(const char * name : KNOB_TRACES)
+  {
+    std::vector<traceSample> trace = readTrace(name);
+    CHECK(!trace.empty());
+    std::vector<uint16_t> blocks = traceBlocks(trace, BLOCK_MS);
+
+    feed(4000, BATTERY_OK_MV, 10);
+    blockEvents events = { 0, -1, 0, 0, 0 };
+    for(uint16_t block : blocks)
+    {
+      processBlock(block, BATTERY_OK_MV, events);
+    }
+
+    feed(4000, BATTERY_OK_MV, 10);
+    auto start = std::chrono::steady_clock::now();
+    for(uint16_t block : blocks)
+    {
+      processAnalogBlock(block, BATTERY_OK_MV);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    uint8_t expected = knobSpeed(finalRaw(trace));
+    CHECK(events.lastSpeed >= 0 || expected <= 1);
+    if(events.lastSpeed >= 0)
+    {
+      CHECK(abs(events.lastSpeed - expected) <= 2);
+    }
+    double seconds = (trace.back().ms + 10) / 1000.0;
+    std::string prefix = name;
+    report((prefix + "Blocks").c_str(), blocks.size(), "blocks");
+    report((prefix + "SpeedChanges").c_str(), events.speedChanges, "changes");
+    report((prefix + "BlocksPerSecond").c_str(), blocks.size() / seconds, "1/s");
+    report((prefix + "NsPerBlock").c_str(), ns / blocks.size(), "ns");
+  }
+}
+
+TEST(batteryLevelsAreReported)
+{
+  feed(4000, BATTERY_OK_MV, 1);
+  blockEvents events = feed(4000, LOW_BATTERY_THRESHOLD / 2 - 10, 1);
+  CHECK_EQUAL(1, events.batteryChanges);
+  CHECK(events.lastBattery < LOW_BATTERY_THRESHOLD);
+  CHECK(events.lastBattery >= EMPTY_BATTERY_THRESHOLD);
+
+  events = feed(4000, EMPTY_BATTERY_THRESHOLD / 2 - 10, 1);
+  CHECK(events.lastBattery < EMPTY_BATTERY_THRESHOLD);
+
+  // readings above 4.2 V correct the battery factor
+  float factor = battFactor;
+  events = feed(4000, 2200, 1);
+  CHECK_EQUAL(4200, events.lastBattery);
+  CHECK_EQUAL(1, events.calibrations);
+  CHECK(battFactor < factor);
+  battFactor = factor;
+  feed(4000, BATTERY_OK_MV, 1);
+}
+
+TEST(knobBeyondTheLimitsRecalibrates)
+{
+  // below potiMin for NUM_OVERSHOOT blocks moves the full speed end
+  blockEvents events = feed(50, BATTERY_OK_MV, NUM_OVERSHOOT + 2);
+  CHECK_EQUAL(126, events.lastSpeed);
+  CHECK(events.calibrations >= 1);
+  CHECK_EQUAL(50, potiMin);
+
+  // beyond potiMax moves the stop end
+  events = feed(4090, BATTERY_OK_MV, NUM_OVERSHOOT + 2);
+  CHECK_EQUAL(0, events.lastSpeed);
+  CHECK(events.calibrations >= 1);
+  CHECK_EQUAL(4090, potiMax);
+
+  // short excursions do not
+  feed(2000, BATTERY_OK_MV, 10);
+  events = feed(4095, BATTERY_OK_MV, NUM_OVERSHOOT - 4);
+  CHECK_EQUAL(0, events.calibrations);
+  CHECK_EQUAL(4090, potiMax);
+}
+
+int main(void)
+{
+  return runTests();
+}
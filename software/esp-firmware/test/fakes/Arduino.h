@@ -0,0 +1,123 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the Arduino core header. The clock,
+ * the GPIO pins and the A/D converter are simulated by fakeHardware.cpp and
+ * can be controlled by the tests through hostFakes.h.
+ */
+
+#ifndef _FAKE_ARDUINO_H_
+#define _FAKE_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "freertos/FreeRTOS.h"
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x01
+#define OUTPUT       0x03
+#define PULLUP       0x04
+#define INPUT_PULLUP 0x05
+
+#define ARDUINO_ISR_ATTR
+#define IRAM_ATTR
+#define PROGMEM
+
+/**
+ * Log output is dropped, the firmware passes String objects to it
+ */
+#define log_e(format, ...) do { } while(0)
+#define log_w(format, ...) do { } while(0)
+#define log_i(format, ...) do { } while(0)
+#define log_d(format, ...) do { } while(0)
+#define log_v(format, ...) do { } while(0)
+
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+#define constrain(amount, low, high) ((amount) < (low) ? (low) : ((amount) > (high) ? (high) : (amount)))
+
+/**
+ * Continuous A/D conversion (see esp32-hal-adc.h)
+ */
+typedef enum { ADC_0db, ADC_2_5db, ADC_6db, ADC_11db } adc_attenuation_t;
+
+typedef struct
+{
+  uint8_t pin;
+  uint8_t channel;
+  int avg_read_raw;
+  int avg_read_mvolts;
+} adc_continuous_data_t;
+
+bool analogContinuous(const uint8_t pins[], size_t pinsCount, uint32_t conversionsPerPin, uint32_t samplingFreqHz, void (*userFunc)(void));
+bool analogContinuousRead(adc_continuous_data_t ** buffer, uint32_t timeoutMs);
+bool analogContinuousStart(void);
+bool analogContinuousStop(void);
+bool analogContinuousDeinit(void);
+void analogContinuousSetAtten(adc_attenuation_t attenuation);
+
+class HardwareSerial : public Stream
+{
+  public:
+    void begin(unsigned long baud) {}
+    void setDebugOutput(bool enable) {}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+    int available(void) override { return 0; }
+    int read(void) override { return -1; }
+    int peek(void) override { return -1; }
+};
+
+extern HardwareSerial Serial;
+
+class EspClass
+{
+  public:
+    void restart(void);
+    void deepSleep(uint64_t timeUs);
+    uint32_t getFreeHeap(void);
+};
+
+extern EspClass ESP;
+
+#endif
@@ -0,0 +1,35 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for AsyncUDP, broadcasts are only
+ * counted (see hostFakes.h).
+ */
+
+#ifndef _FAKE_ASYNC_UDP_H_
+#define _FAKE_ASYNC_UDP_H_
+
+#include <stdint.h>
+#include <string.h>
+
+class AsyncUDP
+{
+  public:
+    size_t broadcastTo(uint8_t * data, size_t length, uint16_t port);
+    size_t broadcastTo(const char * data, uint16_t port) { return broadcastTo((uint8_t *) data, strlen(data), port); }
+};
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the captive portal DNS server, no
+ * requests ever arrive on the host.
+ */
+
+#ifndef _FAKE_DNS_SERVER_H_
+#define _FAKE_DNS_SERVER_H_
+
+#include "IPAddress.h"
+#include "WString.h"
+
+enum class DNSReplyCode
+{
+  NoError = 0,
+  FormError = 1,
+  ServerFailure = 2,
+  NonExistentDomain = 3,
+  NotImplemented = 4,
+  Refused = 5
+};
+
+class DNSServer
+{
+  public:
+    void processNextRequest(void) {}
+    void setErrorReplyCode(const DNSReplyCode & replyCode) { errorReplyCode = replyCode; }
+    bool start(const uint16_t port, const String & domainName, const IPAddress & resolvedIP) { return true; }
+    void stop(void) {}
+
+  private:
+    DNSReplyCode errorReplyCode = DNSReplyCode::NonExistentDomain;
+};
+
+#endif
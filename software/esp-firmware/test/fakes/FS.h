@@ -0,0 +1,77 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the Arduino file system API, files
+ * are kept in memory (see hostFakes.h).
+ */
+
+#ifndef _FAKE_FS_H_
+#define _FAKE_FS_H_
+
+#include <Arduino.h>
+#include <memory>
+
+namespace fs
+{
+
+struct fileHandle;
+
+class File : public Stream
+{
+  public:
+    File() {}
+    explicit File(std::shared_ptr<fileHandle> handle) : handle(handle) {}
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+    int available(void) override;
+    int read(void) override;
+    size_t read(uint8_t * buffer, size_t size);
+    int peek(void) override;
+    void flush(void) override {}
+    bool seek(uint32_t position);
+    size_t position(void) const;
+    size_t size(void) const;
+    const char * name(void) const;
+    void close(void) { handle.reset(); }
+    operator bool() const { return handle != nullptr; }
+
+  private:
+    std::shared_ptr<fileHandle> handle;
+};
+
+class FS
+{
+  public:
+    File open(const char * path, const char * mode = "r", const bool create = false);
+    File open(const String & path, const char * mode = "r", const bool create = false) { return open(path.c_str(), mode, create); }
+    bool exists(const char * path);
+    bool exists(const String & path) { return exists(path.c_str()); }
+    bool remove(const char * path);
+    bool remove(const String & path) { return remove(path.c_str()); }
+
+  protected:
+    bool mounted = false;
+};
+
+}
+
+using fs::FS;
+using fs::File;
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the Arduino IPAddress class (IPv4 only).
+ */
+
+#ifndef _FAKE_IP_ADDRESS_H_
+#define _FAKE_IP_ADDRESS_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "WString.h"
+
+class IPAddress
+{
+  public:
+    IPAddress(void) {}
+    IPAddress(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) : bytes { b0, b1, b2, b3 } {}
+
+    /**
+     * Address in network byte order, like in_addr.s_addr
+     */
+    IPAddress(uint32_t address) { memcpy(bytes, &address, sizeof(bytes)); }
+
+    operator uint32_t(void) const
+    {
+      uint32_t address;
+      memcpy(&address, bytes, sizeof(address));
+      return address;
+    }
+
+    bool operator==(const IPAddress & other) const { return memcmp(bytes, other.bytes, sizeof(bytes)) == 0; }
+    bool operator!=(const IPAddress & other) const { return !(*this == other); }
+    uint8_t operator[](int index) const { return bytes[index]; }
+    uint8_t & operator[](int index) { return bytes[index]; }
+
+    bool fromString(const char * address);
+    String toString(void) const;
+
+  private:
+    uint8_t bytes[4] = { 0, 0, 0, 0 };
+};
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the Print, Stream and IPAddress
+ * functions of the Arduino core.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+
+size_t Print::write(const uint8_t * buffer, size_t size)
+{
+  size_t n = 0;
+  while(size-- > 0 && write(*buffer++) == 1)
+  {
+    n++;
+  }
+  return n;
+}
+
+size_t Print::print(long value, int base)
+{
+  return print(String(value, (unsigned char) base));
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+  return print(String(value, (unsigned char) base));
+}
+
+size_t Print::print(double value, int digits)
+{
+  return print(String(value, (unsigned int) digits));
+}
+
+/**
+ * Same as the Arduino core: formats into a small stack buffer and only
+ * allocates a heap buffer for longer output
+ */
+size_t Print::printf(const char * format, ...)
+{
+  char small[64];
+  char * buffer = small;
+  va_list arg;
+
+  va_start(arg, format);
+  int length = vsnprintf(small, sizeof(small), format, arg);
+  va_end(arg);
+  if(length < 0)
+  {
+    return 0;
+  }
+  if((size_t) length >= sizeof(small))
+  {
+    buffer = (char *) malloc(length + 1);
+    if(buffer == nullptr)
+    {
+      return 0;
+    }
+    va_start(arg, format);
+    vsnprintf(buffer, length + 1, format, arg);
+    va_end(arg);
+  }
+  size_t written = write((const uint8_t *) buffer, length);
+  if(buffer != small)
+  {
+    free(buffer);
+  }
+  return written;
+}
+
+size_t Stream::readBytes(char * buffer, size_t length)
+{
+  size_t n = 0;
+  while(n < length)
+  {
+    int c = read();
+    if(c < 0)
+    {
+      break;
+    }
+    buffer[n++] = (char) c;
+  }
+  return n;
+}
+
+String Stream::readString(void)
+{
+  String result;
+  for(int c = read(); c >= 0; c = read())
+  {
+    result += (char) c;
+  }
+  return result;
+}
+
+String Stream::readStringUntil(char terminator)
+{
+  String result;
+  for(int c = read(); c >= 0 && c != terminator; c = read())
+  {
+    result += (char) c;
+  }
+  return result;
+}
+
+bool IPAddress::fromString(const char * address)
+{
+  unsigned int parts[4];
+  char end;
+  if(sscanf(address, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &end) != 4)
+  {
+    return false;
+  }
+  for(int i = 0; i < 4; i++)
+  {
+    if(parts[i] > 255)
+    {
+      return false;
+    }
+    bytes[i] = parts[i];
+  }
+  return true;
+}
+
+String IPAddress::toString(void) const
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+  return String(buffer);
+}
@@ -0,0 +1,62 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the Arduino Print class, the base of
+ * everything text can be written to.
+ */
+
+#ifndef _FAKE_PRINT_H_
+#define _FAKE_PRINT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+
+class Print
+{
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t * buffer, size_t size);
+    size_t write(const char * str) { return str != nullptr ? write((const uint8_t *) str, strlen(str)) : 0; }
+    size_t write(const char * buffer, size_t size) { return write((const uint8_t *) buffer, size); }
+
+    size_t print(const char * str) { return write(str); }
+    size_t print(const String & str) { return write(str.c_str(), str.length()); }
+    size_t print(char c) { return write((uint8_t) c); }
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long) value, base); }
+    size_t print(int value, int base = DEC) { return print((long) value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long) value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    template<typename T> size_t println(T value) { return print(value) + println(); }
+    size_t println(void) { return write("\r\n"); }
+
+    size_t printf(const char * format, ...) __attribute__ ((format (printf, 2, 3)));
+
+    virtual void flush(void) {}
+};
+
+#endif
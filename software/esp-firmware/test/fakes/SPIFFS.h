@@ -0,0 +1,42 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for SPIFFS, see FS.h.
+ */
+
+#ifndef _FAKE_SPIFFS_H_
+#define _FAKE_SPIFFS_H_
+
+#include "FS.h"
+
+namespace fs
+{
+
+class SPIFFSFS : public FS
+{
+  public:
+    bool begin(bool formatOnFail = false, const char * basePath = "/spiffs", uint8_t maxOpenFiles = 10,
+               const char * partitionLabel = nullptr);
+    void end(void);
+    bool format(void);
+};
+
+}
+
+extern fs::SPIFFSFS SPIFFS;
+
+#endif
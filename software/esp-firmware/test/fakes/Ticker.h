@@ -0,0 +1,72 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the Ticker library. Tickers are run
+ * by the simulated clock whenever it is advanced (see hostFakes.h), always
+ * on the thread advancing it.
+ */
+
+#ifndef _FAKE_TICKER_H_
+#define _FAKE_TICKER_H_
+
+#include <stdint.h>
+#include <functional>
+
+class Ticker
+{
+  public:
+    typedef void (*callback_t)(void);
+
+    Ticker();
+    ~Ticker();
+
+    void attach(float seconds, callback_t callback) { start((uint32_t) (seconds * 1000), true, callback); }
+    void attach_ms(uint32_t milliseconds, callback_t callback) { start(milliseconds, true, callback); }
+    void once(float seconds, callback_t callback) { start((uint32_t) (seconds * 1000), false, callback); }
+    void once_ms(uint32_t milliseconds, callback_t callback) { start(milliseconds, false, callback); }
+
+    template<typename TArg>
+    void attach_ms(uint32_t milliseconds, void (*callback)(TArg), TArg arg)
+    {
+      start(milliseconds, true, [callback, arg]() { callback(arg); });
+    }
+
+    template<typename TArg>
+    void once_ms(uint32_t milliseconds, void (*callback)(TArg), TArg arg)
+    {
+      start(milliseconds, false, [callback, arg]() { callback(arg); });
+    }
+
+    void detach(void);
+    bool active(void) const { return armed; }
+
+    /**
+     * Used by the simulated clock only
+     */
+    uint32_t due;
+    void fire(void);
+
+  private:
+    void start(uint32_t milliseconds, bool repeat, std::function<void(void)> callback);
+
+    std::function<void(void)> callback;
+    uint32_t period = 0;
+    bool repeat = false;
+    bool armed = false;
+};
+
+#endif
@@ -0,0 +1,294 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the Arduino String class.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "WString.h"
+
+/**
+ * Print a number in the given base into buf (at least 34 characters)
+ */
+static void formatNumber(char * buf, unsigned long value, bool negative, unsigned char base)
+{
+  char digits[34];
+  int n = 0;
+
+  do
+  {
+    digits[n++] = "0123456789abcdefghijklmnopqrstuvwxyz"[value % base];
+    value /= base;
+  } while(value > 0);
+
+  if(negative)
+  {
+    *buf++ = '-';
+  }
+  while(n > 0)
+  {
+    *buf++ = digits[--n];
+  }
+  *buf = '\0';
+}
+
+String::String(const char * cstr)
+{
+  if(cstr != nullptr)
+  {
+    copy(cstr, strlen(cstr));
+  }
+}
+
+String::String(const String & str)
+{
+  copy(str.c_str(), str.len);
+}
+
+String::String(String && str) : buffer(str.buffer), capacity(str.capacity), len(str.len)
+{
+  str.buffer = nullptr;
+  str.capacity = str.len = 0;
+}
+
+String::String(char c)
+{
+  copy(&c, 1);
+}
+
+String::String(unsigned char value, unsigned char base) : String((unsigned long) value, base)
+{
+}
+
+String::String(int value, unsigned char base) : String((long) value, base)
+{
+}
+
+String::String(unsigned int value, unsigned char base) : String((unsigned long) value, base)
+{
+}
+
+String::String(long value, unsigned char base)
+{
+  char buf[34];
+  // like the Arduino core, only base 10 has a sign
+  if(base == 10 && value < 0)
+  {
+    formatNumber(buf, 0ul - (unsigned long) value, true, base);
+  }
+  else
+  {
+    formatNumber(buf, (unsigned long) value, false, base);
+  }
+  copy(buf, strlen(buf));
+}
+
+String::String(unsigned long value, unsigned char base)
+{
+  char buf[34];
+  formatNumber(buf, value, false, base);
+  copy(buf, strlen(buf));
+}
+
+String::String(float value, unsigned int decimalPlaces) : String((double) value, decimalPlaces)
+{
+}
+
+String::String(double value, unsigned int decimalPlaces)
+{
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", (int) decimalPlaces, value);
+  copy(buf, strlen(buf));
+}
+
+String::~String()
+{
+  free(buffer);
+}
+
+String & String::operator=(const String & rhs)
+{
+  if(this != &rhs)
+  {
+    copy(rhs.c_str(), rhs.len);
+  }
+  return *this;
+}
+
+String & String::operator=(String && rhs)
+{
+  if(this != &rhs)
+  {
+    free(buffer);
+    buffer = rhs.buffer;
+    capacity = rhs.capacity;
+    len = rhs.len;
+    rhs.buffer = nullptr;
+    rhs.capacity = rhs.len = 0;
+  }
+  return *this;
+}
+
+String & String::operator=(const char * cstr)
+{
+  copy(cstr != nullptr ? cstr : "", cstr != nullptr ? strlen(cstr) : 0);
+  return *this;
+}
+
+/**
+ * Grow the buffer to hold at least size characters (plus the terminating zero)
+ */
+bool String::reserve(unsigned int size)
+{
+  if(buffer != nullptr && capacity >= size)
+  {
+    return true;
+  }
+  if(!changeBuffer(size))
+  {
+    return false;
+  }
+  if(len == 0)
+  {
+    buffer[0] = '\0';
+  }
+  return true;
+}
+
+bool String::changeBuffer(unsigned int maxLength)
+{
+  char * newBuffer = (char *) realloc(buffer, maxLength + 1);
+  if(newBuffer == nullptr)
+  {
+    return false;
+  }
+  buffer = newBuffer;
+  capacity = maxLength;
+  return true;
+}
+
+void String::copy(const char * cstr, unsigned int length)
+{
+  if(!reserve(length))
+  {
+    return;
+  }
+  // cstr may point into our own buffer
+  memmove(buffer, cstr, length);
+  buffer[length] = '\0';
+  len = length;
+}
+
+bool String::concat(const char * cstr, unsigned int length)
+{
+  if(cstr == nullptr)
+  {
+    return false;
+  }
+  if(length == 0)
+  {
+    return true;
+  }
+  // cstr may point into our own buffer, which reserve() might move
+  if(buffer != nullptr && cstr >= buffer && cstr < buffer + len)
+  {
+    String self(*this);
+    return concat(self.c_str() + (cstr - buffer), length);
+  }
+  if(!reserve(len + length))
+  {
+    return false;
+  }
+  memcpy(buffer + len, cstr, length);
+  len += length;
+  buffer[len] = '\0';
+  return true;
+}
+
+bool String::concat(const char * cstr)
+{
+  return cstr != nullptr && concat(cstr, strlen(cstr));
+}
+
+bool String::equals(const char * cstr) const
+{
+  return strcmp(c_str(), cstr != nullptr ? cstr : "") == 0;
+}
+
+int String::indexOf(char c, unsigned int from) const
+{
+  if(from >= len)
+  {
+    return -1;
+  }
+  const char * found = strchr(buffer + from, c);
+  return found != nullptr ? found - buffer : -1;
+}
+
+int String::indexOf(const String & str, unsigned int from) const
+{
+  if(from >= len)
+  {
+    return -1;
+  }
+  const char * found = strstr(buffer + from, str.c_str());
+  return found != nullptr ? found - buffer : -1;
+}
+
+bool String::startsWith(const String & prefix) const
+{
+  return prefix.len <= len && strncmp(c_str(), prefix.c_str(), prefix.len) == 0;
+}
+
+bool String::endsWith(const String & suffix) const
+{
+  return suffix.len <= len && strcmp(c_str() + len - suffix.len, suffix.c_str()) == 0;
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+  String result;
+  if(from > to)
+  {
+    unsigned int temp = to;
+    to = from;
+    from = temp;
+  }
+  if(from >= len)
+  {
+    return result;
+  }
+  if(to > len)
+  {
+    to = len;
+  }
+  result.concat(buffer + from, to - from);
+  return result;
+}
+
+long String::toInt(void) const
+{
+  return atol(c_str());
+}
+
+float String::toFloat(void) const
+{
+  return atof(c_str());
+}
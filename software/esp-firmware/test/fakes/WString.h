@@ -0,0 +1,114 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the Arduino String class. Like the
+ * original it keeps its text in a single heap block sized to fit, so heap
+ * use measured on the host is close to the one on the wiFred.
+ */
+
+#ifndef _FAKE_WSTRING_H_
+#define _FAKE_WSTRING_H_
+
+#include <stddef.h>
+
+class String
+{
+  public:
+    String(const char * cstr = "");
+    String(const String & str);
+    String(String && str);
+    explicit String(char c);
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+    ~String();
+
+    String & operator=(const String & rhs);
+    String & operator=(String && rhs);
+    String & operator=(const char * cstr);
+
+    bool reserve(unsigned int size);
+    unsigned int length(void) const { return len; }
+    const char * c_str(void) const { return buffer != nullptr ? buffer : ""; }
+    bool isEmpty(void) const { return len == 0; }
+
+    bool concat(const char * cstr, unsigned int length);
+    bool concat(const String & str) { return concat(str.c_str(), str.len); }
+    bool concat(const char * cstr);
+    bool concat(char c) { return concat(&c, 1); }
+    bool concat(unsigned char value) { return concat(String(value)); }
+    bool concat(int value) { return concat(String(value)); }
+    bool concat(unsigned int value) { return concat(String(value)); }
+    bool concat(long value) { return concat(String(value)); }
+    bool concat(unsigned long value) { return concat(String(value)); }
+    bool concat(float value) { return concat(String(value)); }
+    bool concat(double value) { return concat(String(value)); }
+
+    template<typename T> String & operator+=(T value) { concat(value); return *this; }
+
+    bool equals(const char * cstr) const;
+    bool equals(const String & str) const { return equals(str.c_str()); }
+    bool operator==(const String & rhs) const { return equals(rhs); }
+    bool operator==(const char * cstr) const { return equals(cstr); }
+    bool operator!=(const String & rhs) const { return !equals(rhs); }
+    bool operator!=(const char * cstr) const { return !equals(cstr); }
+
+    char charAt(unsigned int index) const { return index < len ? buffer[index] : '\0'; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String & str, unsigned int from = 0) const;
+    bool startsWith(const String & prefix) const;
+    bool endsWith(const String & suffix) const;
+    String substring(unsigned int from) const { return substring(from, len); }
+    String substring(unsigned int from, unsigned int to) const;
+
+    long toInt(void) const;
+    float toFloat(void) const;
+
+  private:
+    char * buffer = nullptr;
+    unsigned int capacity = 0;
+    unsigned int len = 0;
+
+    bool changeBuffer(unsigned int maxLength);
+    void copy(const char * cstr, unsigned int length);
+};
+
+template<typename T> String operator+(const String & lhs, T rhs)
+{
+  String result(lhs);
+  result.concat(rhs);
+  return result;
+}
+
+inline String operator+(const char * lhs, const String & rhs)
+{
+  String result(lhs);
+  result.concat(rhs);
+  return result;
+}
+
+inline bool operator==(const char * lhs, const String & rhs)
+{
+  return rhs.equals(lhs);
+}
+
+#endif
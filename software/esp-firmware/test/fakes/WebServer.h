@@ -0,0 +1,133 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the WebServer library. There is no
+ * HTTP server behind it: tests hand requests to it directly and get back
+ * what the handler has sent, chunk by chunk.
+ */
+
+#ifndef _FAKE_WEB_SERVER_H_
+#define _FAKE_WEB_SERVER_H_
+
+#include <Arduino.h>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <vector>
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) -2)
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+/**
+ * Everything a handler has sent in answer to one request
+ */
+typedef struct
+{
+  int code;
+  String contentType;
+  std::vector<std::pair<String, String>> headers;
+  bool chunked;
+  std::vector<String> chunks;    // body as sent, one entry per send()/sendContent() call
+  String body;
+  size_t length;                 // body bytes, also counted if the body is discarded
+  size_t chunkCount;             // send()/sendContent() calls with content
+  uint32_t firstByteMicros;      // real time from the start of the request to the status line
+  uint32_t lastByteMicros;       // real time from the start of the request to the end of the body
+} fakeResponse;
+
+class WebServer
+{
+  public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit WebServer(int port = 80) : port(port) {}
+
+    void begin(void) { running = true; }
+    void handleClient(void) {}
+
+    void on(const String & uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const String & uri, HTTPMethod method, THandlerFunction handler);
+    void onNotFound(THandlerFunction handler) { notFoundHandler = handler; }
+    void collectHeaders(const char * headerKeys[], const size_t headerKeysCount);
+
+    String arg(const String & name) const;
+    String arg(int i) const;
+    String argName(int i) const;
+    int args(void) const { return requestArgs.size(); }
+    bool hasArg(const String & name) const;
+    String header(const String & name) const;
+    String uri(void) const { return requestUri; }
+    HTTPMethod method(void) const { return requestMethod; }
+
+    void setContentLength(const size_t contentLength) { contentLength_ = contentLength; }
+    void sendHeader(const String & name, const String & value, bool first = false);
+    void send(int code, const char * contentType = nullptr, const String & content = String(""));
+    void send(int code, const String & contentType, const String & content) { send(code, contentType.c_str(), content); }
+    void send_P(int code, const char * contentType, const char * content, size_t contentLength);
+    void sendContent(const String & content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char * content, size_t contentLength);
+
+    /**
+     * Run the handler for a request like the real server would after parsing it
+     *
+     * @returns the response, code 0 if the handler has not sent anything
+     */
+    fakeResponse request(const String & uri, HTTPMethod method = HTTP_GET,
+                         const std::vector<std::pair<String, String>> & arguments = {},
+                         const std::vector<std::pair<String, String>> & requestHeaders = {});
+
+    /**
+     * Only count the bytes and chunks sent instead of keeping them in the
+     * response, i.e. to measure the heap use of a handler
+     */
+    void discardBodies(bool discard) { discardBody = discard; }
+
+    /**
+     * Paths with a handler registered through on()
+     */
+    std::vector<String> paths(void) const;
+
+  private:
+    uint32_t elapsedMicros(void) const;
+
+    typedef struct
+    {
+      String uri;
+      HTTPMethod method;
+      THandlerFunction handler;
+    } route;
+
+    int port;
+    bool running = false;
+    std::vector<route> routes;
+    THandlerFunction notFoundHandler;
+    std::vector<String> collectedHeaders;
+
+    String requestUri;
+    HTTPMethod requestMethod = HTTP_GET;
+    std::vector<std::pair<String, String>> requestArgs;
+    std::vector<std::pair<String, String>> requestHeaders;
+    std::vector<std::pair<String, String>> pendingHeaders;
+    size_t contentLength_ = CONTENT_LENGTH_NOT_SET;
+    bool discardBody = false;
+    std::chrono::steady_clock::time_point requestStart;
+    fakeResponse response;
+};
+
+#endif
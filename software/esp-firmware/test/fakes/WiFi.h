@@ -0,0 +1,85 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the WiFi library. Networks only
+ * exist in the simulation (see hostFakes.h), connecting takes simulated
+ * time and the station always gets 127.0.0.1 so servers on the host are
+ * reachable.
+ */
+
+#ifndef _FAKE_WIFI_H_
+#define _FAKE_WIFI_H_
+
+#include <Arduino.h>
+
+#include "IPAddress.h"
+#include "WiFiClient.h"
+
+typedef enum
+{
+  WL_NO_SHIELD = 255,
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL,
+  WL_SCAN_COMPLETED,
+  WL_CONNECTED,
+  WL_CONNECT_FAILED,
+  WL_CONNECTION_LOST,
+  WL_DISCONNECTED
+} wl_status_t;
+
+typedef enum { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+
+typedef enum { WIFI_AUTH_OPEN, WIFI_AUTH_WEP, WIFI_AUTH_WPA_PSK, WIFI_AUTH_WPA2_PSK } wifi_auth_mode_t;
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+
+class WiFiClass
+{
+  public:
+    wl_status_t status(void);
+    bool isConnected(void) { return status() == WL_CONNECTED; }
+    wl_status_t begin(const char * ssid, const char * passphrase = nullptr, int32_t channel = 0,
+                      const uint8_t * bssid = nullptr, bool connect = true);
+    bool disconnect(bool wifiOff = false, bool eraseAP = false);
+    bool mode(wifi_mode_t mode);
+    bool setHostname(const char * hostname);
+
+    String SSID(void);
+    uint8_t * BSSID(void);
+    int32_t channel(void);
+    int8_t RSSI(void);
+    IPAddress localIP(void);
+    IPAddress subnetMask(void);
+    uint8_t * macAddress(uint8_t * mac);
+    String macAddress(void);
+
+    int16_t scanNetworks(bool async = false, bool showHidden = false, bool passive = false,
+                         uint32_t maxMsPerChannel = 300, uint8_t channel = 0);
+    int16_t scanComplete(void);
+    void scanDelete(void);
+    String SSID(uint8_t i);
+    int32_t RSSI(uint8_t i);
+    wifi_auth_mode_t encryptionType(uint8_t i);
+
+    bool softAP(const char * ssid, const char * passphrase = nullptr);
+    IPAddress softAPIP(void);
+};
+
+extern WiFiClass WiFi;
+
+#endif
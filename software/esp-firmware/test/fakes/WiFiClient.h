@@ -0,0 +1,58 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for WiFiClient, it wraps a real TCP
+ * socket so the firmware can talk to a wiThrottle server on the host.
+ */
+
+#ifndef _FAKE_WIFI_CLIENT_H_
+#define _FAKE_WIFI_CLIENT_H_
+
+#include <memory>
+
+#include "Client.h"
+#include "IPAddress.h"
+
+class WiFiClient : public Client
+{
+  public:
+    WiFiClient();
+    explicit WiFiClient(int fd);
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(const char * host, uint16_t port) override;
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+    int available(void) override;
+    int read(void) override;
+    int read(uint8_t * buffer, size_t size) override;
+    int peek(void) override;
+    void flush(void) override {}
+    void stop(void) override;
+    uint8_t connected(void) override;
+    operator bool() override { return connected(); }
+
+    int setNoDelay(bool noDelay);
+    int fd(void) const;
+
+  private:
+    // shared by all copies, like the socket handle of the real WiFiClient
+    std::shared_ptr<int> socketFd;
+};
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for WiFiMulti, run() scans and connects
+ * in simulated time just like the real one blocks.
+ */
+
+#ifndef _FAKE_WIFI_MULTI_H_
+#define _FAKE_WIFI_MULTI_H_
+
+#include <vector>
+
+#include "WiFi.h"
+
+class WiFiMulti
+{
+  public:
+    bool addAP(const char * ssid, const char * passphrase = nullptr);
+    uint8_t run(uint32_t connectTimeout = 5000);
+
+  private:
+    std::vector<std::pair<String, String>> accessPoints;
+};
+
+#endif
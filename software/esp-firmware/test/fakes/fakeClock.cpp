@@ -0,0 +1,362 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file simulates the clock, the Tickers and the FreeRTOS task
+ * notifications and semaphores used by the firmware.
+ */
+
+#include <Arduino.h>
+#include <Ticker.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "hostFakes.h"
+
+/**
+ * Simulated time in µs, only used while not in real time mode
+ */
+static uint64_t simulatedMicros = 0;
+
+static bool realTime = false;
+static std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+
+/**
+ * Guards the Ticker list and the task notifications, notify is signalled
+ * whenever a notification is given (never destroyed, global Tickers of the
+ * firmware may be destroyed after them otherwise)
+ */
+static std::recursive_mutex & schedulerLock = * new std::recursive_mutex;
+static std::condition_variable_any & notify = * new std::condition_variable_any;
+static std::vector<Ticker *> & armedTickers = * new std::vector<Ticker *>;
+static std::map<TaskHandle_t, uint32_t> & notifications = * new std::map<TaskHandle_t, uint32_t>;
+
+std::vector<fakeTask> fakeTasks;
+
+static uint64_t nowMicros(void)
+{
+  if(realTime)
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - realStart).count();
+  }
+  return simulatedMicros;
+}
+
+uint32_t millis(void)
+{
+  return nowMicros() / 1000;
+}
+
+uint32_t micros(void)
+{
+  return nowMicros();
+}
+
+void fakeUseRealTime(bool enable)
+{
+  std::lock_guard<std::recursive_mutex> lock(schedulerLock);
+  if(enable && !realTime)
+  {
+    realStart = std::chrono::steady_clock::now() - std::chrono::microseconds(simulatedMicros);
+  }
+  else if(!enable && realTime)
+  {
+    simulatedMicros = nowMicros();
+  }
+  realTime = enable;
+}
+
+/**
+ * Earliest Ticker due time, false if no Ticker is armed
+ */
+static bool nextDue(uint32_t & due)
+{
+  std::lock_guard<std::recursive_mutex> lock(schedulerLock);
+  if(armedTickers.empty())
+  {
+    return false;
+  }
+  uint32_t now = millis();
+  due = armedTickers[0]->due;
+  for(Ticker * t : armedTickers)
+  {
+    if((int32_t) (t->due - due) < 0)
+    {
+      due = t->due;
+    }
+  }
+  // overdue Tickers run at once
+  if((int32_t) (due - now) < 0)
+  {
+    due = now;
+  }
+  return true;
+}
+
+/**
+ * Run all Tickers due at the current time, earliest first (callbacks attach
+ * and detach Tickers themselves)
+ */
+static void runDueTickers(void)
+{
+  for(;;)
+  {
+    Ticker * due = nullptr;
+    {
+      std::lock_guard<std::recursive_mutex> lock(schedulerLock);
+      uint32_t now = millis();
+      for(Ticker * t : armedTickers)
+      {
+        if((int32_t) (now - t->due) >= 0 && (due == nullptr || (int32_t) (t->due - due->due) < 0))
+        {
+          due = t;
+        }
+      }
+    }
+    if(due == nullptr)
+    {
+      return;
+    }
+    due->fire();
+  }
+}
+
+/**
+ * Let time pass until deadline (millis() value) or until stop returns true,
+ * running Tickers on the way
+ */
+template<typename Predicate>
+static bool passTime(uint32_t deadline, Predicate stop)
+{
+  std::unique_lock<std::recursive_mutex> lock(schedulerLock);
+  for(;;)
+  {
+    runDueTickers();
+    if(stop())
+    {
+      return true;
+    }
+    uint32_t now = millis();
+    if((int32_t) (deadline - now) <= 0)
+    {
+      return false;
+    }
+    uint32_t until = deadline;
+    uint32_t due;
+    if(nextDue(due) && (int32_t) (due - until) < 0)
+    {
+      until = due;
+    }
+    if(realTime)
+    {
+      notify.wait_for(lock, std::chrono::milliseconds(until - now));
+    }
+    else
+    {
+      simulatedMicros = (uint64_t) until * 1000;
+    }
+  }
+}
+
+void fakeAdvance(uint32_t ms)
+{
+  passTime(millis() + ms, []() { return false; });
+}
+
+void delay(uint32_t ms)
+{
+  fakeAdvance(ms);
+}
+
+void yield(void)
+{
+  runDueTickers();
+}
+
+/**
+ * Each thread is a task of its own
+ */
+static thread_local char taskTag;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+  return &taskTag;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char * name, uint32_t stackDepth, void * parameters,
+                       UBaseType_t priority, TaskHandle_t * createdTask)
+{
+  fakeTasks.push_back({ String(name), code, priority });
+  if(createdTask != nullptr)
+  {
+    *createdTask = new char;
+  }
+  return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+  delay(ticks);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+  std::lock_guard<std::recursive_mutex> lock(schedulerLock);
+  notifications[task]++;
+  notify.notify_all();
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t * higherPriorityTaskWoken)
+{
+  xTaskNotifyGive(task);
+  if(higherPriorityTaskWoken != nullptr)
+  {
+    *higherPriorityTaskWoken = pdTRUE;
+  }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+  std::unique_lock<std::recursive_mutex> lock(schedulerLock);
+  uint32_t & count = notifications[xTaskGetCurrentTaskHandle()];
+
+  // without a Ticker nothing could wake up a simulated wait for ever
+  uint32_t wait = ticksToWait;
+  if(ticksToWait == portMAX_DELAY && !realTime)
+  {
+    uint32_t due;
+    wait = nextDue(due) ? due - millis() : 0;
+  }
+  // passTime() must be the only holder of the lock while it waits for notify
+  lock.unlock();
+  if(!passTime(millis() + wait, [&count]() { return count > 0; }))
+  {
+    return 0;
+  }
+  lock.lock();
+  uint32_t value = count;
+  count = clearCountOnExit ? 0 : count - 1;
+  return value;
+}
+
+/**
+ * Semaphores on top of the host's mutexes, waits always take real time as
+ * the other side runs on a thread of its own
+ */
+typedef struct
+{
+  std::mutex lock;
+  std::condition_variable given;
+  uint32_t count;
+} fakeSemaphore;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+  return new fakeSemaphore { {}, {}, 1 };
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+  return new fakeSemaphore { {}, {}, 0 };
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait)
+{
+  fakeSemaphore * s = (fakeSemaphore *) semaphore;
+  std::unique_lock<std::mutex> lock(s->lock);
+  if(ticksToWait == portMAX_DELAY)
+  {
+    s->given.wait(lock, [s]() { return s->count > 0; });
+  }
+  else if(!s->given.wait_for(lock, std::chrono::milliseconds(ticksToWait), [s]() { return s->count > 0; }))
+  {
+    return pdFALSE;
+  }
+  s->count--;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+  fakeSemaphore * s = (fakeSemaphore *) semaphore;
+  std::lock_guard<std::mutex> lock(s->lock);
+  if(s->count > 0)
+  {
+    return pdFALSE;
+  }
+  s->count++;
+  s->given.notify_one();
+  return pdTRUE;
+}
+
+/**
+ * Tickers
+ */
+Ticker::Ticker()
+{
+}
+
+Ticker::~Ticker()
+{
+  detach();
+}
+
+void Ticker::start(uint32_t milliseconds, bool repeat, std::function<void(void)> callback)
+{
+  std::lock_guard<std::recursive_mutex> lock(schedulerLock);
+  detach();
+  this->callback = callback;
+  this->period = milliseconds;
+  this->repeat = repeat;
+  due = millis() + milliseconds;
+  armed = true;
+  armedTickers.push_back(this);
+  notify.notify_all();
+}
+
+void Ticker::detach(void)
+{
+  std::lock_guard<std::recursive_mutex> lock(schedulerLock);
+  if(armed)
+  {
+    armedTickers.erase(std::find(armedTickers.begin(), armedTickers.end(), this));
+    armed = false;
+  }
+}
+
+void Ticker::fire(void)
+{
+  std::function<void(void)> run;
+  {
+    std::lock_guard<std::recursive_mutex> lock(schedulerLock);
+    run = callback;
+    if(repeat)
+    {
+      // periodic Tickers keep their pace, like esp_timer does
+      due += period > 0 ? period : 1;
+    }
+    else
+    {
+      detach();
+    }
+  }
+  run();
+}
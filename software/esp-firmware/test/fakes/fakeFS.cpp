@@ -0,0 +1,189 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file keeps the simulated file system in memory.
+ */
+
+#include <FS.h>
+#include <SPIFFS.h>
+#include <map>
+#include <string>
+
+#include "hostFakes.h"
+
+namespace fs
+{
+
+/**
+ * An open file, writes go straight to the stored contents
+ */
+struct fileHandle
+{
+  String path;
+  std::string * contents;
+  size_t position;
+  bool writable;
+};
+
+}
+
+static std::map<std::string, std::string> files;
+
+fs::SPIFFSFS SPIFFS;
+
+String fakeReadFile(const char * path)
+{
+  auto it = files.find(path);
+  return it != files.end() ? String(it->second.c_str()) : String("");
+}
+
+void fakeWriteFile(const char * path, const String & contents)
+{
+  files[path] = std::string(contents.c_str(), contents.length());
+}
+
+void fakeFormat(void)
+{
+  files.clear();
+}
+
+namespace fs
+{
+
+size_t File::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t File::write(const uint8_t * buffer, size_t size)
+{
+  if(handle == nullptr || !handle->writable)
+  {
+    return 0;
+  }
+  handle->contents->replace(handle->position, size, (const char *) buffer, size);
+  handle->position += size;
+  return size;
+}
+
+int File::available(void)
+{
+  return handle != nullptr ? handle->contents->size() - handle->position : 0;
+}
+
+int File::read(void)
+{
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t * buffer, size_t size)
+{
+  size_t n = available();
+  if(n > size)
+  {
+    n = size;
+  }
+  if(n > 0)
+  {
+    memcpy(buffer, handle->contents->data() + handle->position, n);
+    handle->position += n;
+  }
+  return n;
+}
+
+int File::peek(void)
+{
+  return available() > 0 ? (uint8_t) (*handle->contents)[handle->position] : -1;
+}
+
+bool File::seek(uint32_t position)
+{
+  if(handle == nullptr || position > handle->contents->size())
+  {
+    return false;
+  }
+  handle->position = position;
+  return true;
+}
+
+size_t File::position(void) const
+{
+  return handle != nullptr ? handle->position : 0;
+}
+
+size_t File::size(void) const
+{
+  return handle != nullptr ? handle->contents->size() : 0;
+}
+
+const char * File::name(void) const
+{
+  return handle != nullptr ? handle->path.c_str() : nullptr;
+}
+
+File FS::open(const char * path, const char * mode, const bool create)
+{
+  if(!mounted)
+  {
+    return File();
+  }
+  auto it = files.find(path);
+  if(mode[0] == 'r')
+  {
+    if(it == files.end())
+    {
+      return File();
+    }
+    return File(std::make_shared<fileHandle>(fileHandle { String(path), &it->second, 0, mode[1] == '+' }));
+  }
+  std::string & contents = files[path];
+  if(mode[0] == 'w')
+  {
+    contents.clear();
+  }
+  return File(std::make_shared<fileHandle>(fileHandle { String(path), &contents, contents.size(), true }));
+}
+
+bool FS::exists(const char * path)
+{
+  return mounted && files.count(path) > 0;
+}
+
+bool FS::remove(const char * path)
+{
+  return mounted && files.erase(path) > 0;
+}
+
+bool SPIFFSFS::begin(bool formatOnFail, const char * basePath, uint8_t maxOpenFiles, const char * partitionLabel)
+{
+  mounted = true;
+  return true;
+}
+
+void SPIFFSFS::end(void)
+{
+  mounted = false;
+}
+
+bool SPIFFSFS::format(void)
+{
+  files.clear();
+  return true;
+}
+
+}
@@ -0,0 +1,238 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file simulates the GPIO pins, the continuous A/D conversion, the
+ * serial port and the chip functions used by the firmware.
+ */
+
+#include <Arduino.h>
+#include <Ticker.h>
+#include <unistd.h>
+
+#include "hostFakes.h"
+
+#define FAKE_PINS 64
+
+static uint8_t pinModes[FAKE_PINS];
+static uint8_t inputLevels[FAKE_PINS];
+static uint8_t outputLevels[FAKE_PINS];
+static bool inputLevelSet[FAKE_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if(pin < FAKE_PINS)
+  {
+    pinModes[pin] = mode;
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  if(pin < FAKE_PINS)
+  {
+    outputLevels[pin] = value ? HIGH : LOW;
+  }
+}
+
+int digitalRead(uint8_t pin)
+{
+  if(pin >= FAKE_PINS)
+  {
+    return LOW;
+  }
+  if(pinModes[pin] == OUTPUT)
+  {
+    return outputLevels[pin];
+  }
+  // open inputs float high, like the pulled up keys of the wiFred
+  return inputLevelSet[pin] ? inputLevels[pin] : HIGH;
+}
+
+void fakeSetInput(uint8_t pin, int level)
+{
+  if(pin < FAKE_PINS)
+  {
+    inputLevels[pin] = level ? HIGH : LOW;
+    inputLevelSet[pin] = true;
+  }
+}
+
+int fakeGetOutput(uint8_t pin)
+{
+  return pin < FAKE_PINS ? outputLevels[pin] : LOW;
+}
+
+uint8_t fakeGetPinMode(uint8_t pin)
+{
+  return pin < FAKE_PINS ? pinModes[pin] : 0;
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+  const long run = inMax - inMin;
+  if(run == 0)
+  {
+    return outMin;
+  }
+  return (x - inMin) * (outMax - outMin) / run + outMin;
+}
+
+/**
+ * Continuous A/D conversion: a Ticker completes a block every
+ * 2 * conversionsPerPin * 1000 / samplingFreqHz ms (for two pins)
+ */
+#define FAKE_ADC_MAX_PINS 8
+
+static Ticker * adcTicker = new Ticker;
+static void (*adcCallback)(void) = nullptr;
+static uint32_t adcPeriod = 0;
+static size_t adcPinCount = 0;
+static bool adcBlockReady = false;
+static uint8_t adcPins[FAKE_ADC_MAX_PINS];
+static adc_continuous_data_t adcBlock[FAKE_ADC_MAX_PINS];
+static uint16_t analogRaw[FAKE_PINS];
+static uint16_t analogMilliVolts[FAKE_PINS];
+
+uint32_t fakeAnalogBlocks = 0;
+
+static void adcBlockComplete(void)
+{
+  for(size_t i = 0; i < adcPinCount; i++)
+  {
+    adcBlock[i].pin = adcPins[i];
+    adcBlock[i].channel = i;
+    adcBlock[i].avg_read_raw = analogRaw[adcPins[i]];
+    adcBlock[i].avg_read_mvolts = analogMilliVolts[adcPins[i]];
+  }
+  adcBlockReady = true;
+  fakeAnalogBlocks++;
+  if(adcCallback != nullptr)
+  {
+    adcCallback();
+  }
+}
+
+bool analogContinuous(const uint8_t pins[], size_t pinsCount, uint32_t conversionsPerPin, uint32_t samplingFreqHz, void (*userFunc)(void))
+{
+  if(pinsCount == 0 || pinsCount > FAKE_ADC_MAX_PINS || samplingFreqHz == 0)
+  {
+    return false;
+  }
+  for(size_t i = 0; i < pinsCount; i++)
+  {
+    if(pins[i] >= FAKE_PINS)
+    {
+      return false;
+    }
+    adcPins[i] = pins[i];
+  }
+  adcPinCount = pinsCount;
+  adcCallback = userFunc;
+  adcPeriod = pinsCount * conversionsPerPin * 1000 / samplingFreqHz;
+  return true;
+}
+
+bool analogContinuousStart(void)
+{
+  if(adcPeriod == 0)
+  {
+    return false;
+  }
+  adcTicker->attach_ms(adcPeriod, adcBlockComplete);
+  return true;
+}
+
+bool analogContinuousStop(void)
+{
+  adcTicker->detach();
+  return true;
+}
+
+bool analogContinuousDeinit(void)
+{
+  analogContinuousStop();
+  adcPeriod = 0;
+  adcPinCount = 0;
+  return true;
+}
+
+bool analogContinuousRead(adc_continuous_data_t ** buffer, uint32_t timeoutMs)
+{
+  if(!adcBlockReady)
+  {
+    return false;
+  }
+  adcBlockReady = false;
+  *buffer = adcBlock;
+  return true;
+}
+
+void analogContinuousSetAtten(adc_attenuation_t attenuation)
+{
+}
+
+void fakeSetAnalog(uint8_t pin, uint16_t raw, uint16_t milliVolts)
+{
+  if(pin < FAKE_PINS)
+  {
+    analogRaw[pin] = raw;
+    analogMilliVolts[pin] = milliVolts;
+  }
+}
+
+uint32_t fakeAnalogPeriod(void)
+{
+  return adcTicker->active() ? adcPeriod : 0;
+}
+
+/**
+ * Serial port, written to stdout
+ */
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t * buffer, size_t size)
+{
+  return fwrite(buffer, 1, size, stdout);
+}
+
+/**
+ * Chip functions, restarts and deep sleep are only counted
+ */
+EspClass ESP;
+
+uint32_t fakeRestarts = 0;
+uint32_t fakeDeepSleeps = 0;
+
+void EspClass::restart(void)
+{
+  fakeRestarts++;
+}
+
+void EspClass::deepSleep(uint64_t timeUs)
+{
+  fakeDeepSleeps++;
+}
+
+uint32_t EspClass::getFreeHeap(void)
+{
+  return 160 * 1024;
+}
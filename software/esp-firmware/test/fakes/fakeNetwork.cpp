@@ -0,0 +1,597 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file simulates the WiFi station and mDNS, and passes TCP connections
+ * and name lookups on to the host.
+ */
+
+#include <Arduino.h>
+#include <AsyncUDP.h>
+#include <ESPmDNS.h>
+#include <WiFi.h>
+#include <WiFiClient.h>
+#include <WiFiMulti.h>
+#include <lwip/sockets.h>
+#include <lwip/dns.h>
+#include <lwip/priv/tcpip_priv.h>
+#include <mdns.h>
+#include <netdb.h>
+#include <sys/ioctl.h>
+
+#include "hostFakes.h"
+
+std::atomic<uint32_t> fakeClientBytesWritten(0);
+std::atomic<uint32_t> fakeClientWrites(0);
+std::atomic<uint32_t> fakeClientBytesRead(0);
+
+/**
+ * TCP connections
+ */
+static std::shared_ptr<int> shareSocket(int fd)
+{
+  return std::shared_ptr<int>(new int(fd), [](int * fd) { close(*fd); delete fd; });
+}
+
+WiFiClient::WiFiClient()
+{
+}
+
+WiFiClient::WiFiClient(int fd) : socketFd(shareSocket(fd))
+{
+}
+
+int WiFiClient::fd(void) const
+{
+  return socketFd != nullptr ? *socketFd : -1;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port)
+{
+  stop();
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if(fd < 0)
+  {
+    return 0;
+  }
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = (uint32_t) ip;
+  address.sin_port = htons(port);
+  if(::connect(fd, (struct sockaddr *) &address, sizeof(address)) < 0)
+  {
+    close(fd);
+    return 0;
+  }
+  socketFd = shareSocket(fd);
+  return 1;
+}
+
+int WiFiClient::connect(const char * host, uint16_t port)
+{
+  IPAddress ip;
+  struct addrinfo hints;
+  struct addrinfo * result = nullptr;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  if(getaddrinfo(host, nullptr, &hints, &result) != 0 || result == nullptr)
+  {
+    return 0;
+  }
+  ip = IPAddress(((struct sockaddr_in *) result->ai_addr)->sin_addr.s_addr);
+  freeaddrinfo(result);
+  return connect(ip, port);
+}
+
+size_t WiFiClient::write(uint8_t data)
+{
+  return write(&data, 1);
+}
+
+size_t WiFiClient::write(const uint8_t * buffer, size_t size)
+{
+  if(fd() < 0)
+  {
+    return 0;
+  }
+  ssize_t n = send(fd(), buffer, size, MSG_NOSIGNAL);
+  if(n < 0)
+  {
+    return 0;
+  }
+  fakeClientBytesWritten += n;
+  fakeClientWrites++;
+  return n;
+}
+
+int WiFiClient::available(void)
+{
+  int count = 0;
+  if(fd() < 0 || ioctl(fd(), FIONREAD, &count) < 0)
+  {
+    return 0;
+  }
+  return count;
+}
+
+int WiFiClient::read(void)
+{
+  uint8_t data;
+  return read(&data, 1) == 1 ? data : -1;
+}
+
+int WiFiClient::read(uint8_t * buffer, size_t size)
+{
+  if(fd() < 0)
+  {
+    return -1;
+  }
+  ssize_t n = recv(fd(), buffer, size, MSG_DONTWAIT);
+  if(n <= 0)
+  {
+    return -1;
+  }
+  fakeClientBytesRead += n;
+  return n;
+}
+
+int WiFiClient::peek(void)
+{
+  uint8_t data;
+  if(fd() < 0 || recv(fd(), &data, 1, MSG_PEEK | MSG_DONTWAIT) != 1)
+  {
+    return -1;
+  }
+  return data;
+}
+
+void WiFiClient::stop(void)
+{
+  socketFd.reset();
+}
+
+uint8_t WiFiClient::connected(void)
+{
+  uint8_t data;
+  if(fd() < 0)
+  {
+    return 0;
+  }
+  ssize_t n = recv(fd(), &data, 1, MSG_PEEK | MSG_DONTWAIT);
+  if(n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)))
+  {
+    return 1;
+  }
+  return 0;
+}
+
+int WiFiClient::setNoDelay(bool noDelay)
+{
+  int flag = noDelay;
+  return fd() >= 0 ? setsockopt(fd(), IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag)) : -1;
+}
+
+/**
+ * WiFi station
+ */
+typedef struct
+{
+  String ssid;
+  String key;
+  int8_t rssi;
+  int32_t channel;
+  uint8_t bssid[6];
+} fakeNetwork;
+
+static std::vector<fakeNetwork> networks;
+
+/**
+ * Network connected to (or being connected to), -1 if none
+ */
+static int current = -1;
+static wl_status_t pendingStatus = WL_IDLE_STATUS;
+static uint32_t pendingAt = 0;
+static wl_status_t wifiStatus = WL_IDLE_STATUS;
+
+static std::vector<fakeNetwork> scanResults;
+static bool scanRunning = false;
+static uint32_t scanDoneAt = 0;
+
+static const uint8_t FAKE_MAC[6] = { 0x24, 0x0a, 0xc4, 0x12, 0x34, 0x56 };
+
+uint32_t fakeWiFiConnectMs = 800;
+uint32_t fakeWiFiScanMs = 2000;
+
+WiFiClass WiFi;
+
+void fakeAddNetwork(const char * ssid, const char * key, int8_t rssi, int32_t channel)
+{
+  fakeNetwork network = { String(ssid), String(key != nullptr ? key : ""), rssi, channel,
+                          { 0x02, 0x00, 0x00, 0x00, 0x00, (uint8_t) networks.size() } };
+  networks.push_back(network);
+}
+
+void fakeClearNetworks(void)
+{
+  WiFi.disconnect();
+  networks.clear();
+}
+
+void fakeWiFiDrop(void)
+{
+  if(WiFi.status() == WL_CONNECTED)
+  {
+    wifiStatus = WL_CONNECTION_LOST;
+    current = -1;
+  }
+}
+
+wl_status_t WiFiClass::status(void)
+{
+  if(pendingStatus != WL_IDLE_STATUS && (int32_t) (millis() - pendingAt) >= 0)
+  {
+    wifiStatus = pendingStatus;
+    pendingStatus = WL_IDLE_STATUS;
+    if(wifiStatus != WL_CONNECTED)
+    {
+      current = -1;
+    }
+  }
+  return wifiStatus;
+}
+
+wl_status_t WiFiClass::begin(const char * ssid, const char * passphrase, int32_t channel,
+                             const uint8_t * bssid, bool connect)
+{
+  current = -1;
+  for(size_t i = 0; i < networks.size(); i++)
+  {
+    if(networks[i].ssid == ssid && (channel == 0 || networks[i].channel == channel)
+       && (bssid == nullptr || !memcmp(networks[i].bssid, bssid, sizeof(networks[i].bssid))))
+    {
+      current = i;
+      break;
+    }
+  }
+  wifiStatus = WL_DISCONNECTED;
+  // a known channel saves scanning for the access point
+  pendingAt = millis() + fakeWiFiConnectMs + (channel == 0 ? fakeWiFiScanMs : 0);
+  if(current < 0)
+  {
+    pendingStatus = WL_NO_SSID_AVAIL;
+  }
+  else if(networks[current].key != (passphrase != nullptr ? passphrase : ""))
+  {
+    pendingStatus = WL_CONNECT_FAILED;
+  }
+  else
+  {
+    pendingStatus = WL_CONNECTED;
+  }
+  return wifiStatus;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAP)
+{
+  current = -1;
+  pendingStatus = WL_IDLE_STATUS;
+  wifiStatus = WL_DISCONNECTED;
+  return true;
+}
+
+bool WiFiClass::mode(wifi_mode_t mode)
+{
+  if(mode == WIFI_OFF)
+  {
+    disconnect();
+  }
+  return true;
+}
+
+bool WiFiClass::setHostname(const char * hostname)
+{
+  return true;
+}
+
+String WiFiClass::SSID(void)
+{
+  return status() == WL_CONNECTED ? networks[current].ssid : String("");
+}
+
+uint8_t * WiFiClass::BSSID(void)
+{
+  return status() == WL_CONNECTED ? networks[current].bssid : nullptr;
+}
+
+int32_t WiFiClass::channel(void)
+{
+  return status() == WL_CONNECTED ? networks[current].channel : 0;
+}
+
+int8_t WiFiClass::RSSI(void)
+{
+  return status() == WL_CONNECTED ? networks[current].rssi : 0;
+}
+
+IPAddress WiFiClass::localIP(void)
+{
+  return status() == WL_CONNECTED ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+IPAddress WiFiClass::subnetMask(void)
+{
+  return status() == WL_CONNECTED ? IPAddress(255, 255, 255, 0) : IPAddress();
+}
+
+uint8_t * WiFiClass::macAddress(uint8_t * mac)
+{
+  memcpy(mac, FAKE_MAC, sizeof(FAKE_MAC));
+  return mac;
+}
+
+String WiFiClass::macAddress(void)
+{
+  char text[18];
+  snprintf(text, sizeof(text), "%02X:%02X:%02X:%02X:%02X:%02X",
+           FAKE_MAC[0], FAKE_MAC[1], FAKE_MAC[2], FAKE_MAC[3], FAKE_MAC[4], FAKE_MAC[5]);
+  return String(text);
+}
+
+int16_t WiFiClass::scanNetworks(bool async, bool showHidden, bool passive, uint32_t maxMsPerChannel, uint8_t channel)
+{
+  scanResults = networks;
+  scanRunning = true;
+  scanDoneAt = millis() + fakeWiFiScanMs;
+  if(async)
+  {
+    return WIFI_SCAN_RUNNING;
+  }
+  delay(fakeWiFiScanMs);
+  return scanComplete();
+}
+
+int16_t WiFiClass::scanComplete(void)
+{
+  if(!scanRunning)
+  {
+    return scanResults.empty() ? WIFI_SCAN_FAILED : scanResults.size();
+  }
+  if((int32_t) (millis() - scanDoneAt) < 0)
+  {
+    return WIFI_SCAN_RUNNING;
+  }
+  scanRunning = false;
+  return scanResults.size();
+}
+
+void WiFiClass::scanDelete(void)
+{
+  scanResults.clear();
+  scanRunning = false;
+}
+
+String WiFiClass::SSID(uint8_t i)
+{
+  return i < scanResults.size() ? scanResults[i].ssid : String("");
+}
+
+int32_t WiFiClass::RSSI(uint8_t i)
+{
+  return i < scanResults.size() ? scanResults[i].rssi : 0;
+}
+
+wifi_auth_mode_t WiFiClass::encryptionType(uint8_t i)
+{
+  return i < scanResults.size() && scanResults[i].key.length() > 0 ? WIFI_AUTH_WPA2_PSK : WIFI_AUTH_OPEN;
+}
+
+bool WiFiClass::softAP(const char * ssid, const char * passphrase)
+{
+  return true;
+}
+
+IPAddress WiFiClass::softAPIP(void)
+{
+  return IPAddress(192, 168, 4, 1);
+}
+
+bool WiFiMulti::addAP(const char * ssid, const char * passphrase)
+{
+  accessPoints.push_back(std::make_pair(String(ssid), String(passphrase != nullptr ? passphrase : "")));
+  return true;
+}
+
+/**
+ * Like the real one: scan, pick the strongest known network and wait for
+ * the connection, blocking all the while
+ */
+uint8_t WiFiMulti::run(uint32_t connectTimeout)
+{
+  if(WiFi.status() == WL_CONNECTED)
+  {
+    return WL_CONNECTED;
+  }
+
+  int16_t found = WiFi.scanNetworks();
+  int best = -1;
+  String key;
+  for(int16_t i = 0; i < found; i++)
+  {
+    for(auto & ap : accessPoints)
+    {
+      if(ap.first == WiFi.SSID(i) && (best < 0 || WiFi.RSSI(i) > WiFi.RSSI(best)))
+      {
+        best = i;
+        key = ap.second;
+      }
+    }
+  }
+  if(best < 0)
+  {
+    WiFi.scanDelete();
+    return WL_NO_SSID_AVAIL;
+  }
+
+  String ssid = WiFi.SSID(best);
+  WiFi.scanDelete();
+  WiFi.begin(ssid.c_str(), key.c_str());
+  uint32_t start = millis();
+  while(WiFi.status() != WL_CONNECTED && WiFi.status() != WL_CONNECT_FAILED
+        && millis() - start <= connectTimeout)
+  {
+    delay(10);
+  }
+  return WiFi.status();
+}
+
+/**
+ * mDNS announcements and queries
+ */
+typedef struct
+{
+  String hostname;
+  IPAddress ip;
+  uint16_t port;
+} fakeAnnouncement;
+
+static std::vector<fakeAnnouncement> announcements;
+
+struct mdns_search_once_s
+{
+  String name;
+  uint16_t type;
+  uint32_t doneAt;
+  size_t maxResults;
+};
+
+MDNSResponder MDNS;
+
+void fakeAnnounce(const char * hostname, IPAddress ip, uint16_t port)
+{
+  announcements.push_back({ String(hostname), ip, port });
+}
+
+void fakeClearAnnouncements(void)
+{
+  announcements.clear();
+}
+
+/**
+ * Announcements matching a query, A queries match the host name
+ */
+static size_t matching(mdns_search_once_t * search)
+{
+  size_t count = 0;
+  for(auto & a : announcements)
+  {
+    if(search->type != MDNS_TYPE_A || a.hostname == search->name)
+    {
+      count++;
+    }
+  }
+  return count;
+}
+
+mdns_search_once_t * mdns_query_async_new(const char * name, const char * serviceType, const char * proto,
+                                          uint16_t type, uint32_t timeout, size_t maxResults,
+                                          void * notifier)
+{
+  return new mdns_search_once_t { String(name != nullptr ? name : ""), type, millis() + timeout, maxResults };
+}
+
+bool mdns_query_async_get_results(mdns_search_once_t * search, uint32_t timeout,
+                                  mdns_result_t ** results, uint8_t * numResults)
+{
+  if(matching(search) < search->maxResults && (int32_t) (millis() - search->doneAt) < 0)
+  {
+    return false;
+  }
+
+  mdns_result_t ** last = results;
+  *results = nullptr;
+  *numResults = 0;
+  for(auto & a : announcements)
+  {
+    if(*numResults == search->maxResults || (search->type == MDNS_TYPE_A && a.hostname != search->name))
+    {
+      continue;
+    }
+    mdns_result_t * r = (mdns_result_t *) calloc(1, sizeof(mdns_result_t));
+    r->hostname = strdup(a.hostname.c_str());
+    r->port = a.port;
+    r->addr = (mdns_ip_addr_t *) calloc(1, sizeof(mdns_ip_addr_t));
+    r->addr->addr.type = ESP_IPADDR_TYPE_V4;
+    r->addr->addr.u_addr.ip4.addr = (uint32_t) a.ip;
+    *last = r;
+    last = &r->next;
+    (*numResults)++;
+  }
+  return true;
+}
+
+esp_err_t mdns_query_async_delete(mdns_search_once_t * search)
+{
+  delete search;
+  return ESP_OK;
+}
+
+void mdns_query_results_free(mdns_result_t * results)
+{
+  while(results != nullptr)
+  {
+    mdns_result_t * next = results->next;
+    free(results->hostname);
+    free(results->addr);
+    free(results);
+    results = next;
+  }
+}
+
+/**
+ * DNS through the host's resolver, answers are always "in the cache"
+ */
+err_t dns_gethostbyname(const char * hostname, ip_addr_t * addr, dns_found_callback found, void * callbackArg)
+{
+  struct addrinfo hints;
+  struct addrinfo * result = nullptr;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  if(getaddrinfo(hostname, nullptr, &hints, &result) != 0 || result == nullptr)
+  {
+    return ERR_ARG;
+  }
+  addr->type = IPADDR_TYPE_V4;
+  addr->u_addr.ip4.addr = ((struct sockaddr_in *) result->ai_addr)->sin_addr.s_addr;
+  freeaddrinfo(result);
+  return ERR_OK;
+}
+
+err_t tcpip_api_call(tcpip_api_call_fn fn, struct tcpip_api_call_data * call)
+{
+  return fn(call);
+}
+
+/**
+ * UDP broadcasts are only counted
+ */
+uint32_t fakeBroadcasts = 0;
+
+size_t AsyncUDP::broadcastTo(uint8_t * data, size_t length, uint16_t port)
+{
+  fakeBroadcasts++;
+  return length;
+}
@@ -0,0 +1,198 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file runs web requests handed over by the tests and records the
+ * responses.
+ */
+
+#include <WebServer.h>
+
+void WebServer::on(const String & uri, HTTPMethod method, THandlerFunction handler)
+{
+  routes.push_back({ uri, method, handler });
+}
+
+void WebServer::collectHeaders(const char * headerKeys[], const size_t headerKeysCount)
+{
+  collectedHeaders.clear();
+  for(size_t i = 0; i < headerKeysCount; i++)
+  {
+    collectedHeaders.push_back(String(headerKeys[i]));
+  }
+}
+
+String WebServer::arg(const String & name) const
+{
+  for(auto & a : requestArgs)
+  {
+    if(a.first == name)
+    {
+      return a.second;
+    }
+  }
+  return String("");
+}
+
+String WebServer::arg(int i) const
+{
+  return i >= 0 && i < args() ? requestArgs[i].second : String("");
+}
+
+String WebServer::argName(int i) const
+{
+  return i >= 0 && i < args() ? requestArgs[i].first : String("");
+}
+
+bool WebServer::hasArg(const String & name) const
+{
+  for(auto & a : requestArgs)
+  {
+    if(a.first == name)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Only headers asked for through collectHeaders() are kept, like the real server
+ */
+String WebServer::header(const String & name) const
+{
+  for(auto & h : requestHeaders)
+  {
+    if(h.first == name)
+    {
+      for(auto & c : collectedHeaders)
+      {
+        if(c == name)
+        {
+          return h.second;
+        }
+      }
+    }
+  }
+  return String("");
+}
+
+uint32_t WebServer::elapsedMicros(void) const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - requestStart).count();
+}
+
+void WebServer::sendHeader(const String & name, const String & value, bool first)
+{
+  if(first)
+  {
+    pendingHeaders.insert(pendingHeaders.begin(), std::make_pair(name, value));
+  }
+  else
+  {
+    pendingHeaders.push_back(std::make_pair(name, value));
+  }
+}
+
+void WebServer::send(int code, const char * contentType, const String & content)
+{
+  response.firstByteMicros = elapsedMicros();
+  response.code = code;
+  response.contentType = contentType != nullptr ? contentType : "";
+  response.headers = pendingHeaders;
+  pendingHeaders.clear();
+  response.chunked = contentLength_ == CONTENT_LENGTH_UNKNOWN;
+  contentLength_ = CONTENT_LENGTH_NOT_SET;
+  if(content.length() > 0)
+  {
+    response.length += content.length();
+    response.chunkCount++;
+    if(!discardBody)
+    {
+      response.chunks.push_back(content);
+      response.body += content;
+    }
+  }
+  response.lastByteMicros = elapsedMicros();
+}
+
+void WebServer::send_P(int code, const char * contentType, const char * content, size_t contentLength)
+{
+  send(code, contentType);
+  sendContent(content, contentLength);
+}
+
+void WebServer::sendContent(const char * content, size_t contentLength)
+{
+  response.length += contentLength;
+  response.chunkCount += contentLength > 0 ? 1 : 0;
+  if(!discardBody)
+  {
+    String chunk;
+    chunk.concat(content, contentLength);
+    response.chunks.push_back(chunk);
+    response.body += chunk;
+  }
+  response.lastByteMicros = elapsedMicros();
+}
+
+fakeResponse WebServer::request(const String & uri, HTTPMethod method,
+                                const std::vector<std::pair<String, String>> & arguments,
+                                const std::vector<std::pair<String, String>> & headers)
+{
+  requestUri = uri;
+  requestMethod = method;
+  requestArgs = arguments;
+  requestHeaders = headers;
+  pendingHeaders.clear();
+  contentLength_ = CONTENT_LENGTH_NOT_SET;
+  response = fakeResponse();
+  response.code = 0;
+  response.chunked = false;
+  response.firstByteMicros = 0;
+  response.lastByteMicros = 0;
+  response.length = response.chunkCount = 0;
+  requestStart = std::chrono::steady_clock::now();
+
+  THandlerFunction handler = notFoundHandler;
+  for(auto & r : routes)
+  {
+    if(r.uri == uri && (r.method == HTTP_ANY || r.method == method))
+    {
+      handler = r.handler;
+      break;
+    }
+  }
+  if(handler)
+  {
+    handler();
+  }
+  else
+  {
+    send(404, "text/plain", String("Not found: ") + uri);
+  }
+  return response;
+}
+
+std::vector<String> WebServer::paths(void) const
+{
+  std::vector<String> result;
+  for(auto & r : routes)
+  {
+    result.push_back(r.uri);
+  }
+  return result;
+}
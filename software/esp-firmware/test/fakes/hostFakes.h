@@ -0,0 +1,150 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file lets the host tests control the simulated hardware, network and
+ * clock behind the fake Arduino libraries.
+ *
+ * The clock is simulated by default: it only moves when the main loop waits
+ * for an event, calls delay() or a test calls fakeAdvance(), and every
+ * Ticker and A/D converter block due meanwhile is run on the way, so tests
+ * are deterministic and take no real time. Tests talking to a real server
+ * on the host switch to real time with fakeUseRealTime().
+ */
+
+#ifndef _HOST_FAKES_H_
+#define _HOST_FAKES_H_
+
+#include <Arduino.h>
+#include <atomic>
+#include <vector>
+
+#include "IPAddress.h"
+
+/**
+ * Let millis() follow the host clock and waits take real time
+ */
+void fakeUseRealTime(bool realTime);
+
+/**
+ * Move the simulated clock forward, running all Tickers and A/D converter
+ * blocks due meanwhile (sleeps in real time mode)
+ */
+void fakeAdvance(uint32_t ms);
+
+/**
+ * Set the level of an input pin (keys are active low, the default is HIGH)
+ */
+void fakeSetInput(uint8_t pin, int level);
+
+/**
+ * Level last written to an output pin
+ */
+int fakeGetOutput(uint8_t pin);
+
+/**
+ * Mode last set for a pin, 0 if never set
+ */
+uint8_t fakeGetPinMode(uint8_t pin);
+
+/**
+ * Averaged values reported for a pin by the following A/D converter blocks
+ */
+void fakeSetAnalog(uint8_t pin, uint16_t raw, uint16_t milliVolts);
+
+/**
+ * Period of the A/D converter blocks in ms, 0 if continuous conversion is not running
+ */
+uint32_t fakeAnalogPeriod(void);
+
+/**
+ * Number of A/D converter blocks completed so far
+ */
+extern uint32_t fakeAnalogBlocks;
+
+/**
+ * Add a network the simulated WiFi station can see and connect to
+ */
+void fakeAddNetwork(const char * ssid, const char * key, int8_t rssi = -60, int32_t channel = 6);
+
+/**
+ * Remove all networks and disconnect
+ */
+void fakeClearNetworks(void);
+
+/**
+ * Lose the connection to the current network, like walking out of range
+ */
+void fakeWiFiDrop(void);
+
+/**
+ * Simulated time a connection to an access point and a scan of all channels take in ms
+ */
+extern uint32_t fakeWiFiConnectMs;
+extern uint32_t fakeWiFiScanMs;
+
+/**
+ * Add a wiThrottle server answering mDNS queries
+ */
+void fakeAnnounce(const char * hostname, IPAddress ip, uint16_t port);
+
+/**
+ * Remove all mDNS announcements
+ */
+void fakeClearAnnouncements(void);
+
+/**
+ * Traffic of all WiFiClient connections
+ */
+extern std::atomic<uint32_t> fakeClientBytesWritten;
+extern std::atomic<uint32_t> fakeClientWrites;
+extern std::atomic<uint32_t> fakeClientBytesRead;
+
+/**
+ * Contents of a file in the simulated file system, empty if it does not exist
+ */
+String fakeReadFile(const char * path);
+
+/**
+ * Create or replace a file in the simulated file system
+ */
+void fakeWriteFile(const char * path, const String & contents);
+
+/**
+ * Remove all files
+ */
+void fakeFormat(void);
+
+/**
+ * Number of calls to ESP.restart(), ESP.deepSleep() and AsyncUDP broadcasts
+ */
+extern uint32_t fakeRestarts;
+extern uint32_t fakeDeepSleeps;
+extern uint32_t fakeBroadcasts;
+
+/**
+ * Tasks created through xTaskCreate(), they are recorded but never started
+ */
+typedef struct
+{
+  String name;
+  TaskFunction_t code;
+  UBaseType_t priority;
+} fakeTask;
+
+extern std::vector<fakeTask> fakeTasks;
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the lwIP thread API, there is no
+ * lwIP thread so calls are run directly.
+ */
+
+#ifndef _FAKE_LWIP_TCPIP_PRIV_H_
+#define _FAKE_LWIP_TCPIP_PRIV_H_
+
+#include "lwip/dns.h"
+
+struct tcpip_api_call_data
+{
+  err_t err;
+};
+
+typedef err_t (*tcpip_api_call_fn)(struct tcpip_api_call_data * call);
+
+err_t tcpip_api_call(tcpip_api_call_fn fn, struct tcpip_api_call_data * call);
+
+#endif
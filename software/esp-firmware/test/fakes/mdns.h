@@ -0,0 +1,82 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is the host replacement for the ESP-IDF mDNS query API. Queries
+ * are answered from the announcements added by the tests, they complete
+ * once the requested number of results is there or at their timeout.
+ */
+
+#ifndef _FAKE_MDNS_H_
+#define _FAKE_MDNS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+#define MDNS_TYPE_A    0x0001
+#define MDNS_TYPE_PTR  0x000C
+#define MDNS_TYPE_TXT  0x0010
+#define MDNS_TYPE_AAAA 0x001C
+#define MDNS_TYPE_SRV  0x0021
+
+#define ESP_IPADDR_TYPE_V4 0U
+#define ESP_IPADDR_TYPE_V6 6U
+
+typedef struct { uint32_t addr; } esp_ip4_addr_t;
+typedef struct { uint32_t addr[4]; uint8_t zone; } esp_ip6_addr_t;
+
+typedef struct
+{
+  union
+  {
+    esp_ip6_addr_t ip6;
+    esp_ip4_addr_t ip4;
+  } u_addr;
+  uint8_t type;
+} esp_ip_addr_t;
+
+typedef struct mdns_ip_addr_s
+{
+  esp_ip_addr_t addr;
+  struct mdns_ip_addr_s * next;
+} mdns_ip_addr_t;
+
+typedef struct mdns_result_s
+{
+  struct mdns_result_s * next;
+  char * instance_name;
+  char * service_type;
+  char * proto;
+  char * hostname;
+  uint16_t port;
+  mdns_ip_addr_t * addr;
+} mdns_result_t;
+
+typedef struct mdns_search_once_s mdns_search_once_t;
+
+mdns_search_once_t * mdns_query_async_new(const char * name, const char * serviceType, const char * proto,
+                                          uint16_t type, uint32_t timeout, size_t maxResults,
+                                          void * notifier);
+bool mdns_query_async_get_results(mdns_search_once_t * search, uint32_t timeout,
+                                  mdns_result_t ** results, uint8_t * numResults);
+esp_err_t mdns_query_async_delete(mdns_search_once_t * search);
+void mdns_query_results_free(mdns_result_t * results);
+
+#endif
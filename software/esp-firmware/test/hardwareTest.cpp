@@ -0,0 +1,193 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file tests the key, LED and A/D converter access of hardware.cpp
+ * against the simulated pins, and the simulated clock, file system and
+ * sockets the other host tests build on.
+ */
+
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <Ticker.h>
+#include <WiFiClient.h>
+#include <lwip/sockets.h>
+
+#include "hardware.h"
+#include "eventHandling.h"
+#include "hostFakes.h"
+#include "testing.h"
+
+TEST(keysAreActiveLow)
+{
+  initHardware();
+  CHECK_EQUAL(INPUT_PULLUP, fakeGetPinMode(KEY_PIN[KEY_ESTOP]));
+  CHECK_EQUAL(INPUT, fakeGetPinMode(KEY_PIN[KEY_LOCO1]));
+  CHECK_EQUAL(OUTPUT, fakeGetPinMode(LED_STOP));
+
+  CHECK(!readKey(KEY_ESTOP));
+  fakeSetInput(KEY_PIN[KEY_ESTOP], LOW);
+  CHECK(readKey(KEY_ESTOP));
+  fakeSetInput(KEY_PIN[KEY_ESTOP], HIGH);
+  CHECK(!readKey(KEY_ESTOP));
+}
+
+TEST(ledsAreActiveLowFlashlightActiveHigh)
+{
+  initHardware();
+  setLED(LED_FWD, true);
+  CHECK_EQUAL(LOW, fakeGetOutput(LED_FWD));
+  setLED(LED_FWD, false);
+  CHECK_EQUAL(HIGH, fakeGetOutput(LED_FWD));
+  setFlashlight(true);
+  CHECK_EQUAL(HIGH, fakeGetOutput(FLASHLIGHT));
+  setFlashlight(false);
+  CHECK_EQUAL(LOW, fakeGetOutput(FLASHLIGHT));
+}
+
+static uint32_t blocksSignalled = 0;
+
+static void onBlockReady(void)
+{
+  blocksSignalled++;
+  postEventFromISR();
+}
+
+TEST(analogBlocksArriveEvery64ms)
+{
+  uint16_t poti = 0;
+  uint16_t batt = 0;
+
+  initEvents();
+  fakeSetAnalog(ANALOG_PIN_POTI, 2345, 1500);
+  fakeSetAnalog(ANALOG_PIN_VBATT, 3000, 1900);
+  startAnalogSampling(onBlockReady);
+  CHECK_EQUAL(2 * ADC_CONVERSIONS_PER_PIN * 1000 / ADC_SAMPLE_FREQ_HZ, fakeAnalogPeriod());
+
+  uint32_t start = millis();
+  CHECK(!readAnalogBlock(poti, batt));
+  fakeAdvance(63);
+  CHECK_EQUAL(0, blocksSignalled);
+  fakeAdvance(1);
+  CHECK_EQUAL(1, blocksSignalled);
+  CHECK_EQUAL(1, ulTaskNotifyTake(pdTRUE, 0));
+  CHECK(readAnalogBlock(poti, batt));
+  CHECK_EQUAL(2345, poti);
+  CHECK_EQUAL(1900, batt);
+  CHECK(!readAnalogBlock(poti, batt));
+
+  // the main loop sleeps until the next block wakes it up
+  fakeSetAnalog(ANALOG_PIN_POTI, 100, 80);
+  uint32_t woken = 0;
+  while(woken == 0)
+  {
+    woken = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOOP_MAX_WAIT_MS));
+  }
+  CHECK_EQUAL(start + 128, millis());
+  CHECK(readAnalogBlock(poti, batt));
+  CHECK_EQUAL(100, poti);
+}
+
+static uint32_t tickerRuns = 0;
+
+static void countTicker(int step)
+{
+  tickerRuns += step;
+}
+
+TEST(tickersRunInSimulatedTime)
+{
+  Ticker periodic;
+  Ticker once;
+
+  tickerRuns = 0;
+  periodic.attach_ms(10, countTicker, 1);
+  once.once_ms(25, countTicker, 100);
+  fakeAdvance(50);
+  CHECK_EQUAL(105, tickerRuns);
+  CHECK(!once.active());
+  periodic.detach();
+  fakeAdvance(50);
+  CHECK_EQUAL(105, tickerRuns);
+}
+
+TEST(filesAreKeptInMemory)
+{
+  fakeFormat();
+  CHECK(!SPIFFS.open("/config.txt", "r"));
+  CHECK(SPIFFS.begin(true));
+  if(File f = SPIFFS.open("/config.txt", "w"))
+  {
+    f.print("{\"centerSwitch\":");
+    f.print(2);
+    f.print("}");
+    f.close();
+  }
+  CHECK(SPIFFS.exists("/config.txt"));
+  File f = SPIFFS.open("/config.txt", "r");
+  CHECK(f);
+  CHECK(f.readString() == "{\"centerSwitch\":2}");
+  SPIFFS.end();
+  CHECK(fakeReadFile("/config.txt") == "{\"centerSwitch\":2}");
+}
+
+TEST(clientTalksToHostSockets)
+{
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in address;
+  socklen_t length = sizeof(address);
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  CHECK(bind(listener, (struct sockaddr *) &address, sizeof(address)) == 0);
+  CHECK(listen(listener, 1) == 0);
+  getsockname(listener, (struct sockaddr *) &address, &length);
+
+  WiFiClient client;
+  CHECK(client.connect(IPAddress(127, 0, 0, 1), ntohs(address.sin_port)));
+  int server = accept(listener, nullptr, nullptr);
+  CHECK(server >= 0);
+
+  uint32_t written = fakeClientBytesWritten;
+  client.print("*+\r\n");
+  CHECK_EQUAL(written + 4, fakeClientBytesWritten);
+  char received[8] = { 0 };
+  CHECK_EQUAL(4, recv(server, received, sizeof(received), 0));
+  CHECK(!strcmp(received, "*+\r\n"));
+
+  CHECK_EQUAL(0, client.available());
+  send(server, "*10\n", 4, 0);
+  while(client.available() < 4)
+  {
+    usleep(1000);
+  }
+  uint8_t answer[4];
+  CHECK_EQUAL(4, client.read(answer, sizeof(answer)));
+  CHECK(!memcmp(answer, "*10\n", 4));
+
+  // copies share the connection, like the firmware's WiFiClient does
+  WiFiClient copy = client;
+  CHECK(copy.connected());
+  close(server);
+  usleep(10000);
+  CHECK(!client.connected());
+  close(listener);
+}
+
+int main(void)
+{
+  return runTests();
+}
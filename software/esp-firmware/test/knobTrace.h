@@ -0,0 +1,128 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file reads the speed knob traces in traces/ for the tests replaying
+ * them: one row per 10 ms with the raw A/D value of the potentiometer.
+ */
+
+#ifndef _KNOB_TRACE_H_
+#define _KNOB_TRACE_H_
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+typedef struct
+{
+  uint32_t ms;
+  uint16_t raw;
+} traceSample;
+
+/**
+ * Names of the regular traces in traces/
+ */
+static const char * const KNOB_TRACES[] = { "fastTwist", "slowSweep", "shunting", "backAndForth", "resting" };
+
+/**
+ * Traces of a worn potentiometer with much more noise and contact spikes
+ */
+static const char * const NOISY_KNOB_TRACES[] = { "wornPotResting", "wornPotSweep" };
+
+/**
+ * Read traces/<name>.csv, empty if the file is missing
+ */
+static inline std::vector<traceSample> readTrace(const char * name)
+{
+  std::vector<traceSample> trace;
+  std::ifstream file(std::string(TRACE_DIR "/") + name + ".csv");
+  std::string line;
+  while(std::getline(file, line))
+  {
+    unsigned int ms, raw;
+    if(line[0] != '#' && sscanf(line.c_str(), "%u,%u", &ms, &raw) == 2)
+    {
+      trace.push_back({ ms, (uint16_t) raw });
+    }
+  }
+  return trace;
+}
+
+/**
+ * Position the knob comes to rest at: median of the last 20 samples
+ */
+static inline uint16_t finalRaw(const std::vector<traceSample> & trace)
+{
+  std::vector<uint16_t> tail;
+  for(size_t i = trace.size() > 20 ? trace.size() - 20 : 0; i < trace.size(); i++)
+  {
+    tail.push_back(trace[i].raw);
+  }
+  std::sort(tail.begin(), tail.end());
+  return tail[tail.size() / 2];
+}
+
+/**
+ * Time from which the knob stays within tolerance of its final position,
+ * ignoring single spikes
+ */
+static inline uint32_t settleTime(const std::vector<traceSample> & trace, uint16_t tolerance)
+{
+  uint16_t target = finalRaw(trace);
+  uint32_t settled = 0;
+  for(size_t i = 1; i < trace.size(); i++)
+  {
+    bool outside = abs((int) trace[i].raw - target) > tolerance;
+    bool neighbourOutside = abs((int) trace[i - 1].raw - target) > tolerance
+                         || (i + 1 < trace.size() && abs((int) trace[i + 1].raw - target) > tolerance);
+    if(outside && neighbourOutside)
+    {
+      settled = trace[i].ms + 10;
+    }
+  }
+  return settled;
+}
+
+/**
+ * Average the samples of a trace over blocks of the given length, as the
+ * continuous A/D conversion does
+ */
+static inline std::vector<uint16_t> traceBlocks(const std::vector<traceSample> & trace, uint32_t blockMs)
+{
+  std::vector<uint16_t> blocks;
+  uint32_t sum = 0;
+  uint32_t count = 0;
+  uint32_t blockEnd = blockMs;
+  for(const traceSample & sample : trace)
+  {
+    if(sample.ms >= blockEnd && count > 0)
+    {
+      blocks.push_back(sum / count);
+      sum = count = 0;
+      blockEnd += blockMs;
+    }
+    sum += sample.raw;
+    count++;
+  }
+  if(count > 0)
+  {
+    blocks.push_back(sum / count);
+  }
+  return blocks;
+}
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file tests the line splitter with server output arriving in all kinds
+ * of fragments, down to single bytes, like TCP may hand it over.
+ */
+
+#include <Arduino.h>
+#include <Client.h>
+#include <string>
+#include <vector>
+
+#include "lineReader.h"
+#include "testing.h"
+
+/**
+ * Client handing out a recorded stream in fragments of a fixed size,
+ * available() only ever reports the current fragment
+ */
+class fragmentedClient : public Client
+{
+  public:
+    fragmentedClient(const std::string & data, size_t fragment) : data(data), fragment(fragment) {}
+
+    int connect(IPAddress ip, uint16_t port) override { return 1; }
+    int connect(const char * host, uint16_t port) override { return 1; }
+    size_t write(uint8_t c) override { return 1; }
+    size_t write(const uint8_t * buffer, size_t size) override { return size; }
+    int available(void) override
+    {
+      if(left == 0 && position < data.size())
+      {
+        left = std::min(fragment, data.size() - position);
+      }
+      return left;
+    }
+    int read(void) override
+    {
+      uint8_t c;
+      return read(&c, 1) == 1 ? c : -1;
+    }
+    int read(uint8_t * buffer, size_t size) override
+    {
+      size_t n = std::min(size, (size_t) available());
+      memcpy(buffer, data.data() + position, n);
+      position += n;
+      left -= n;
+      return n;
+    }
+    int peek(void) override { return available() > 0 ? (uint8_t) data[position] : -1; }
+    void flush(void) override {}
+    void stop(void) override {}
+    uint8_t connected(void) override { return 1; }
+    operator bool() override { return true; }
+
+    bool done(void) const { return position == data.size(); }
+
+  private:
+    std::string data;
+    size_t fragment;
+    size_t position = 0;
+    size_t left = 0;
+};
+
+/**
+ * Poll the whole stream and collect all lines, at most one poll() per
+ * fragment like the main loop does
+ */
+static std::vector<std::string> readAll(lineReader & reader, fragmentedClient & client)
+{
+  std::vector<std::string> lines;
+  lineView line;
+  do
+  {
+    reader.poll(client);
+    while(reader.nextLine(line))
+    {
+      CHECK_EQUAL(strlen(line.text), line.length);
+      lines.push_back(std::string(line.text, line.length));
+    }
+  } while(!client.done());
+  return lines;
+}
+
+/**
+ * What JMRI sends after connecting and acquiring a loco
+ */
+static const char * const JMRI_SESSION[] =
+{
+  "VN2.0",
+  "RL2]\\[Big Boy}|{4014}|{L]\\[Shunter}|{3}|{S",
+  "PPA1",
+  "PTT]\\[Toggle}|{2]\\[Closed}|{C]\\[Thrown}|{T",
+  "PRT]\\[Routes}|{Route]\\[Active}|{2]\\[Inactive}|{4",
+  "RCC0",
+  "PW12080",
+  "*10",
+  "MT+L4014<;>",
+  "MTAL4014<;>F00",
+  "MTAL4014<;>F01",
+  "MTAL4014<;>V0",
+  "MTAL4014<;>R1",
+  "MTAL4014<;>s1",
+};
+
+/**
+ * What a DCC-EX command station sends in its native wiThrottle mode
+ */
+static const char * const DCCEX_SESSION[] =
+{
+  "VN2.0",
+  "HTDCC-EX",
+  "HtDCC-EX v5.0.0",
+  "PTT]\\[Turnouts}|{Turnout]\\[Closed}|{2]\\[Thrown}|{4",
+  "PPA1",
+  "RL0",
+  "*10",
+  "MT+S3<;>",
+  "MTAS3<;>F00",
+  "MTAS3<;>V0",
+  "MTAS3<;>R1",
+  "MTAS3<;>s0",
+  "MTAS3<;>V42",
+};
+
+static std::string join(const char * const * lines, size_t count, const char * lineEnd)
+{
+  std::string text;
+  for(size_t i = 0; i < count; i++)
+  {
+    text += lines[i];
+    text += lineEnd;
+  }
+  return text;
+}
+
+TEST(splitsServerOutputInAnyFragments)
+{
+  for(const char * lineEnd : { "\n", "\r\n" })
+  {
+    std::string jmri = join(JMRI_SESSION, sizeof(JMRI_SESSION) / sizeof(JMRI_SESSION[0]), lineEnd);
+    std::string dccex = join(DCCEX_SESSION, sizeof(DCCEX_SESSION) / sizeof(DCCEX_SESSION[0]), lineEnd);
+
+    for(size_t fragment = 1; fragment <= jmri.size(); fragment++)
+    {
+      lineReader reader;
+      fragmentedClient client(jmri + dccex, fragment);
+      std::vector<std::string> lines = readAll(reader, client);
+
+      CHECK_EQUAL(sizeof(JMRI_SESSION) / sizeof(JMRI_SESSION[0]) + sizeof(DCCEX_SESSION) / sizeof(DCCEX_SESSION[0]), lines.size());
+      for(size_t i = 0; i < lines.size(); i++)
+      {
+        const char * expected = i < sizeof(JMRI_SESSION) / sizeof(JMRI_SESSION[0]) ? JMRI_SESSION[i]
+                                : DCCEX_SESSION[i - sizeof(JMRI_SESSION) / sizeof(JMRI_SESSION[0])];
+        CHECK(lines[i] == expected);
+      }
+      CHECK_EQUAL(0, reader.droppedLines);
+    }
+  }
+}
+
+TEST(onlyStripsTheCarriageReturnAtTheLineEnd)
+{
+  lineReader reader;
+  fragmentedClient client("\r\nMTAL4014<;>V1\r2\r\n\n", 1);
+  std::vector<std::string> lines = readAll(reader, client);
+
+  CHECK_EQUAL(3, lines.size());
+  CHECK(lines[0] == "");
+  CHECK(lines[1] == "MTAL4014<;>V1\r2");
+  CHECK(lines[2] == "");
+}
+
+TEST(dropsOverlongLines)
+{
+  // a roster of a large layout, longer than the buffer
+  std::string roster = "RL400";
+  for(int i = 0; roster.size() < 3 * LINE_BUFFER_SIZE; i++)
+  {
+    roster += "]\\[Loco " + std::to_string(i) + "}|{" + std::to_string(1000 + i) + "}|{L";
+  }
+
+  for(size_t fragment : { (size_t) 1, (size_t) 7, (size_t) 100, (size_t) LINE_BUFFER_SIZE - 1, (size_t) 4096 })
+  {
+    lineReader reader;
+    fragmentedClient client("VN2.0\r\n" + roster + "\r\n*10\r\n" + roster + "\n" + roster + "\nPW12080\n", fragment);
+    std::vector<std::string> lines = readAll(reader, client);
+
+    CHECK_EQUAL(3, lines.size());
+    CHECK(lines.size() == 3 && lines[0] == "VN2.0" && lines[1] == "*10" && lines[2] == "PW12080");
+    CHECK_EQUAL(3, reader.droppedLines);
+  }
+}
+
+TEST(longestLineFits)
+{
+  // one byte is kept for the terminating zero
+  std::string longest(LINE_BUFFER_SIZE - 2, 'x');
+
+  lineReader reader;
+  fragmentedClient client(std::string("*10\n") + longest + "\n*10\n", 13);
+  std::vector<std::string> lines = readAll(reader, client);
+
+  CHECK_EQUAL(3, lines.size());
+  CHECK(lines.size() == 3 && lines[1] == longest);
+  CHECK_EQUAL(0, reader.droppedLines);
+}
+
+TEST(compactsPartialLinesToTheFront)
+{
+  // many times the buffer size, with lines straddling every buffer boundary
+  std::string stream;
+  size_t count = 0;
+  while(stream.size() < 40 * LINE_BUFFER_SIZE)
+  {
+    stream += "MTAL" + std::to_string(1000 + count % 9000) + "<;>V" + std::to_string(count % 127) + "\n";
+    count++;
+  }
+
+  for(size_t fragment : { (size_t) 1, (size_t) 333, (size_t) LINE_BUFFER_SIZE, (size_t) 3 * LINE_BUFFER_SIZE })
+  {
+    lineReader reader;
+    fragmentedClient client(stream, fragment);
+    std::vector<std::string> lines = readAll(reader, client);
+
+    CHECK_EQUAL(count, lines.size());
+    for(size_t i = 0; i < lines.size(); i += 97)
+    {
+      CHECK(lines[i] == "MTAL" + std::to_string(1000 + i % 9000) + "<;>V" + std::to_string(i % 127));
+    }
+    CHECK_EQUAL(0, reader.droppedLines);
+  }
+}
+
+TEST(feedKeepsWhatFits)
+{
+  lineReader reader;
+  lineView line;
+  std::string full(LINE_BUFFER_SIZE - 5, 'a');
+  full += "\n";
+
+  CHECK_EQUAL(full.size(), reader.feed(full.data(), full.size()));
+  // only three bytes left (one is kept for the terminating zero)
+  CHECK_EQUAL(3, reader.feed("*10\n", 4));
+  CHECK(reader.nextLine(line));
+  CHECK_EQUAL(LINE_BUFFER_SIZE - 5, line.length);
+  CHECK(!reader.nextLine(line));
+
+  // the consumed line makes room again
+  CHECK_EQUAL(1, reader.feed("\n", 1));
+  CHECK(reader.nextLine(line));
+  CHECK(!strcmp(line.text, "*10"));
+}
+
+int main(void)
+{
+  return runTests();
+}
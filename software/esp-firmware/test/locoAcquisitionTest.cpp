@@ -0,0 +1,90 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file measures the time from switching locos on until all of them
+ * are drivable, with the firmware talking to the wiThrottle stand-in.
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+
+#include "standIn.h"
+#include "testing.h"
+
+static uint16_t port;
+
+static bool allLocosIn(eLocoState target, uint8_t count)
+{
+  for(uint8_t l = 0; l < count; l++)
+  {
+    if(locoState[l] != target)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Switch the first count locos on and return the ms until all are drivable
+ */
+static uint32_t timeToDrivable(uint8_t count)
+{
+  uint32_t start = millis();
+  for(uint8_t l = 0; l < count; l++)
+  {
+    setLocoSwitch(l, true);
+  }
+  CHECK(loopUntil([count]() { return allLocosIn(LOCO_ACTIVE, count); }, 5000));
+  uint32_t duration = millis() - start;
+
+  for(uint8_t l = 0; l < count; l++)
+  {
+    setLocoSwitch(l, false);
+  }
+  CHECK(loopUntil([count]() { return allLocosIn(LOCO_INACTIVE, count); }, 2000));
+  return duration;
+}
+
+TEST(connectsToTheStandIn)
+{
+  port = startStandIn();
+  CHECK(port != 0);
+  CHECK(bootOnline(port));
+}
+
+TEST(locosAreAcquiredInParallel)
+{
+  uint32_t duration[5];
+  for(uint8_t count = 1; count <= 4; count++)
+  {
+    // best of three, the stand-in and the test share the machine
+    duration[count] = UINT32_MAX;
+    for(int round = 0; round < 3; round++)
+    {
+      duration[count] = std::min(duration[count], timeToDrivable(count));
+    }
+    report(("timeToDrivable" + std::to_string(count) + "Locos").c_str(), duration[count], "ms");
+  }
+  CHECK(duration[4] < 2 * duration[1] + 50);
+  stopStandIn();
+}
+
+int main(void)
+{
+  return runTests();
+}
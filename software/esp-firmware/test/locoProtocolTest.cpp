@@ -0,0 +1,169 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file measures the protocol behaviour of the firmware against the
+ * wiThrottle stand-in: time from moving the speed knob until the command is
+ * on the wire, bytes and writes per operation, and how this changes when
+ * hundreds of simulated throttles share the server.
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "standIn.h"
+#include "testing.h"
+
+/**
+ * Number of throttles simulated by the stand-in for the load test
+ */
+#define SIMULATED_THROTTLES 200
+#define SIMULATION_SECONDS "8"
+
+static uint16_t port;
+
+static uint32_t median(std::vector<uint32_t> values)
+{
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+/**
+ * Move the knob to a new position a number of times and measure the ms until
+ * each speed command has been written to the server
+ */
+static std::vector<uint32_t> knobToWire(int moves)
+{
+  std::vector<uint32_t> latency;
+  for(int i = 0; i < moves; i++)
+  {
+    // let the previous command come back so the holdoff does not add up
+    loopUntil([]() { return false; }, 200);
+    uint32_t sent = speedCommandsSent;
+    uint32_t start = millis();
+    fakeSetAnalog(ANALOG_PIN_POTI, knobRaw(i % 2 ? 20 : 80), 0);
+    if(loopUntil([sent]() { return speedCommandsSent != sent; }, 2000))
+    {
+      latency.push_back(millis() - start);
+    }
+  }
+  fakeSetAnalog(ANALOG_PIN_POTI, knobRaw(0), 0);
+  loopUntil([]() { return false; }, 300);
+  return latency;
+}
+
+/**
+ * Wire cost of one operation: bytes and writes from start() until the
+ * firmware has been idle for a while
+ */
+static void reportWireCost(const char * name, std::function<void(void)> start)
+{
+  uint32_t bytes = fakeClientBytesWritten;
+  uint32_t writes = fakeClientWrites;
+  uint32_t commands = txCommandCount;
+  start();
+  loopUntil([]() { return false; }, 300);
+  CHECK(txCommandCount > commands);
+  report((std::string(name) + "Bytes").c_str(), fakeClientBytesWritten - bytes, "bytes");
+  report((std::string(name) + "Writes").c_str(), fakeClientWrites - writes, "writes");
+  report((std::string(name) + "Commands").c_str(), txCommandCount - commands, "commands");
+}
+
+static void pressKey(keys key)
+{
+  fakeSetInput(KEY_PIN[key], LOW);
+  loopUntil([]() { return false; }, 100);
+  fakeSetInput(KEY_PIN[key], HIGH);
+}
+
+TEST(acquiresALocoFromTheStandIn)
+{
+  port = startStandIn();
+  CHECK(port != 0);
+  CHECK(bootOnline(port));
+  setLocoSwitch(0, true);
+  CHECK(loopUntil([]() { return locoState[0] == LOCO_ACTIVE; }, 2000));
+}
+
+TEST(knobToWireLatency)
+{
+  std::vector<uint32_t> latency = knobToWire(20);
+  CHECK_EQUAL(20, latency.size());
+  report("knobToWireMedian", median(latency), "ms");
+  report("knobToWireMax", *std::max_element(latency.begin(), latency.end()), "ms");
+  report("speedRoundTrip", speedRoundTrip, "ms");
+}
+
+TEST(wireCostPerOperation)
+{
+  reportWireCost("speedChange", []() { fakeSetAnalog(ANALOG_PIN_POTI, knobRaw(50), 0); });
+  reportWireCost("stop", []() { fakeSetAnalog(ANALOG_PIN_POTI, knobRaw(0), 0); });
+  reportWireCost("function", []() { pressKey(KEY_F1); });
+  reportWireCost("reverse", []() { pressKey(KEY_REV); });
+  reportWireCost("forward", []() { pressKey(KEY_FWD); });
+  reportWireCost("acquireSecondLoco", []() { setLocoSwitch(1, true); });
+  CHECK(locoState[1] == LOCO_ACTIVE);
+  reportWireCost("releaseSecondLoco", []() { setLocoSwitch(1, false); });
+}
+
+TEST(latencyWithHundredsOfThrottles)
+{
+  // move over to a stand-in which is busy with simulated throttles
+  stopStandIn();
+  port = startStandIn({ "--simulate", std::to_string(SIMULATED_THROTTLES), "--duration", SIMULATION_SECONDS },
+                      "standInLoad.txt");
+  CHECK(port != 0);
+  locoServer.port = port;
+  CHECK(loopUntil([]() { return wiFredState == STATE_LOCO_ONLINE && locoState[0] == LOCO_ACTIVE; }, 5000));
+
+  // with few host cores the simulated throttles may starve the firmware,
+  // so commands that do not make it within the timeout are only counted
+  std::vector<uint32_t> latency = knobToWire(10);
+  CHECK(!latency.empty());
+  report("loadedKnobToWireLost", 10 - latency.size(), "commands");
+  if(!latency.empty())
+  {
+    report("loadedKnobToWireMedian", median(latency), "ms");
+    report("loadedKnobToWireMax", *std::max_element(latency.begin(), latency.end()), "ms");
+  }
+  report("loadedSpeedRoundTrip", speedRoundTrip, "ms");
+
+  // the stand-in prints the round trips of its simulated throttles when done
+  waitStandIn();
+  std::ifstream output("standInLoad.txt");
+  std::string line;
+  bool found = false;
+  while(std::getline(output, line))
+  {
+    float median, p99, max;
+    if(sscanf(line.c_str(), " round trip: median %f ms, p99 %f ms, max %f ms", &median, &p99, &max) == 3)
+    {
+      report("simulatedRoundTripMedian", median, "ms");
+      report("simulatedRoundTripP99", p99, "ms");
+      report("simulatedRoundTripMax", max, "ms");
+      found = true;
+    }
+  }
+  CHECK(found);
+}
+
+int main(void)
+{
+  return runTests();
+}
@@ -0,0 +1,267 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file compares building a whole web page in one String before sending
+ * it, as the configuration pages used to do, with streaming it through
+ * pageWriter: peak heap use, allocations and time to the first byte.
+ */
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "eventHandling.h"
+#include "locoHandling.h"
+#include "pageWriter.h"
+#include "stateMachine.h"
+#include "throttleHandling.h"
+#include "allocCounter.h"
+#include "testing.h"
+
+extern WebServer server;
+
+void writeStatePage(void);
+
+/**
+ * The state statistics page as it was built before it was streamed
+ */
+static void stringStatePage(void)
+{
+  uint32_t now = millis();
+
+  String resp = String("<!DOCTYPE HTML>\r\n")
+              + "<html><head><title>wiFred state statistics</title></head>\r\n"
+              + "<body><h1>State machine statistics</h1>\r\n"
+              + "Current state: " + getStateName(wiFredState) + " for " + (now - stateEntered) + " ms, "
+              + "up for " + now + " ms<hr>\r\n"
+              + "<table border=1><tr><th>State</th><th>Entries</th><th>Total time (ms)</th><th>First entered (ms since boot)</th></tr>\r\n";
+
+  for(uint8_t i = 0; i < NUM_STATES; i++)
+  {
+    if(stateStats[i].entries == 0)
+    {
+      continue;
+    }
+    uint32_t totalTime = stateStats[i].totalTime + (i == wiFredState ? now - stateEntered : 0);
+    resp      += String("<tr><td>") + getStateName((state) i) + "</td><td>" + stateStats[i].entries + "</td>"
+              + "<td>" + totalTime + "</td><td>" + stateStats[i].firstEntered + "</td></tr>\r\n";
+  }
+
+  resp        += String("</table><hr>Transitions<hr>\r\n")
+              + "<table border=1><tr><th>From</th><th>To</th><th>Count</th></tr>\r\n";
+
+  for(uint8_t i = 0; i < NUM_STATES; i++)
+  {
+    for(uint8_t j = 0; j < NUM_STATES; j++)
+    {
+      if(stateTransitions[i][j] != 0)
+      {
+        resp  += String("<tr><td>") + getStateName((state) i) + "</td><td>" + getStateName((state) j) + "</td>"
+              + "<td>" + stateTransitions[i][j] + "</td></tr>\r\n";
+      }
+    }
+  }
+
+  resp        += String("</table><hr>Sessions resumed after lost connection: ") + sessionResumes
+              + ", last outage: " + lastOutageTime + " ms\r\n";
+
+  resp        += String("<hr>Speed commands sent: ") + speedCommandsSent
+              + ", not sent because no speed step changed: " + speedCommandsSuppressed + "\r\n";
+
+  resp        += String("<hr>Longest wait of a key or speed event for the main loop: ") + inputLatencyMax + " ms, "
+              + inputQueue.dropped.load() + " events dropped\r\n";
+
+  resp        += String("<hr>Main loop pass duration (longest: ") + loopLatencyMax + " ms)<hr>\r\n"
+              + "<table border=1><tr><th>Duration</th><th>Count</th></tr>\r\n";
+
+  for(uint8_t i = 0; i < LOOP_LATENCY_BUCKETS; i++)
+  {
+    resp      += String("<tr><td>")
+              + (i < LOOP_LATENCY_BUCKETS - 1 ? String("&lt; ") + LOOP_LATENCY_LIMITS[i] : String("&gt;= ") + LOOP_LATENCY_LIMITS[i - 1])
+              + " ms</td><td>" + loopLatency[i] + "</td></tr>\r\n";
+  }
+
+  resp        += String("</table>\r\n")
+              + "<a href=\"/index.html\">Return to main page</a></body></html>";
+
+  server.send(200, "text/html", resp);
+}
+
+/**
+ * The function mapping table, the largest of the former configuration
+ * pages, built in one String ...
+ */
+static void stringFunctionPage(void)
+{
+  uint8_t loco = 1;
+  String resp = String("<!DOCTYPE HTML>\r\n")
+              + "<html><head><title>wiFred configuration page</title></head>\r\n"
+              + "<body><h1>Function mapping for Loco: " + loco + "</h1>\r\n"
+              + "<hr>Function configuration for loco " + loco + " (DCC address: " + locos[loco-1].address + ")<hr>"
+              + "<form action=\"index.html\" method=\"get\"><table border=0>";
+
+  for(uint8_t i=0; i<=MAX_FUNCTION; i++)
+  {
+    resp    += String("<tr style=\"text-align: center");
+    if(i%2)
+    {
+      resp  += String("; background-color: #eee");
+    }
+    resp += String("\"><td>F") + i + "</td>";
+    for(uint8_t j=THROTTLE; j<=IGNORE; j++)
+    {
+      resp += String("<td><input type=\"radio\" name=\"f") + i + "\" value=\"" + j + "\""
+           + (locos[loco-1].functions[i] == j ? " checked" : "" ) + "></td>";
+    }
+    resp    += String("</tr>");
+  }
+  resp      += String("<tr><td colspan=4><input type=\"hidden\" name=\"loco\" value=\"") + loco + "\"><input type=\"submit\" value=\"Save\"></td></tr></table></form>\r\n"
+            + "<hr><a href=\"/\">Back to main configuration page</a><hr></body></html>";
+  server.send(200, "text/html", resp);
+}
+
+/**
+ * ... and streamed
+ */
+static void streamedFunctionPage(void)
+{
+  uint8_t loco = 1;
+  pageWriter page(server, "text/html");
+  page.printf("<!DOCTYPE HTML>\r\n"
+              "<html><head><title>wiFred configuration page</title></head>\r\n"
+              "<body><h1>Function mapping for Loco: %u</h1>\r\n"
+              "<hr>Function configuration for loco %u (DCC address: %d)<hr>"
+              "<form action=\"index.html\" method=\"get\"><table border=0>", loco, loco, locos[loco-1].address);
+
+  for(uint8_t i=0; i<=MAX_FUNCTION; i++)
+  {
+    page.printf("<tr style=\"text-align: center%s\"><td>F%u</td>", i%2 ? "; background-color: #eee" : "", i);
+    for(uint8_t j=THROTTLE; j<=IGNORE; j++)
+    {
+      page.printf("<td><input type=\"radio\" name=\"f%u\" value=\"%u\"%s></td>",
+                  i, j, locos[loco-1].functions[i] == j ? " checked" : "");
+    }
+    page.print("</tr>");
+  }
+  page.printf("<tr><td colspan=4><input type=\"hidden\" name=\"loco\" value=\"%u\"><input type=\"submit\" value=\"Save\"></td></tr></table></form>\r\n"
+              "<hr><a href=\"/\">Back to main configuration page</a><hr></body></html>", loco);
+  page.end();
+}
+
+typedef struct
+{
+  long peakBytes;
+  size_t allocations;
+  uint32_t firstByteMicros;
+  uint32_t lastByteMicros;
+  size_t length;
+  size_t chunks;
+} pageCost;
+
+/**
+ * Heap use of the handler alone (not of the request around it)
+ * and the best time of a number of requests
+ */
+static pageCost measure(const char * uri, std::function<void(void)> handler)
+{
+  server.on(uri, [handler]() {
+    resetAllocations();
+    handler();
+    counting = false;
+  });
+  server.discardBodies(true);
+
+  pageCost cost = { 0, 0, UINT32_MAX, UINT32_MAX, 0, 0 };
+  for(int i = 0; i < 50; i++)
+  {
+    fakeResponse response = server.request(uri);
+    CHECK_EQUAL(200, response.code);
+    cost.firstByteMicros = std::min(cost.firstByteMicros, response.firstByteMicros);
+    cost.lastByteMicros = std::min(cost.lastByteMicros, response.lastByteMicros);
+    cost.peakBytes = peakBytes;
+    cost.allocations = allocations;
+    cost.length = response.length;
+    cost.chunks = response.chunkCount;
+  }
+  server.discardBodies(false);
+  return cost;
+}
+
+static void compare(const char * name, std::function<void(void)> stringPage, std::function<void(void)> streamedPage)
+{
+  // same page either way
+  std::string prefix = name;
+  server.on(("/compareString" + prefix).c_str(), stringPage);
+  server.on(("/compareStreamed" + prefix).c_str(), streamedPage);
+  fakeResponse built = server.request(("/compareString" + prefix).c_str());
+  fakeResponse streamed = server.request(("/compareStreamed" + prefix).c_str());
+  CHECK(built.body.length() > 0);
+  CHECK(built.body == streamed.body);
+  CHECK(!built.chunked);
+  CHECK(streamed.chunked);
+
+  pageCost string = measure((std::string("/string") + name).c_str(), stringPage);
+  pageCost stream = measure((std::string("/streamed") + name).c_str(), streamedPage);
+
+  report((prefix + "Bytes").c_str(), string.length, "bytes");
+  report((prefix + "StringPeakHeap").c_str(), string.peakBytes, "bytes");
+  report((prefix + "StreamedPeakHeap").c_str(), stream.peakBytes, "bytes");
+  report((prefix + "StringAllocations").c_str(), string.allocations, "allocations");
+  report((prefix + "StreamedAllocations").c_str(), stream.allocations, "allocations");
+  report((prefix + "StringFirstByte").c_str(), string.firstByteMicros, "us");
+  report((prefix + "StreamedFirstByte").c_str(), stream.firstByteMicros, "us");
+  report((prefix + "StringLastByte").c_str(), string.lastByteMicros, "us");
+  report((prefix + "StreamedLastByte").c_str(), stream.lastByteMicros, "us");
+  report((prefix + "StreamedChunks").c_str(), stream.chunks, "chunks");
+
+  CHECK_EQUAL(string.length, stream.length);
+  // the chunk buffer lives on the stack, the page does not depend on the heap
+  CHECK(stream.peakBytes < string.peakBytes);
+  CHECK(stream.peakBytes < PAGE_CHUNK_SIZE);
+  CHECK(stream.allocations < string.allocations);
+  CHECK(stream.firstByteMicros <= string.firstByteMicros);
+  CHECK(stream.chunks >= (stream.length + PAGE_CHUNK_SIZE - 1) / PAGE_CHUNK_SIZE);
+}
+
+TEST(statePage)
+{
+  // the main loop is this thread, so runInMainLoop() runs the work directly
+  initEvents();
+  // a wiFred that has been through every state and transition
+  for(uint8_t i = 0; i < NUM_STATES; i++)
+  {
+    stateStats[i] = { 3u + i, 12345u * i, 100u * i };
+    for(uint8_t j = 0; j < NUM_STATES; j++)
+    {
+      stateTransitions[i][j] = i != j ? i + j : 0;
+    }
+  }
+  compare("statePage", stringStatePage, writeStatePage);
+}
+
+TEST(functionPage)
+{
+  locos[0].address = 4014;
+  compare("functionPage", stringFunctionPage, streamedFunctionPage);
+}
+
+int main(void)
+{
+  return runTests();
+}
@@ -0,0 +1,134 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file tests the background check of the cached wiThrottle server with
+ * more than one server announced in the network.
+ */
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "locoHandling.h"
+#include "serverDiscovery.h"
+#include "stateMachine.h"
+#include "hostFakes.h"
+#include "testing.h"
+
+#define SERVER_PORT 12090
+
+static const IPAddress JMRI_IP(192, 168, 1, 10);
+static const IPAddress JMRI_MOVED_IP(192, 168, 1, 20);
+static const IPAddress SECOND_JMRI_IP(192, 168, 1, 30);
+static const IPAddress LNWI_IP(192, 168, 4, 1);
+
+/**
+ * Cache the server "jmri" and let the next handleServerDiscovery() query for it
+ */
+static void cacheServer(void)
+{
+  locoServer.automatic = true;
+  locoServer.port = SERVER_PORT;
+  serverCache.valid = true;
+  strcpy(serverCache.hostname, "jmri");
+  serverCache.ip = JMRI_IP;
+  serverCache.port = SERVER_PORT;
+  serverCache.guessed = false;
+  serverCache.failures = 0;
+  serverCache.lastChecked = millis() - SERVER_REVALIDATE_INTERVAL_MS;
+  wiFredState = STATE_LOCO_ONLINE;
+  discoveryStats.serverMoved = 0;
+}
+
+/**
+ * Run one background query to its end
+ */
+static void revalidate(void)
+{
+  uint32_t revalidations = discoveryStats.revalidations;
+  handleServerDiscovery();
+  CHECK_EQUAL(revalidations + 1, discoveryStats.revalidations);
+  for(uint32_t t = 0; t <= SERVER_QUERY_TIMEOUT_MS; t += 100)
+  {
+    fakeAdvance(100);
+    handleServerDiscovery();
+  }
+  fakeClearAnnouncements();
+}
+
+TEST(otherServerAnsweringFirstIsNotAMove)
+{
+  cacheServer();
+  fakeAnnounce("lnwi", LNWI_IP, SERVER_PORT);
+  fakeAnnounce("jmri", JMRI_IP, SERVER_PORT);
+  revalidate();
+  CHECK(serverCache.ip == JMRI_IP);
+  CHECK(!strcmp(serverCache.hostname, "jmri"));
+  CHECK_EQUAL(0, discoveryStats.serverMoved);
+}
+
+TEST(cachedHostIsFollowedToItsNewAddress)
+{
+  cacheServer();
+  fakeAnnounce("lnwi", LNWI_IP, SERVER_PORT);
+  fakeAnnounce("jmri", JMRI_MOVED_IP, SERVER_PORT);
+  revalidate();
+  CHECK(serverCache.ip == JMRI_MOVED_IP);
+  CHECK(!strcmp(serverCache.hostname, "jmri"));
+  CHECK_EQUAL(1, discoveryStats.serverMoved);
+}
+
+TEST(twoOtherServersDoNotReplaceTheCachedOne)
+{
+  cacheServer();
+  fakeAnnounce("lnwi", LNWI_IP, SERVER_PORT);
+  fakeAnnounce("jmri-2", SECOND_JMRI_IP, SERVER_PORT);
+  revalidate();
+  CHECK(serverCache.valid);
+  CHECK(serverCache.ip == JMRI_IP);
+  CHECK(!strcmp(serverCache.hostname, "jmri"));
+  CHECK_EQUAL(0, discoveryStats.serverMoved);
+}
+
+TEST(singleRemainingServerIsTakenOver)
+{
+  cacheServer();
+  fakeAnnounce("jmri-2", SECOND_JMRI_IP, SERVER_PORT);
+  revalidate();
+  CHECK(serverCache.ip == SECOND_JMRI_IP);
+  CHECK(!strcmp(serverCache.hostname, "jmri-2"));
+  CHECK_EQUAL(1, discoveryStats.serverMoved);
+}
+
+TEST(guessedAddressIsConfirmedAmongOthers)
+{
+  cacheServer();
+  strcpy(serverCache.hostname, "192.168.4.1");
+  serverCache.ip = LNWI_IP;
+  serverCache.guessed = true;
+  fakeAnnounce("jmri", JMRI_IP, SERVER_PORT);
+  fakeAnnounce("lnwi", LNWI_IP, SERVER_PORT);
+  revalidate();
+  CHECK(serverCache.ip == LNWI_IP);
+  CHECK(!serverCache.guessed);
+  CHECK(!strcmp(serverCache.hostname, "lnwi"));
+  CHECK_EQUAL(0, discoveryStats.serverMoved);
+}
+
+int main(void)
+{
+  return runTests();
+}
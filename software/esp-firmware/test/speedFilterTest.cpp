@@ -0,0 +1,281 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file replays the noisy speed knob traces in traces/ through the A/D
+ * converter processing with different filter chain settings and reports the
+ * resulting speed messages per minute and the settle latency.
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <string>
+
+#include "hardware.h"
+#include "knobTrace.h"
+#include "locoHandling.h"
+#include "speedFilter.h"
+#include "throttleHandling.h"
+#include "testing.h"
+
+extern volatile uint8_t newSpeed;
+
+#define BLOCK_MS (2 * ADC_CONVERSIONS_PER_PIN * 1000 / ADC_SAMPLE_FREQ_HZ)
+
+#define KNOB_RAW_STOP 4000
+#define KNOB_RAW_FULL 100
+
+typedef struct
+{
+  const char * name;
+  speedFilterConfig config;
+} filterSetting;
+
+static const filterSetting SETTINGS[] = {
+  { "unfiltered",   { 1, 0, false } },
+  { "median3",      { 3, 0, false } },
+  { "median3Bin",   { 3, 0, true } },
+  { "iir2",         { 1, 2, false } },
+  { "median5Iir2",  { 5, 2, true } },
+  { "median7Iir4",  { 7, 4, true } },
+};
+
+typedef struct
+{
+  uint32_t messages;        // speed changes the main loop would send
+  uint32_t restingMessages; // of these, sent more than a second after the knob came to rest
+  uint32_t settleLatency;   // ms from the knob coming to rest until the final speed
+  uint32_t duration;        // ms replayed
+} replayResult;
+
+/**
+ * Replay one trace and count the speed changes, a decoder with less than
+ * 126 steps only gets a message if the speed step changes
+ *
+ * The last second of the trace is repeated for another 3 s so slow filter
+ * settings have time to settle.
+ */
+static replayResult replay(const std::vector<traceSample> & trace, uint16_t tolerance, uint8_t steps)
+{
+  // start from a stopped knob with a settled filter
+  resetSpeedFilter();
+  for(int i = 0; i < 20; i++)
+  {
+    processAnalogBlock(KNOB_RAW_STOP, 1900);
+  }
+
+  std::vector<uint16_t> blocks = traceBlocks(trace, BLOCK_MS);
+  size_t traceBlockCount = blocks.size();
+  size_t lastSecond = std::min(traceBlockCount, (size_t) (1000 / BLOCK_MS));
+  for(size_t i = 0; i < 3000 / BLOCK_MS; i++)
+  {
+    blocks.push_back(blocks[traceBlockCount - lastSecond + i % lastSecond]);
+  }
+
+  uint8_t final = map(finalRaw(trace), KNOB_RAW_FULL, KNOB_RAW_STOP, 253, 0) / 2;
+  uint32_t settled = settleTime(trace, tolerance);
+  replayResult result = { 0, 0, 0, (uint32_t) blocks.size() * BLOCK_MS };
+  uint8_t sent = newSpeed;
+  uint32_t arrived = 0;
+
+  for(size_t i = 0; i < blocks.size(); i++)
+  {
+    processAnalogBlock(blocks[i], 1900);
+    // time the block has been converted completely
+    uint32_t time = (i + 1) * BLOCK_MS;
+    if(speedToStep(newSpeed, steps) != speedToStep(sent, steps))
+    {
+      result.messages++;
+      if(time > settled + 1000)
+      {
+        result.restingMessages++;
+      }
+      sent = newSpeed;
+    }
+    bool atFinal = abs(speedToStep(newSpeed, steps) - speedToStep(final, steps)) <= 1;
+    if(!atFinal)
+    {
+      arrived = 0;
+    }
+    else if(arrived == 0)
+    {
+      arrived = time;
+    }
+  }
+  if(arrived == 0)
+  {
+    result.settleLatency = UINT32_MAX;
+  }
+  else
+  {
+    result.settleLatency = arrived > settled ? arrived - settled : 0;
+  }
+  return result;
+}
+
+/**
+ * Replay a set of traces with one filter setting and report the totals
+ *
+ * @param tolerance raw noise around the final knob position still counted as at rest
+ * @param mustSettle check that the speed ends within one step of the knob position
+ * @returns messages sent while the knob was at rest
+ */
+static uint32_t replayAll(const char * const * traces, size_t count, uint16_t tolerance, bool mustSettle,
+                          const std::string & prefix, uint8_t steps)
+{
+  uint32_t messages = 0;
+  uint32_t restingMessages = 0;
+  uint32_t duration = 0;
+  uint32_t settleMax = 0;
+  uint32_t unsettled = 0;
+
+  for(size_t t = 0; t < count; t++)
+  {
+    std::vector<traceSample> trace = readTrace(traces[t]);
+    CHECK(!trace.empty());
+    if(trace.empty())
+    {
+      continue;
+    }
+    replayResult result = replay(trace, tolerance, steps);
+    CHECK(!mustSettle || result.settleLatency != UINT32_MAX);
+    messages += result.messages;
+    restingMessages += result.restingMessages;
+    duration += result.duration;
+    if(result.settleLatency == UINT32_MAX)
+    {
+      unsettled++;
+    }
+    else
+    {
+      settleMax = std::max(settleMax, result.settleLatency);
+    }
+  }
+
+  report((prefix + "MessagesPerMinute").c_str(), messages * 60000.0 / duration, "1/min");
+  report((prefix + "RestingMessages").c_str(), restingMessages, "messages");
+  report((prefix + "SettleLatencyMax").c_str(), settleMax, "ms");
+  report((prefix + "Unsettled").c_str(), unsettled, "traces");
+  return restingMessages;
+}
+
+static void benchmark(uint8_t steps)
+{
+  locoState[0] = LOCO_ACTIVE;
+  locos[0].address = 3;
+  free(locos[0].mode);
+  locos[0].mode = strdup(steps == 28 ? "28" : "128");
+
+  uint32_t unfilteredNoise = 0;
+  for(const filterSetting & setting : SETTINGS)
+  {
+    speedFilter = setting.config;
+    std::string prefix = setting.name + std::to_string(steps) + "Steps";
+    replayAll(KNOB_TRACES, sizeof(KNOB_TRACES) / sizeof(KNOB_TRACES[0]), 32, true, prefix, steps);
+    // the worn potentiometer may keep flickering between two steps without filters
+    uint32_t noise = replayAll(NOISY_KNOB_TRACES, sizeof(NOISY_KNOB_TRACES) / sizeof(NOISY_KNOB_TRACES[0]),
+                               160, false, prefix + "WornPot", steps);
+    if(setting.config.medianLength == 1 && setting.config.iirShift == 0 && !setting.config.binning)
+    {
+      unfilteredNoise = noise;
+    }
+    // a knob left alone must cause fewer messages once the filters are on
+    else
+    {
+      CHECK(noise < unfilteredNoise || unfilteredNoise == 0);
+    }
+  }
+  speedFilter = { SPEED_MEDIAN_DEFAULT, SPEED_IIR_SHIFT_DEFAULT, SPEED_BINNING_DEFAULT };
+  resetSpeedFilter();
+  locoState[0] = LOCO_INACTIVE;
+}
+
+TEST(everyConfiguredModeHasItsSteps)
+{
+  // same order as MODES
+  const uint8_t STEPS[MODES_LENGTH] = { 0, 126, 28, 27, 14, 28, 32, 0, 126, 28, 27, 14, 28 };
+  for(int m = 0; m < MODES_LENGTH; m++)
+  {
+    CHECK_EQUAL(STEPS[m], configuredModeSteps(MODES[m].val));
+  }
+}
+
+TEST(numericModesQuantiseToTheirSteps)
+{
+  locos[0].address = 3;
+  locos[1].address = 4;
+  free(locos[0].mode);
+  free(locos[1].mode);
+  locos[0].mode = strdup("2");
+  locos[1].mode = strdup("1");
+  locoStatus[0].speedStepMode = locoStatus[1].speedStepMode = 0;
+  locoState[0] = LOCO_ACTIVE;
+  locoState[1] = LOCO_INACTIVE;
+  CHECK_EQUAL(28, getSpeedSteps());
+
+  // the coarsest acquired loco counts
+  free(locos[1].mode);
+  locos[1].mode = strdup("8");
+  locoState[1] = LOCO_ACTIVE;
+  CHECK_EQUAL(14, getSpeedSteps());
+
+  // the mode reported by the server wins over the configured one
+  locoStatus[1].speedStepMode = 1;
+  CHECK_EQUAL(28, getSpeedSteps());
+  locoState[1] = LOCO_DEACTIVATE;
+  CHECK_EQUAL(28, getSpeedSteps());
+  locoState[0] = locoState[1] = LOCO_INACTIVE;
+  locoStatus[1].speedStepMode = 0;
+  CHECK_EQUAL(126, getSpeedSteps());
+}
+
+TEST(speedStepsRoundTrip)
+{
+  const uint8_t MODE_STEPS[] = { 14, 27, 28, 32, 126 };
+  for(uint8_t steps : MODE_STEPS)
+  {
+    CHECK_EQUAL(0, speedToStep(0, steps));
+    CHECK_EQUAL(steps, speedToStep(126, steps));
+    uint8_t previous = 0;
+    for(uint8_t speed = 1; speed <= 126; speed++)
+    {
+      uint8_t step = speedToStep(speed, steps);
+      // any speed above zero moves the loco, steps never go backwards
+      CHECK(step >= 1 && step <= steps);
+      CHECK(step >= previous);
+      previous = step;
+      // the value sent for a step maps back to the same step
+      CHECK_EQUAL(step, speedToStep(stepToSpeed(step, steps), steps));
+    }
+  }
+}
+
+TEST(filterChainWith126Steps)
+{
+  potiMin = KNOB_RAW_FULL;
+  potiMax = KNOB_RAW_STOP;
+  benchmark(126);
+}
+
+TEST(filterChainWith28Steps)
+{
+  benchmark(28);
+}
+
+int main(void)
+{
+  return runTests();
+}
@@ -0,0 +1,173 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file replays the speed knob traces in traces/ against the wiThrottle
+ * stand-in and reports how many speed commands the rate limiter sends and
+ * how long after the knob comes to rest the server has the final speed,
+ * and checks a 28 step decoder only gets commands that change its step.
+ */
+
+#include <Arduino.h>
+#include <string>
+
+#include "knobTrace.h"
+#include "speedFilter.h"
+#include "standIn.h"
+#include "testing.h"
+
+/**
+ * Speed the firmware should end up at for a raw knob value
+ */
+static uint8_t knobSpeed(uint16_t raw)
+{
+  if(raw > potiMax)
+  {
+    return 0;
+  }
+  if(raw < potiMin)
+  {
+    return 126;
+  }
+  return map(raw, potiMin, potiMax, 253, 0) / 2;
+}
+
+static bool echoed(uint8_t expected)
+{
+  return locoStatus[0].speed >= 0 && abs(locoStatus[0].speed - expected) <= 1;
+}
+
+/**
+ * Replay one trace in real time, then report the speed commands sent and
+ * the time from the knob coming to rest until the server echoed the final speed
+ */
+static void replay(const char * name)
+{
+  std::vector<traceSample> trace = readTrace(name);
+  CHECK(!trace.empty());
+  if(trace.empty())
+  {
+    return;
+  }
+  uint8_t expected = knobSpeed(finalRaw(trace));
+  uint32_t settled = settleTime(trace, 32);
+  uint32_t sent = speedCommandsSent;
+  uint32_t start = millis();
+  uint32_t arrived = 0;
+
+  for(const traceSample & sample : trace)
+  {
+    loopUntil([start, sample]() { return millis() - start >= sample.ms; }, 1000);
+    fakeSetAnalog(ANALOG_PIN_POTI, sample.raw, 0);
+    if(arrived == 0 && millis() - start >= settled && echoed(expected))
+    {
+      arrived = millis() - start;
+    }
+  }
+  // the last value is always flushed, even after the knob stopped moving
+  if(arrived == 0 && loopUntil([expected]() { return echoed(expected); }, 2000))
+  {
+    arrived = millis() - start;
+  }
+  CHECK(arrived != 0);
+  CHECK(abs(getSpeed() - expected) <= 1);
+  CHECK(echoed(getSpeed()));
+
+  std::string prefix = name;
+  report((prefix + "SpeedCommands").c_str(), speedCommandsSent - sent, "commands");
+  report((prefix + "FinalSpeedLatency").c_str(), arrived > settled ? arrived - settled : 0, "ms");
+
+  // back to stop for the next trace
+  fakeSetAnalog(ANALOG_PIN_POTI, knobRaw(0), 0);
+  loopUntil([]() { return getSpeed() == 0 && echoed(0); }, 2000);
+  loopUntil([]() { return false; }, 500);
+}
+
+/**
+ * Turn the knob slowly over the whole range, one speed value at a time,
+ * every value on the wire has to be the middle of a 28 step decoder step
+ */
+static void sweepKnob(void)
+{
+  for(uint8_t speed = 0; speed <= 126; speed++)
+  {
+    fakeSetAnalog(ANALOG_PIN_POTI, knobRaw(speed), 0);
+    loopUntil([]() { return false; }, 100);
+    if(locoStatus[0].speed > 0)
+    {
+      uint8_t step = speedToStep(locoStatus[0].speed, 28);
+      CHECK_EQUAL(stepToSpeed(step, 28), locoStatus[0].speed);
+    }
+  }
+  CHECK(loopUntil([]() { return echoed(stepToSpeed(28, 28)); }, 2000));
+}
+
+TEST(drivesALocoOnTheStandIn)
+{
+  uint16_t port = startStandIn();
+  CHECK(port != 0);
+  CHECK(bootOnline(port));
+  setLocoSwitch(0, true);
+  CHECK(loopUntil([]() { return locoState[0] == LOCO_ACTIVE; }, 2000));
+}
+
+TEST(replaysKnobTraces)
+{
+  for(const char * name : KNOB_TRACES)
+  {
+    replay(name);
+  }
+  report("speedRoundTrip", speedRoundTrip, "ms");
+  report("speedHoldoff", getSpeedHoldoff(), "ms");
+}
+
+TEST(onlyNewStepsAreSentTo28StepDecoders)
+{
+  // acquire the loco again with the numeric mode for 28 steps
+  setLocoSwitch(0, false);
+  CHECK(loopUntil([]() { return locoState[0] == LOCO_INACTIVE; }, 2000));
+  free(locos[0].mode);
+  locos[0].mode = strdup("2");
+  setLocoSwitch(0, true);
+  CHECK(loopUntil([]() { return locoState[0] == LOCO_ACTIVE && locoStatus[0].speedStepMode == 2; }, 2000));
+  CHECK_EQUAL(28, getSpeedSteps());
+
+  // binning already keeps the knob on the decoder steps, without it the
+  // sender has to drop the values within a step
+  for(bool binning : { true, false })
+  {
+    speedFilter.binning = binning;
+    uint32_t sent = speedCommandsSent;
+    uint32_t suppressed = speedCommandsSuppressed;
+    sweepKnob();
+    std::string prefix = binning ? "binned" : "unbinned";
+    report((prefix + "Steps28SpeedCommands").c_str(), speedCommandsSent - sent, "commands");
+    report((prefix + "Steps28Suppressed").c_str(), speedCommandsSuppressed - suppressed, "commands");
+    CHECK(speedCommandsSent - sent <= 28);
+    CHECK(binning || speedCommandsSuppressed - suppressed > 0);
+
+    fakeSetAnalog(ANALOG_PIN_POTI, knobRaw(0), 0);
+    CHECK(loopUntil([]() { return echoed(0); }, 2000));
+    loopUntil([]() { return false; }, 300);
+  }
+  speedFilter.binning = SPEED_BINNING_DEFAULT;
+  stopStandIn();
+}
+
+int main(void)
+{
+  return runTests();
+}
@@ -0,0 +1,210 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file hammers the lock-free queue between the Ticker callbacks and
+ * the main loop from two threads and checks nothing is lost or reordered.
+ */
+
+#include <Arduino.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "hardware.h"
+#include "spscQueue.h"
+#include "throttleHandling.h"
+#include "hostFakes.h"
+#include "testing.h"
+
+void debounceInputCallback(void);
+
+TEST(fullQueueDropsNewEntries)
+{
+  spscQueue<uint32_t, 8> queue;
+  for(uint32_t i = 0; i < 8; i++)
+  {
+    CHECK(queue.push(i));
+  }
+  CHECK(!queue.push(8));
+  CHECK_EQUAL(1, queue.dropped.load());
+
+  uint32_t entry;
+  for(uint32_t i = 0; i < 8; i++)
+  {
+    CHECK(queue.pop(entry));
+    CHECK_EQUAL(i, entry);
+  }
+  CHECK(!queue.pop(entry));
+  CHECK(queue.push(9));
+  CHECK(queue.pop(entry));
+  CHECK_EQUAL(9, entry);
+}
+
+TEST(twoThreadsKeepEveryEntryInOrder)
+{
+  const uint32_t COUNT = 2000000;
+  static spscQueue<uint32_t, 64> queue;
+  uint32_t full = 0;
+
+  // both sides yield instead of spinning so the test also runs on one core
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([&full]() {
+    for(uint32_t i = 0; i < COUNT; i++)
+    {
+      while(!queue.push(i))
+      {
+        full++;
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t expected = 0;
+  uint32_t outOfOrder = 0;
+  uint32_t entry;
+  while(expected < COUNT)
+  {
+    if(queue.pop(entry))
+    {
+      if(entry != expected)
+      {
+        outOfOrder++;
+      }
+      expected = entry + 1;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  CHECK_EQUAL(0, outOfOrder);
+  CHECK(!queue.pop(entry));
+  CHECK_EQUAL(full, queue.dropped.load());
+  report("entriesPerSecond", COUNT / seconds, "1/s");
+  report("pushesOnFullQueue", full, "pushes");
+}
+
+TEST(noKeyEdgesAreLost)
+{
+  // four keys toggled at different rates while the debounce callback runs
+  // on its own thread and the main loop side empties the queue
+  const keys KEYS[4] = { KEY_F1, KEY_F5, KEY_SHIFT, KEY_LOCO3 };
+  const uint32_t PERIOD[4] = { 6, 7, 11, 13 };
+  const uint32_t TICKS = 200000;
+  std::atomic<bool> done(false);
+  uint32_t produced[4] = {};
+
+  for(keys key : KEYS)
+  {
+    fakeSetInput(KEY_PIN[key], HIGH);
+  }
+  uint32_t dropped = inputQueue.dropped;
+
+  std::thread producer([&]() {
+    bool pressed[4] = {};
+    for(uint32_t tick = 1; tick <= TICKS; tick++)
+    {
+      for(uint8_t k = 0; k < 4; k++)
+      {
+        // toggle with a period long enough to pass the debouncing,
+        // the last edge of each key releases it
+        if(tick % PERIOD[k] == 0 && (pressed[k] || tick + 2 * PERIOD[k] <= TICKS))
+        {
+          pressed[k] = !pressed[k];
+          produced[k]++;
+          fakeSetInput(KEY_PIN[KEYS[k]], pressed[k] ? LOW : HIGH);
+        }
+      }
+      debounceInputCallback();
+      if(tick % 16 == 0)
+      {
+        std::this_thread::yield();
+      }
+    }
+    // let the debouncing see the final state
+    for(int i = 0; i < 8; i++)
+    {
+      debounceInputCallback();
+    }
+    done = true;
+  });
+
+  uint32_t received[4] = {};
+  uint32_t badOrder = 0;
+  uint32_t lastTime = 0;
+  bool state[4] = {};
+  inputEvent event;
+  while(true)
+  {
+    bool finished = done;
+    while(inputQueue.pop(event))
+    {
+      if(event.time < lastTime)
+      {
+        badOrder++;
+      }
+      lastTime = event.time;
+      for(uint8_t k = 0; k < 4; k++)
+      {
+        if(event.key == KEYS[k] && (event.type == EVENT_KEY_DOWN || event.type == EVENT_KEY_UP))
+        {
+          // edges of one key have to alternate unless one was dropped
+          if((event.type == EVENT_KEY_DOWN) == state[k])
+          {
+            badOrder++;
+          }
+          state[k] = event.type == EVENT_KEY_DOWN;
+          received[k]++;
+        }
+      }
+    }
+    if(finished)
+    {
+      break;
+    }
+    std::this_thread::yield();
+  }
+  producer.join();
+
+  // every toggle of an input has to arrive as one debounced edge
+  uint32_t total = 0;
+  for(uint8_t k = 0; k < 4; k++)
+  {
+    total += received[k];
+  }
+  uint32_t lost = inputQueue.dropped - dropped;
+  report("keyEdges", total, "edges");
+  report("droppedKeyEdges", lost, "edges");
+  CHECK_EQUAL(produced[0] + produced[1] + produced[2] + produced[3], total + lost);
+  if(lost == 0)
+  {
+    CHECK_EQUAL(0, badOrder);
+    for(uint8_t k = 0; k < 4; k++)
+    {
+      CHECK_EQUAL(produced[k], received[k]);
+      CHECK(!state[k]);
+    }
+  }
+}
+
+int main(void)
+{
+  return runTests();
+}
@@ -0,0 +1,223 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file runs software/tools/withrottle-standin.py for the tests that
+ * talk to a wiThrottle server, and boots the firmware until it is online
+ * with that server. Include it in one source file of a test only.
+ */
+
+#ifndef _STAND_IN_H_
+#define _STAND_IN_H_
+
+#include <Arduino.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <lwip/sockets.h>
+
+#include "hardware.h"
+#include "locoHandling.h"
+#include "stateMachine.h"
+#include "throttleHandling.h"
+#include "wifiHandling.h"
+#include "hostFakes.h"
+
+void setup(void);
+void loop(void);
+
+static pid_t standInPid = -1;
+
+/**
+ * Ask the kernel for a port nobody listens on
+ */
+static inline uint16_t freePort(void)
+{
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in address;
+  socklen_t length = sizeof(address);
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(fd, (struct sockaddr *) &address, sizeof(address));
+  getsockname(fd, (struct sockaddr *) &address, &length);
+  close(fd);
+  return ntohs(address.sin_port);
+}
+
+/**
+ * Start the stand-in server and wait until it accepts connections
+ *
+ * @param args additional arguments, i.e. { "--simulate", "100" }
+ * @param output file receiving the output of the stand-in, nullptr to drop it
+ * @returns port the stand-in listens on, 0 if it could not be started
+ */
+static inline uint16_t startStandIn(std::vector<std::string> args = {}, const char * output = nullptr)
+{
+  uint16_t port = freePort();
+  std::vector<std::string> command = { PYTHON_EXECUTABLE, STANDIN_SCRIPT, "--port", std::to_string(port) };
+  command.insert(command.end(), args.begin(), args.end());
+
+  standInPid = fork();
+  if(standInPid == 0)
+  {
+    int out = open(output != nullptr ? output : "/dev/null", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    dup2(out, STDOUT_FILENO);
+    std::vector<char *> argv;
+    for(std::string & a : command)
+    {
+      argv.push_back((char *) a.c_str());
+    }
+    argv.push_back(nullptr);
+    execv(argv[0], argv.data());
+    _exit(127);
+  }
+
+  for(int attempt = 0; attempt < 500; attempt++)
+  {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    bool up = connect(fd, (struct sockaddr *) &address, sizeof(address)) == 0;
+    close(fd);
+    if(up)
+    {
+      return port;
+    }
+    if(waitpid(standInPid, nullptr, WNOHANG) == standInPid)
+    {
+      break;
+    }
+    usleep(20000);
+  }
+  standInPid = -1;
+  return 0;
+}
+
+/**
+ * Stop the stand-in like Ctrl-C does, so it writes its statistics
+ */
+static inline void stopStandIn(void)
+{
+  if(standInPid > 0)
+  {
+    kill(standInPid, SIGINT);
+    waitpid(standInPid, nullptr, 0);
+    standInPid = -1;
+  }
+}
+
+/**
+ * Wait for a stand-in started with --simulate to finish its run
+ */
+static inline void waitStandIn(void)
+{
+  if(standInPid > 0)
+  {
+    waitpid(standInPid, nullptr, 0);
+    standInPid = -1;
+  }
+}
+
+/**
+ * Run the main loop until done() returns true or the time is up
+ */
+static inline bool loopUntil(std::function<bool(void)> done, uint32_t timeout)
+{
+  uint32_t end = millis() + timeout;
+  while(!done() && (int32_t) (millis() - end) < 0)
+  {
+    loop();
+    // the Tickers run in a task of their own on the ESP32
+    yield();
+  }
+  return done();
+}
+
+/**
+ * Switch a loco selection switch (the input reads low while the switch is off)
+ */
+static inline void setLocoSwitch(uint8_t loco, bool on)
+{
+  fakeSetInput(KEY_PIN[KEY_LOCO1 + loco], on ? HIGH : LOW);
+}
+
+/**
+ * Speed knob position as a raw A/D converter value, 0 (stop) to 126,
+ * for the calibration set by bootOnline()
+ */
+#define KNOB_RAW_STOP 4000
+#define KNOB_RAW_FULL 100
+
+static inline uint16_t knobRaw(uint8_t speed)
+{
+  return KNOB_RAW_STOP - (uint32_t) speed * (KNOB_RAW_STOP - KNOB_RAW_FULL) / 126;
+}
+
+/**
+ * Addresses of the four locos set up by bootOnline()
+ */
+static const int16_t TEST_LOCO_ADDRESSES[4] = { 4014, 3, 1234, 78 };
+
+/**
+ * Boot the firmware with all loco switches off and the knob at zero, and
+ * connect it to the server at the given port
+ *
+ * The simulated clock is used until the WiFi connection is up (scanning
+ * and connecting take seconds), everything after that runs in real time.
+ *
+ * @returns true if the firmware is online with the server
+ */
+static inline bool bootOnline(uint16_t port)
+{
+  for(uint8_t l = 0; l < 4; l++)
+  {
+    setLocoSwitch(l, false);
+  }
+  fakeSetAnalog(ANALOG_PIN_POTI, KNOB_RAW_STOP, 0);
+  fakeSetAnalog(ANALOG_PIN_VBATT, 0, 1900);
+  fakeAddNetwork("layout", "secret");
+  apList.push_back({ strdup("layout"), strdup("secret") });
+
+  setup();
+
+  free(locoServer.name);
+  locoServer.name = strdup("127.0.0.1");
+  locoServer.automatic = false;
+  locoServer.port = port;
+  for(uint8_t l = 0; l < 4; l++)
+  {
+    locos[l].address = TEST_LOCO_ADDRESSES[l];
+    locos[l].longAddress = TEST_LOCO_ADDRESSES[l] > 127;
+  }
+  potiMin = KNOB_RAW_FULL;
+  potiMax = KNOB_RAW_STOP;
+
+  if(!loopUntil([]() { return wiFredState == STATE_CONNECTED; }, 60000))
+  {
+    return false;
+  }
+  fakeUseRealTime(true);
+  return loopUntil([]() { return wiFredState == STATE_LOCO_ONLINE; }, 5000);
+}
+
+#endif
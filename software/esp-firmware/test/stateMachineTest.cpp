@@ -0,0 +1,176 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file boots the whole firmware (setup() and loop() of the sketch) on
+ * the simulated hardware and checks it gets onto the network.
+ */
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <WiFi.h>
+
+#include "config.h"
+#include "hardware.h"
+#include "locoHandling.h"
+#include "stateMachine.h"
+#include "wifiHandling.h"
+#include "hostFakes.h"
+#include "testing.h"
+
+void setup(void);
+void loop(void);
+
+extern WebServer server;
+
+void handleWiFiScan(void);
+
+/**
+ * Run the main loop until the state is reached or the time is up
+ */
+static bool loopUntil(state target, uint32_t timeout)
+{
+  uint32_t end = millis() + timeout;
+  while(wiFredState != target && millis() < end)
+  {
+    loop();
+  }
+  return wiFredState == target;
+}
+
+TEST(bootsAndConnectsToTheNetwork)
+{
+  fakeSetAnalog(ANALOG_PIN_POTI, 0, 0);
+  fakeSetAnalog(ANALOG_PIN_VBATT, 0, 1900);
+  fakeAddNetwork("layout", "secret");
+  apList.push_back({ strdup("layout"), strdup("secret") });
+
+  setup();
+  CHECK(loopUntil(STATE_CONNECTING, 1000));
+  CHECK(!WiFi.isConnected());
+
+  // WiFiMulti scans all channels before connecting
+  CHECK(loopUntil(STATE_CONNECTED, fakeWiFiScanMs + fakeWiFiConnectMs + 1000));
+  CHECK(WiFi.SSID() == "layout");
+  CHECK(lastAP.valid);
+  CHECK(!strcmp(lastAP.ssid, "layout"));
+
+  // the main loop sleeps between events instead of spinning
+  uint32_t start = millis();
+  for(int i = 0; i < 100; i++)
+  {
+    loop();
+  }
+  CHECK(millis() - start >= 100);
+}
+
+TEST(webPagesAreServed)
+{
+  fakeResponse states = server.request("/states.html");
+  CHECK_EQUAL(200, states.code);
+  CHECK(states.chunked);
+  CHECK(states.body.indexOf("CONNECTING") >= 0);
+  CHECK(states.body.endsWith("</html>"));
+
+  // settings in GET arguments are applied and answered with the page, only the form target redirects
+  fakeResponse linked = server.request("/index.html", HTTP_GET, { { "throttleName", "yard-1" } });
+  CHECK_EQUAL(200, linked.code);
+  CHECK(linked.length > 0);
+  CHECK(!strcmp(throttleName, "yard-1"));
+  fakeResponse posted = server.request("/config", HTTP_POST, { { "throttleName", "yard-2" } });
+  CHECK_EQUAL(303, posted.code);
+  CHECK(!strcmp(throttleName, "yard-2"));
+}
+
+/**
+ * @returns the value of a response header, empty if it has not been sent
+ */
+static String header(const fakeResponse & response, const char * name)
+{
+  for(auto & h : response.headers)
+  {
+    if(h.first == name)
+    {
+      return h.second;
+    }
+  }
+  return String();
+}
+
+TEST(unchangedApiAnswersAreNotSentAgain)
+{
+  fakeResponse locos = server.request("/api/v1/locos");
+  CHECK_EQUAL(200, locos.code);
+  String etag = header(locos, "ETag");
+  CHECK(etag.length() > 0);
+  fakeResponse again = server.request("/api/v1/locos", HTTP_GET, {}, { { "If-None-Match", etag } });
+  CHECK_EQUAL(304, again.code);
+  CHECK_EQUAL(0, again.length);
+
+  // the status carries the uptime, an ETag would never match
+  fakeResponse status = server.request("/api/v1/status");
+  CHECK_EQUAL(200, status.code);
+  CHECK(status.body.indexOf("\"uptime\"") >= 0);
+  CHECK(header(status, "ETag").length() == 0);
+  CHECK(header(status, "Cache-Control") == "no-store");
+}
+
+TEST(scansWaitForTheLocosToBeReleased)
+{
+  wiFredState = STATE_LOCO_ONLINE;
+  for(uint8_t l = 0; l < 4; l++)
+  {
+    locoState[l] = LOCO_INACTIVE;
+  }
+  locoState[0] = LOCO_ACTIVE;
+  requestWiFiScan();
+  handleWiFiScan();
+  CHECK(scanRequested);
+  CHECK(!scanRunning);
+
+  locoState[0] = LOCO_INACTIVE;
+  handleWiFiScan();
+  CHECK(scanRunning);
+  fakeAdvance(fakeWiFiScanMs);
+  handleWiFiScan();
+  CHECK(!scanRunning);
+  CHECK(scanTime == millis());
+
+  // reconnecting with a loco to resume counts as driving
+  wiFredState = STATE_CONNECTED;
+  locoState[1] = LOCO_RESUME;
+  requestWiFiScan();
+  fakeAdvance(SCAN_REQUEST_TIMEOUT_MS - 1);
+  handleWiFiScan();
+  CHECK(scanRequested);
+  fakeAdvance(1);
+  handleWiFiScan();
+  CHECK(!scanRequested);
+  CHECK(!scanRunning);
+  CHECK(scanRefused);
+  CHECK(server.request("/api/v1/scan").body.indexOf("\"refused\":true") >= 0);
+
+  locoState[1] = LOCO_INACTIVE;
+  requestWiFiScan();
+  CHECK(!scanRefused);
+  handleWiFiScan();
+  CHECK(scanRunning);
+}
+
+int main(void)
+{
+  return runTests();
+}
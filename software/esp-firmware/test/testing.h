@@ -0,0 +1,107 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is a minimal test harness for the host tests: TEST() registers
+ * a test case, CHECK() and CHECK_EQUAL() record failures without stopping
+ * the test case, report() prints a measurement for the benchmarks.
+ */
+
+#ifndef _TESTING_H_
+#define _TESTING_H_
+
+#include <stdio.h>
+#include <vector>
+
+typedef struct
+{
+  const char * name;
+  void (*run)(void);
+} testCase;
+
+inline std::vector<testCase> & testCases(void)
+{
+  static std::vector<testCase> cases;
+  return cases;
+}
+
+inline int & testFailures(void)
+{
+  static int failures = 0;
+  return failures;
+}
+
+struct testRegistrar
+{
+  testRegistrar(const char * name, void (*run)(void))
+  {
+    testCases().push_back({ name, run });
+  }
+};
+
+#define TEST(name) \
+  static void name(void); \
+  static testRegistrar name##Registrar(#name, name); \
+  static void name(void)
+
+#define CHECK(condition) \
+  do \
+  { \
+    if(!(condition)) \
+    { \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+      testFailures()++; \
+    } \
+  } while(0)
+
+#define CHECK_EQUAL(expected, actual) \
+  do \
+  { \
+    long long e = (long long) (expected), a = (long long) (actual); \
+    if(e != a) \
+    { \
+      printf("%s:%d: CHECK_EQUAL(%s, %s) failed: expected %lld, got %lld\n", \
+             __FILE__, __LINE__, #expected, #actual, e, a); \
+      testFailures()++; \
+    } \
+  } while(0)
+
+/**
+ * Print a measurement, one per line so results can be collected with grep
+ */
+inline void report(const char * name, double value, const char * unit)
+{
+  printf("REPORT %s %.3f %s\n", name, value, unit);
+}
+
+/**
+ * Run all registered test cases
+ *
+ * @returns exit code for ctest
+ */
+inline int runTests(void)
+{
+  for(testCase & t : testCases())
+  {
+    int before = testFailures();
+    printf("[ RUN  ] %s\n", t.name);
+    t.run();
+    printf("[ %s ] %s\n", testFailures() == before ? " OK " : "FAIL", t.name);
+  }
+  return testFailures() == 0 ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file tests the wiThrottle command builder and compares it with
+ * building the same lines through String concatenation, which is what
+ * locoHandling.cpp used to do.
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <limits.h>
+
+#include "wiThrottleCommand.h"
+#include "allocCounter.h"
+#include "testing.h"
+
+TEST(buildsProtocolLines)
+{
+  wiThrottleCommand speed("MTAL1234<;>");
+  speed.add('V').add(126).end();
+  CHECK(!strcmp(speed.c_str(), "MTAL1234<;>V126\n"));
+  CHECK_EQUAL(16, speed.length());
+
+  wiThrottleCommand id("HU");
+  id.addHex(0x24).addHex(0x0a).addHex(0).end();
+  CHECK(!strcmp(id.c_str(), "HU24a0\n"));
+
+  wiThrottleCommand numbers;
+  numbers.add(0).add(' ').add(-7).add(' ').add(INT_MIN);
+  CHECK(!strcmp(numbers.c_str(), "0 -7 -2147483648"));
+}
+
+TEST(truncatesButKeepsTheNewline)
+{
+  char longText[COMMAND_BUFFER_SIZE * 2];
+  memset(longText, 'x', sizeof(longText) - 1);
+  longText[sizeof(longText) - 1] = '\0';
+
+  wiThrottleCommand line("MTA");
+  line.add(longText).add(12345).add('y').end();
+  CHECK_EQUAL(COMMAND_BUFFER_SIZE - 1, line.length());
+  CHECK_EQUAL('\n', line.c_str()[line.length() - 1]);
+  CHECK_EQUAL('x', line.c_str()[line.length() - 2]);
+  CHECK_EQUAL(line.length(), strlen(line.c_str()));
+}
+
+/**
+ * The commands sent while driving: speed, functions, direction and a
+ * speed query for each of four locos, the loco IDs and prefixes are set up
+ * once like when the locos are acquired
+ */
+static const char * const LOCO_PREFIXES[4] = { "MTAL1234<;>", "MTAS3<;>", "MTAL10239<;>", "MTAS127<;>" };
+static String locoIDs[4] = { String("L1234"), String("S3"), String("L10239"), String("S127") };
+
+static size_t buildWithCommand(int round)
+{
+  size_t total = 0;
+  for(int l = 0; l < 4; l++)
+  {
+    total += wiThrottleCommand("MTA*<;>V").add(round & 127).end().length();
+    total += wiThrottleCommand(LOCO_PREFIXES[l]).add("F1").add(round % 29).end().length();
+    total += wiThrottleCommand(LOCO_PREFIXES[l]).add('R').add(round & 1).end().length();
+    total += wiThrottleCommand(LOCO_PREFIXES[l]).add("qV").end().length();
+  }
+  return total;
+}
+
+static size_t buildWithString(int round)
+{
+  size_t total = 0;
+  for(int l = 0; l < 4; l++)
+  {
+    total += (String("MTA*<;>V") + (round & 127) + "\n").length();
+    total += (String("MTA") + locoIDs[l] + "<;>F1" + (round % 29) + "\n").length();
+    total += (String("MTA") + locoIDs[l] + "<;>R" + (round & 1) + "\n").length();
+    total += (String("MTA") + locoIDs[l] + "<;>qV\n").length();
+  }
+  return total;
+}
+
+static inline uint64_t cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+TEST(buildsCommandsWithoutHeap)
+{
+  const int ROUNDS = 20000;
+  const int COMMANDS = ROUNDS * 16;
+  size_t commandBytes = 0;
+  size_t stringBytes = 0;
+
+  resetAllocations();
+  uint64_t start = cycles();
+  for(int r = 0; r < ROUNDS; r++)
+  {
+    commandBytes += buildWithCommand(r);
+  }
+  uint64_t commandCycles = cycles() - start;
+  size_t commandAllocations = allocations;
+
+  resetAllocations();
+  start = cycles();
+  for(int r = 0; r < ROUNDS; r++)
+  {
+    stringBytes += buildWithString(r);
+  }
+  uint64_t stringCycles = cycles() - start;
+  size_t stringAllocations = allocations;
+  counting = false;
+
+  // same lines, but only the String path touches the heap
+  CHECK_EQUAL(stringBytes, commandBytes);
+  CHECK_EQUAL(0, commandAllocations);
+  CHECK(stringAllocations >= (size_t) COMMANDS);
+
+  report("wiThrottleCommand.allocationsPerCommand", (double) commandAllocations / COMMANDS, "allocations");
+  report("String.allocationsPerCommand", (double) stringAllocations / COMMANDS, "allocations");
+  report("wiThrottleCommand.cyclesPerCommand", (double) commandCycles / COMMANDS, "cycles");
+  report("String.cyclesPerCommand", (double) stringCycles / COMMANDS, "cycles");
+}
+
+int main(void)
+{
+  return runTests();
+}
@@ -27,6 +27,8 @@
 #include "stateMachine.h"
 #include "lowbat.h"
 #include "throttleHandling.h"
+#include "eventHandling.h"
+#include "speedFilter.h"
 
 /**
  * LED handling tickers
@@ -51,26 +53,30 @@ unsigned int ledRevOnTime;
 Ticker debounceInput;
 
 /**
- * Current state of inputs
+ * Current state of inputs, only used by the main loop
  */
 bool inputState[17] = { false };
 bool inputPressed[17] = { false };
 bool inputToggled[17] = { false };
 
 /**
- * A/D conversion ticker
+ * Debounced state of inputs, only used by debounceInputCallback()
  */
-Ticker analogInput;
+bool debouncedState[17] = { false };
+
+spscQueue<inputEvent, INPUT_QUEUE_SIZE> inputQueue;
+
+uint32_t inputLatencyMax = 0;
 
 /**
- * A/D calibration reset ticker
+ * millis() value of the last potiMax reduction
  */
-Ticker reduceCalibValues;
+uint32_t lastCalibReduce = 0;
 
 /**
  * Flag to show we want to save new config data
  */
-volatile bool saveAnalog = false;
+bool saveAnalog = false;
 
 /**
  * Potentiometer value for zero speed (counterclockwise limit)
@@ -108,6 +114,12 @@ bool directionChangeUnlock = false;
  */
 bool directionChangeBlocked = false;
 
+/**
+ * Speed knob is turned to (almost) zero, updated from every A/D converter block
+ * (not only when the speed changes)
+ */
+bool speedKnobAtZero = false;
+
 /**
  * Timestamp when direction switch was moved into center position
  */
@@ -130,7 +142,7 @@ unsigned int blinkLED;
  */
 void ledOff(int ledPin)
 {
-  digitalWrite(ledPin, HIGH);
+  setLED(ledPin, false);
 }
 
 /**
@@ -143,21 +155,21 @@ void ledOn(int ledPin)
     case LED_STOP:
       if(ledStopOnTime > 0)
         {
-          digitalWrite(ledPin, LOW);
+          setLED(ledPin, true);
           ledStopTickerOff.once_ms(10 * ledStopOnTime, ledOff, LED_STOP);
         }
       break;
     case LED_FWD:
       if(ledFwdOnTime > 0)
       {
-        digitalWrite(ledPin, LOW);
+        setLED(ledPin, true);
         ledFwdTickerOff.once_ms(10 * ledFwdOnTime, ledOff, LED_FWD);
       }
       break;
     case LED_REV:
       if(ledRevOnTime > 0)
       {
-        digitalWrite(ledPin, LOW);
+        setLED(ledPin, true);
         ledRevTickerOff.once_ms(10 * ledRevOnTime, ledOff, LED_REV);
       }
       break;
@@ -320,6 +332,87 @@ bool getInputToggled(keys key)
   return false;
 }
 
+/**
+ * Pass an event from a Ticker callback to the main loop and wake it up
+ */
+void queueInputEvent(inputEventType type, uint8_t key, uint16_t value)
+{
+  inputEvent event = { millis(), (uint8_t) type, key, value };
+  if(!inputQueue.push(event))
+  {
+    log_w("Input event queue full, dropping event %u", type);
+  }
+  // battery and calibration updates can wait for the next regular loop pass
+  if(type == EVENT_KEY_DOWN || type == EVENT_KEY_UP || type == EVENT_SPEED)
+  {
+    postEvent();
+  }
+}
+
+/**
+ * Update key states, speed and battery status from a single input event
+ */
+void handleInputEvent(const inputEvent &event)
+{
+  switch(event.type)
+  {
+    case EVENT_KEY_DOWN:
+      inputState[event.key] = true;
+      inputPressed[event.key] = true;
+      inputToggled[event.key] = true;
+      break;
+
+    case EVENT_KEY_UP:
+      inputState[event.key] = false;
+      inputToggled[event.key] = true;
+      break;
+
+    case EVENT_SPEED:
+      setSpeed(event.value / 2);
+      break;
+
+    case EVENT_BATTERY:
+      if(event.value < EMPTY_BATTERY_THRESHOLD)
+      {
+        lowBattery = emptyBattery = true;
+      }
+      else if(event.value < LOW_BATTERY_THRESHOLD)
+      {
+        emptyBattery = true;
+      }
+      else
+      {
+        lowBattery = emptyBattery = false;
+      }
+      batteryVoltage = event.value;
+      break;
+
+    case EVENT_CALIBRATION:
+      saveAnalog = true;
+      break;
+  }
+}
+
+/**
+ * Take all events from the Ticker callbacks and update key states, speed and battery status
+ *
+ * Called by handleThrottle(), call directly only when waiting for a key outside the main loop
+ */
+void processInputEvents(void)
+{
+  inputEvent event;
+
+  while(inputQueue.pop(event))
+  {
+    uint32_t latency = millis() - event.time;
+    if(latency > inputLatencyMax)
+    {
+      inputLatencyMax = latency;
+    }
+    handleInputEvent(event);
+  }
+}
+
 /**
  * Callback function for debouncing keys
  */
@@ -329,27 +422,26 @@ void debounceInputCallback(void)
 
   for(uint8_t index = KEY_F0; index <= KEY_LOCO4; index++)
   {
-    if(digitalRead(KEY_PIN[index]) == LOW && inputState[index] == false)
+    if(readKey((keys) index) && debouncedState[index] == false)
     {
       if(counter[index] >= 4)
       {
-        inputState[index] = true;
-        inputPressed[index] = true;
-        inputToggled[index] = true;
+        debouncedState[index] = true;
         counter[index] = 0;
+        queueInputEvent(EVENT_KEY_DOWN, index, 0);
       }
       else
       {
         counter[index]++;
       }
     }
-    else if(digitalRead(KEY_PIN[index]) == HIGH && inputState[index] == true)
+    else if(!readKey((keys) index) && debouncedState[index] == true)
     {
       if (counter[index] >= 4)
       {
-        inputState[index] = false;
-        inputToggled[index] = true;
+        debouncedState[index] = false;
         counter[index] = 0;
+        queueInputEvent(EVENT_KEY_UP, index, 0);
       }
       else
       {
@@ -363,14 +455,7 @@ void debounceInputCallback(void)
   }
 
   // abuse this to set flashlight correctly
-  if(inputState[KEY_SHIFT])
-  {
-    digitalWrite(FLASHLIGHT, HIGH);
-  }
-  else
-  {
-    digitalWrite(FLASHLIGHT, LOW);
-  }
+  setFlashlight(debouncedState[KEY_SHIFT]);
 }
 
 /**
@@ -403,6 +488,9 @@ bool blockDirectionChange()
  */
 void handleThrottle(void)
 {
+  processInputEvents();
+  handleAnalogInput();
+
   setReverse(reverseOut);
   
   // handle direction switch
@@ -465,6 +553,12 @@ void handleThrottle(void)
     }
   }
 
+  // speed knob turned to zero - it does not count while the speed is only zero due to the center position
+  if(speedKnobAtZero && !(centerFunction == CENTER_FUNCTION_ZEROSPEED && centerPosition))
+  {
+    directionChangeBlocked = false;
+  }
+
   // handle f0 key
   if(getInputToggled(KEY_F0))
   {
@@ -552,13 +646,12 @@ void handleThrottle(void)
         // disconnect and start config mode
         setESTOP();
         locoDisconnect();
-        initWiFiConfigSTA();
-        switchState(STATE_CONFIG_STATION_WAITING, 120 * 1000);
+        switchState(STATE_CONFIG_STATION_WAITING);
       }
       else if(wiFredState == STATE_CONFIG_STATION || wiFredState == STATE_CONFIG_STATION_WAITING)
       {
         shutdownWiFiConfigSTA();
-        switchState(STATE_STARTUP, TOTAL_NETWORK_TIMEOUT_MS);
+        switchState(STATE_STARTUP);
       }
     }
   }
@@ -578,119 +671,109 @@ void handleThrottle(void)
 }
 
 /**
- * Analog to digital converter callback
+ * Hand a speed, battery or calibration update from the A/D converter
+ * processing directly to the main loop state (it already runs there)
+ */
+void analogEvent(inputEventType type, uint16_t value)
+{
+  inputEvent event = { millis(), (uint8_t) type, 0, value };
+  handleInputEvent(event);
+}
+
+/**
+ * Process one block of averaged A/D converter results
+ *
+ * Does not access the hardware, so it can be fed with recorded sample streams
+ *
+ * @param potiRaw raw A/D converter value of the speed potentiometer
+ * @param battMilliVolts voltage at the battery A/D converter input in milliVolt
  */
-void adcCallback(void)
+void processAnalogBlock(uint16_t potiRaw, uint16_t battMilliVolts)
 {
-  static unsigned int counter = 0;
-  static uint32_t speedBuffer = 0;
-  static uint32_t batteryBuffer = 0;
   static uint8_t oldSpeed = 0;
+  static uint32_t newMin = 0;
+  static uint32_t newMax = 0;
+  static uint8_t newMinCounter = 0;
+  static uint8_t newMaxCounter = 0;
 
-  if(counter % 2)
-  {
-    speedBuffer += analogRead(ANALOG_PIN_POTI);
-  }
-  else
-  {
-    batteryBuffer += analogReadMilliVolts(ANALOG_PIN_VBATT);
-  }
-  counter++;
+  uint32_t speedBuffer = filterPoti(potiRaw);
 
-  if(counter >= NUM_SAMPLES * 2)
+  if(potiMin >= potiMin / 50)
   {
-    static uint32_t newMin = 0;
-    static uint32_t newMax = 0;
-    static uint8_t newMinCounter = 0;
-    static uint8_t newMaxCounter = 0;
-    
-    speedBuffer /= NUM_SAMPLES;
-    
-    if(potiMin >= potiMin / 50)
+    if(speedBuffer < potiMin - potiMin / 50)
     {
-      if(speedBuffer < potiMin - potiMin / 50)
-      {
-        newMin += speedBuffer;
-        newMinCounter++;
-        if(newMinCounter >= NUM_OVERSHOOT)
-        {
-          potiMin = newMin / NUM_OVERSHOOT;
-          saveAnalog = true;
-          newMin = newMinCounter = 0;
-        }
-      }
-      else
+      newMin += speedBuffer;
+      newMinCounter++;
+      if(newMinCounter >= NUM_OVERSHOOT)
       {
+        potiMin = newMin / NUM_OVERSHOOT;
+        analogEvent(EVENT_CALIBRATION, 0);
         newMin = newMinCounter = 0;
       }
     }
-    if(speedBuffer > potiMax + potiMax / 50)
-    {
-      newMax += speedBuffer;
-      newMaxCounter++;
-      if(newMaxCounter >= NUM_OVERSHOOT)
-      {
-        potiMax = newMax / NUM_OVERSHOOT;
-        saveAnalog = true;
-        newMax = newMaxCounter = 0;
-      }
-    }
-    else
-    {
-      newMax = newMaxCounter = 0;
-    }
-    uint8_t tempSpeed;
-    if(speedBuffer > potiMax)
-    {
-      tempSpeed = 0;
-    }
-    else if(speedBuffer < potiMin)
-    {
-      tempSpeed = 253;
-    }
     else
     {
-      tempSpeed = map(speedBuffer, potiMin, potiMax, 253, 0);
-    }
-    if(centerFunction == CENTER_FUNCTION_ZEROSPEED && centerPosition)
-    {
-      tempSpeed = 0;
-    }
-    else if(tempSpeed < 2)
-    {
-      directionChangeBlocked = false;
-    }
-    int8_t delta = tempSpeed - oldSpeed;
-    if(delta < -1 || delta > 1)
-    {
-      log_d("Old speed: %u, new speed: %u", oldSpeed, tempSpeed);
-      setSpeed(tempSpeed / 2);
-      oldSpeed = tempSpeed;
-    }
-
-    batteryBuffer /= NUM_SAMPLES;
-    batteryBuffer *= battFactor * 2.0;
-    if(batteryBuffer > 4200)
-    {
-      battFactor = battFactor * 4200.0f / batteryBuffer;
-      batteryBuffer = 4200;
-      saveAnalog = true;
-    }
-    if(batteryBuffer < EMPTY_BATTERY_THRESHOLD)
-    {
-      lowBattery = emptyBattery = true;
-    }
-    else if(batteryBuffer < LOW_BATTERY_THRESHOLD)
-    {
-      emptyBattery = true;
+      newMin = newMinCounter = 0;
     }
-    else
+  }
+  if(speedBuffer > potiMax + potiMax / 50)
+  {
+    newMax += speedBuffer;
+    newMaxCounter++;
+    if(newMaxCounter >= NUM_OVERSHOOT)
     {
-      lowBattery = emptyBattery = false;
+      potiMax = newMax / NUM_OVERSHOOT;
+      analogEvent(EVENT_CALIBRATION, 0);
+      newMax = newMaxCounter = 0;
     }
+  }
+  else
+  {
+    newMax = newMaxCounter = 0;
+  }
+  uint8_t tempSpeed;
+  if(speedBuffer > potiMax)
+  {
+    tempSpeed = 0;
+  }
+  else if(speedBuffer < potiMin)
+  {
+    tempSpeed = 253;
+  }
+  else
+  {
+    tempSpeed = map(speedBuffer, potiMin, potiMax, 253, 0);
+  }
+  if(speedFilter.binning)
+  {
+    tempSpeed = binSpeed(tempSpeed, getSpeedSteps());
+  }
+  speedKnobAtZero = tempSpeed < 2;
+  if(centerFunction == CENTER_FUNCTION_ZEROSPEED && centerPosition)
+  {
+    tempSpeed = 0;
+  }
+  int8_t delta = tempSpeed - oldSpeed;
+  if(delta < -1 || delta > 1)
+  {
+    log_d("Old speed: %u, new speed: %u", oldSpeed, tempSpeed);
+    analogEvent(EVENT_SPEED, tempSpeed);
+    oldSpeed = tempSpeed;
+  }
 
-    batteryVoltage = batteryBuffer;
-    batteryBuffer = speedBuffer = counter = 0;
+  uint32_t batteryBuffer = battMilliVolts * battFactor * 2.0;
+  if(batteryBuffer > 4200)
+  {
+    battFactor = battFactor * 4200.0f / batteryBuffer;
+    batteryBuffer = 4200;
+    analogEvent(EVENT_CALIBRATION, 0);
+  }
+  // only pass on changes
+  static uint16_t oldBattery = 0;
+  if(batteryBuffer != oldBattery)
+  {
+    analogEvent(EVENT_BATTERY, batteryBuffer);
+    oldBattery = batteryBuffer;
   }
 }
 
@@ -703,7 +786,28 @@ void adcReduce(void)
   {
     potiMax--;
   }
-  saveAnalog = true;
+  analogEvent(EVENT_CALIBRATION, 0);
+}
+
+/**
+ * Fetch a new block from the A/D converter if there is one and reduce the
+ * calibration values from time to time
+ */
+void handleAnalogInput(void)
+{
+  uint16_t potiRaw;
+  uint16_t battMilliVolts;
+
+  if(readAnalogBlock(potiRaw, battMilliVolts))
+  {
+    processAnalogBlock(potiRaw, battMilliVolts);
+  }
+
+  if(millis() - lastCalibReduce >= CALIB_REDUCE_PERIOD)
+  {
+    lastCalibReduce = millis();
+    adcReduce();
+  }
 }
 
 /**
@@ -761,33 +865,18 @@ void showVoltageIfOff(String ledFwd, String ledRev, String ledStop)
  */
 void initThrottle(void)
 {
-  // Set all LED ports as outputs
-  pinMode(LED_STOP, OUTPUT);
-  pinMode(LED_FWD, OUTPUT);
-  pinMode(LED_REV, OUTPUT);
-  pinMode(FLASHLIGHT, OUTPUT);
-  
-  // Set all key inputs to pullup, all loco selection switch inputs to floating
-  for(int k = KEY_F0; k <= KEY_REV; k++)
-  {
-    pinMode(KEY_PIN[k], INPUT_PULLUP); 
-  }
+  initHardware();
+
+  // loco selection switches are active low (switch off means key pressed)
   for(int k = KEY_LOCO1; k <= KEY_LOCO4; k++)
   {
-    pinMode(KEY_PIN[k], INPUT);
-    inputState[k] = true;
+    inputState[k] = debouncedState[k] = true;
   }
   
   // Run timer to debounce keys
   debounceInput.attach_ms(10, debounceInputCallback);
 
-  // Run timer to read analog inputs
-  analogInput.attach_ms(2, adcCallback);
-
-  // Run timer to recalibrate zero speed
-  reduceCalibValues.attach(10, adcReduce);
-
-  // Set ADC attenuation for the two pins used
-  analogSetPinAttenuation(ANALOG_PIN_POTI, ADC_11db);
-  analogSetPinAttenuation(ANALOG_PIN_VBATT, ADC_11db);
+  // Sample analog inputs in the background, wake up the main loop for each block
+  lastCalibReduce = millis();
+  startAnalogSampling(postEventFromISR);
 }
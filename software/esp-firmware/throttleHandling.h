@@ -25,26 +25,16 @@
 //sloeber>> #include <WString.h>       // class String
 //sloeber>> #include <esp32-hal-log.h> // log_d()
 
-#define LED_STOP 14
-#define LED_FWD 39
-#define LED_REV 15
-#define FLASHLIGHT 33
-
-enum keys { KEY_F0, KEY_F1, KEY_F2, KEY_F3, KEY_F4, KEY_F5, KEY_F6, KEY_F7, KEY_F8,
-            KEY_ESTOP, KEY_SHIFT, KEY_FWD, KEY_REV,
-            KEY_LOCO1, KEY_LOCO2, KEY_LOCO3, KEY_LOCO4 };
-
-const int KEY_PIN[] = { 3, 11, 4, 37, 12, 5, 38, 13, 6,
-            10, 40, 16, 36,
-            34, 35, 2, 1 };
-
-#define ANALOG_PIN_VBATT 8
-#define ANALOG_PIN_POTI 9
+#include "hardware.h"
+#include "spscQueue.h"
 
 #define LOW_BATTERY_THRESHOLD 3550
 #define EMPTY_BATTERY_THRESHOLD 3450
 
-#define NUM_SAMPLES 16
+/**
+ * Period in ms after which potiMax is reduced by one
+ */
+#define CALIB_REDUCE_PERIOD 10000
 
 #define NUM_OVERSHOOT 16
 
@@ -53,6 +43,31 @@ const int KEY_PIN[] = { 3, 11, 4, 37, 12, 5, 38, 13, 6,
 
 #define CENTER_FUNCTION_ESTOP_TIMEOUT 500
 
+/**
+ * Events passed from the Ticker callbacks and the A/D converter processing to the main loop
+ */
+enum inputEventType { EVENT_KEY_DOWN, EVENT_KEY_UP, EVENT_SPEED, EVENT_BATTERY, EVENT_CALIBRATION };
+
+typedef struct
+{
+  uint32_t time;        // millis() when the event was detected
+  uint8_t type;         // inputEventType
+  uint8_t key;          // for key events
+  uint16_t value;       // speed (0..253) or battery voltage in mV
+} inputEvent;
+
+#define INPUT_QUEUE_SIZE 64
+
+/**
+ * Queue from the Ticker callbacks (all running in the esp_timer task) to the main loop
+ */
+extern spscQueue<inputEvent, INPUT_QUEUE_SIZE> inputQueue;
+
+/**
+ * Longest time an input event has waited in the queue in ms
+ */
+extern uint32_t inputLatencyMax;
+
 /**
  * Potentiometer value for zero speed (counterclockwise limit)
  */
@@ -102,6 +117,31 @@ void setLEDvalues(String ledFwd, String ledRev, String ledStop);
  */
 void handleThrottle(void);
 
+/**
+ * Take all events from the Ticker callbacks and update key states, speed and battery status
+ *
+ * Called by handleThrottle(), call directly only when waiting for a key outside the main loop
+ */
+void processInputEvents(void);
+
+/**
+ * Process one block of averaged A/D converter results
+ *
+ * Does not access the hardware, so it can be fed with recorded sample streams
+ *
+ * @param potiRaw raw A/D converter value of the speed potentiometer
+ * @param battMilliVolts voltage at the battery A/D converter input in milliVolt
+ */
+void processAnalogBlock(uint16_t potiRaw, uint16_t battMilliVolts);
+
+/**
+ * Fetch a new block from the A/D converter if there is one and reduce the
+ * calibration values from time to time
+ *
+ * Called by handleThrottle()
+ */
+void handleAnalogInput(void);
+
 /**
  * Initialize key settings and LED timer settings
  */
@@ -0,0 +1,338 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides a versioned JSON API (/api/v1/...) for status and
+ * configuration readout, i.e. for fleet management scripts and the
+ * configuration pages.
+ *
+ * The documents are filled in the main loop, which owns the state they
+ * show, only sending them out is done by the web server task.
+ */
+
+#include <WiFi.h>
+#include <ArduinoJson.h>
+
+#include "webApi.h"
+#include "pageWriter.h"
+#include "wifiHandling.h"
+#include "locoHandling.h"
+#include "config.h"
+#include "lowbat.h"
+#include "stateMachine.h"
+#include "throttleHandling.h"
+#include "gitVersion.h"
+#include "serverDiscovery.h"
+#include "linkStats.h"
+#include "speedFilter.h"
+#include "eventHandling.h"
+
+WebServer * apiServer = nullptr;
+
+/**
+ * Print target calculating the 32 bit FNV-1a hash of everything written to it
+ */
+class fnvHash : public Print
+{
+  public:
+    uint32_t hash = 2166136261u;
+
+    size_t write(uint8_t c) override
+    {
+      hash = (hash ^ c) * 16777619u;
+      return 1;
+    }
+    using Print::write;
+};
+
+/**
+ * Send a JSON document, only the fields requested by ?fields= (if given),
+ * or 304 if the client already has the same document
+ *
+ * @param cacheable false for documents changing on every request, these get no ETag
+ */
+void sendJson(JsonDocument &doc, bool cacheable = true)
+{
+  JsonDocument partial;
+  JsonDocument * out = &doc;
+
+  if(apiServer->hasArg("fields"))
+  {
+    String fields = String(",") + apiServer->arg("fields") + ",";
+    for(JsonPair field : doc.as<JsonObject>())
+    {
+      if(fields.indexOf(String(",") + field.key().c_str() + ",") >= 0)
+      {
+        partial[field.key()] = field.value();
+      }
+    }
+    out = &partial;
+  }
+
+  if(cacheable)
+  {
+    fnvHash hash;
+    serializeJson(*out, hash);
+    char etag[11];
+    snprintf(etag, sizeof(etag), "\"%08x\"", (unsigned int) hash.hash);
+
+    apiServer->sendHeader("ETag", etag);
+    apiServer->sendHeader("Cache-Control", "no-cache");
+    if(apiServer->header("If-None-Match") == etag)
+    {
+      apiServer->send(304);
+      return;
+    }
+  }
+  else
+  {
+    apiServer->sendHeader("Cache-Control", "no-store");
+  }
+
+  pageWriter page(*apiServer, "application/json");
+  serializeJson(*out, page);
+  page.end();
+}
+
+void apiStatus(void)
+{
+  JsonDocument doc;
+
+  runInMainLoop([&doc]()
+  {
+    rttSummary rtt = getRTTSummary();
+
+    doc["name"] = throttleName;
+    doc["firmware"] = REV;
+    doc["state"] = getStateName(wiFredState);
+    doc["uptime"] = millis();
+
+    JsonObject battery = doc["battery"].to<JsonObject>();
+    battery["voltage"] = batteryVoltage;
+    battery["low"] = lowBattery;
+
+    JsonObject wifi = doc["wifi"].to<JsonObject>();
+    wifi["connected"] = WiFi.isConnected();
+    if(WiFi.isConnected())
+    {
+      wifi["ssid"] = WiFi.SSID();
+      wifi["rssi"] = WiFi.RSSI();
+      wifi["ip"] = WiFi.localIP().toString();
+    }
+    wifi["mac"] = WiFi.macAddress();
+
+    JsonObject roundTrip = doc["roundTrip"].to<JsonObject>();
+    roundTrip["samples"] = rtt.count;
+    roundTrip["min"] = rtt.min;
+    roundTrip["avg"] = rtt.avg;
+    roundTrip["p99"] = rtt.p99;
+    roundTrip["max"] = rtt.max;
+    roundTrip["rssi"] = linkRSSI;
+    if(getTCPRetransmits() >= 0)
+    {
+      doc["tcpRetransmits"] = getTCPRetransmits();
+    }
+
+    JsonObject speed = doc["speed"].to<JsonObject>();
+    speed["value"] = getSpeed();
+    speed["steps"] = getSpeedSteps();
+    speed["holdoff"] = getSpeedHoldoff();
+    speed["sent"] = speedCommandsSent;
+    speed["suppressed"] = speedCommandsSuppressed;
+
+    JsonObject loop = doc["loop"].to<JsonObject>();
+    loop["perSecond"] = loopsPerSecond;
+    loop["maxLatency"] = loopLatencyMax;
+    JsonArray latency = loop["latency"].to<JsonArray>();
+    for(uint8_t i = 0; i < LOOP_LATENCY_BUCKETS; i++)
+    {
+      JsonObject bucket = latency.add<JsonObject>();
+      if(i < LOOP_LATENCY_BUCKETS - 1)
+      {
+        bucket["below"] = LOOP_LATENCY_LIMITS[i];
+      }
+      bucket["count"] = loopLatency[i];
+    }
+  });
+
+  // uptime, loop and round trip figures change on every request
+  sendJson(doc, false);
+}
+
+void apiLocos(void)
+{
+  JsonDocument doc;
+  int loco = apiServer->hasArg("loco") ? apiServer->arg("loco").toInt() : 0;
+
+  if(loco < 0 || loco > 4)
+  {
+    apiServer->send(404, "application/json", "{\"error\":\"no such loco\"}");
+    return;
+  }
+
+  runInMainLoop([&doc, loco]()
+  {
+    JsonArray list = doc["locos"].to<JsonArray>();
+    for(uint8_t i = 0; i < 4; i++)
+    {
+      if(loco != 0 && loco != i + 1)
+      {
+        continue;
+      }
+      JsonObject entry = list.add<JsonObject>();
+      entry["id"] = i + 1;
+      entry["address"] = locos[i].address;
+      entry["mode"] = locos[i].mode;
+      entry["direction"] = (int) locos[i].direction;
+      entry["longAddress"] = locos[i].longAddress;
+      JsonArray functions = entry["functions"].to<JsonArray>();
+      for(uint8_t f = 0; f <= MAX_FUNCTION; f++)
+      {
+        functions.add((int) locos[i].functions[f]);
+      }
+    }
+  });
+
+  sendJson(doc);
+}
+
+void apiNetworks(void)
+{
+  JsonDocument doc;
+
+  runInMainLoop([&doc]()
+  {
+    JsonArray list = doc["networks"].to<JsonArray>();
+    for(std::vector<wifiAPEntry>::iterator it = apList.begin() ; it != apList.end(); ++it)
+    {
+      // the key is never sent out
+      JsonObject entry = list.add<JsonObject>();
+      entry["ssid"] = it->ssid;
+      entry["enabled"] = !it->disabled;
+    }
+  });
+
+  sendJson(doc);
+}
+
+void apiServerConfig(void)
+{
+  JsonDocument doc;
+
+  runInMainLoop([&doc]()
+  {
+    doc["name"] = locoServer.name;
+    doc["port"] = locoServer.port;
+    doc["automatic"] = locoServer.automatic;
+    doc["using"] = locoServer.automatic && serverCache.valid ? serverCache.hostname : locoServer.name;
+
+    JsonObject discovery = doc["discovery"].to<JsonObject>();
+    discovery["discoveries"] = discoveryStats.discoveries;
+    discovery["lastDiscoveryTime"] = discoveryStats.lastDiscoveryTime;
+    discovery["cacheConnects"] = discoveryStats.cacheConnects;
+    discovery["connectFailures"] = discoveryStats.connectFailures;
+    discovery["lastConnectTime"] = discoveryStats.lastConnectTime;
+    discovery["revalidations"] = discoveryStats.revalidations;
+    discovery["serverMoved"] = discoveryStats.serverMoved;
+  });
+
+  sendJson(doc);
+}
+
+void apiSystem(void)
+{
+  JsonDocument doc;
+
+  runInMainLoop([&doc]()
+  {
+    doc["centerSwitch"] = centerFunction;
+    doc["maxFunction"] = MAX_FUNCTION;
+
+    JsonObject holdoff = doc["speedHoldoff"].to<JsonObject>();
+    holdoff["min"] = speedHoldoffMin;
+    holdoff["max"] = speedHoldoffMax;
+
+    JsonObject filter = doc["speedFilter"].to<JsonObject>();
+    filter["median"] = speedFilter.medianLength;
+    filter["iir"] = speedFilter.iirShift;
+    filter["binning"] = speedFilter.binning;
+
+    JsonArray modes = doc["modes"].to<JsonArray>();
+    for(int j = 0; j < MODES_LENGTH; j++)
+    {
+      JsonObject mode = modes.add<JsonObject>();
+      mode["value"] = MODES[j].val;
+      mode["text"] = MODES[j].text;
+    }
+  });
+
+  sendJson(doc);
+}
+
+/**
+ * Results of the last background WiFi scan, age in seconds
+ */
+void apiScan(void)
+{
+  JsonDocument doc;
+
+  runInMainLoop([&doc]()
+  {
+    doc["scanning"] = scanRunning;
+    doc["pending"] = scanRequested;
+    doc["refused"] = scanRefused;
+    if(scanTime != 0)
+    {
+      doc["age"] = (millis() - scanTime) / 1000;
+    }
+
+    JsonArray list = doc["networks"].to<JsonArray>();
+    for(std::vector<scanEntry>::iterator it = scanResults.begin(); it != scanResults.end(); it++)
+    {
+      JsonObject entry = list.add<JsonObject>();
+      entry["ssid"] = it->ssid;
+      entry["rssi"] = it->rssi;
+      entry["open"] = it->open;
+    }
+  });
+
+  sendJson(doc, false);
+}
+
+/**
+ * Start a new background WiFi scan, poll /api/v1/scan for its results
+ */
+void apiScanRefresh(void)
+{
+  runInMainLoop(requestWiFiScan);
+  apiServer->send(202);
+}
+
+/**
+ * Register all /api/v1/ endpoints
+ */
+void initWebApi(WebServer &webServer)
+{
+  apiServer = &webServer;
+
+  webServer.on("/api/v1/status", HTTP_GET, apiStatus);
+  webServer.on("/api/v1/locos", HTTP_GET, apiLocos);
+  webServer.on("/api/v1/networks", HTTP_GET, apiNetworks);
+  webServer.on("/api/v1/server", HTTP_GET, apiServerConfig);
+  webServer.on("/api/v1/system", HTTP_GET, apiSystem);
+  webServer.on("/api/v1/scan", HTTP_GET, apiScan);
+  webServer.on("/api/v1/scan/refresh", HTTP_POST, apiScanRefresh);
+}
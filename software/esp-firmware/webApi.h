@@ -0,0 +1,47 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides a versioned JSON API (/api/v1/...) for status and
+ * configuration readout, i.e. for fleet management scripts and the
+ * configuration pages.
+ */
+
+#ifndef _WEB_API_H_
+#define _WEB_API_H_
+
+#include <WebServer.h>
+
+/**
+ * Register all /api/v1/ endpoints
+ *
+ * GET /api/v1/status    battery, WiFi and server connection status, main loop latency
+ * GET /api/v1/locos     loco configuration, ?loco=n for a single loco
+ * GET /api/v1/networks  known WiFi networks (without keys)
+ * GET /api/v1/server    loco server configuration and discovery statistics
+ * GET /api/v1/system    speed knob and direction switch settings, speed step modes
+ * GET /api/v1/scan      results of the last WiFi scan, taken in the background,
+ *                       "refused" if the last refresh timed out waiting for the locos
+ * POST /api/v1/scan/refresh  start a new WiFi scan
+ *
+ * All endpoints take ?fields=a,b to return only these top level fields. All
+ * but status and scan (which carry the uptime and the age of the results)
+ * answer with an ETag, repeated requests with If-None-Match get a 304 if
+ * nothing has changed.
+ */
+void initWebApi(WebServer &webServer);
+
+#endif
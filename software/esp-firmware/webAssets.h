@@ -0,0 +1,431 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file is generated by make-web-assets from the files in webui/, do not edit.
+ */
+
+#ifndef _WEB_ASSETS_H_
+#define _WEB_ASSETS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct
+{
+  const char * path;
+  const char * contentType;
+  const char * etag;
+  const uint8_t * data;  // gzip compressed
+  size_t length;
+} webAsset;
+
+const uint8_t WEB_FUNCMAP_HTML[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x54, 0x51, 0x8b, 0xdb, 0x30,
+  0x0c, 0x7e, 0xef, 0xaf, 0xd0, 0xfc, 0x74, 0x07, 0xbb, 0x76, 0x85, 0x7b, 0x18, 0xc3, 0xc9, 0xc3,
+  0x7a, 0x2b, 0x1b, 0xdc, 0xd8, 0x60, 0xc7, 0xc1, 0x18, 0x7b, 0x50, 0x63, 0xa5, 0xf1, 0xea, 0xd8,
+  0xc1, 0x76, 0x5a, 0xfa, 0xef, 0x27, 0x3b, 0x69, 0x9b, 0x63, 0xac, 0x1b, 0x94, 0xa4, 0x96, 0xa5,
+  0x4f, 0x9f, 0xa4, 0x4f, 0x91, 0xaf, 0x1e, 0xbe, 0xac, 0x9e, 0xbe, 0x7f, 0xfd, 0x00, 0x1f, 0x9f,
+  0x3e, 0x3f, 0x96, 0x33, 0xd9, 0xc4, 0xd6, 0x80, 0x41, 0xbb, 0x2d, 0x04, 0x59, 0x51, 0xca, 0x86,
+  0x50, 0x95, 0xb2, 0xa5, 0x88, 0x50, 0x35, 0xe8, 0x03, 0xc5, 0x42, 0xf4, 0xb1, 0xbe, 0x7b, 0xcb,
+  0x77, 0x51, 0x47, 0x43, 0xe5, 0x41, 0xaf, 0x3d, 0x29, 0xa8, 0x9c, 0xad, 0xf5, 0xb6, 0xf7, 0x18,
+  0xb5, 0xb3, 0xd0, 0xe1, 0x96, 0xe4, 0x62, 0x70, 0x98, 0x49, 0xa3, 0xed, 0x0e, 0x3c, 0x99, 0x42,
+  0x84, 0x78, 0x34, 0x14, 0x1a, 0xa2, 0x28, 0xa0, 0xf1, 0x54, 0x17, 0xe2, 0xa0, 0x6b, 0x0e, 0x9f,
+  0x57, 0x21, 0x30, 0x62, 0xa8, 0xbc, 0xee, 0x22, 0x04, 0x5f, 0x9d, 0x2f, 0x7e, 0x05, 0x01, 0x8a,
+  0x6a, 0xf2, 0xa5, 0x5c, 0x0c, 0xd7, 0xfc, 0x27, 0xb3, 0x9a, 0xc9, 0x8d, 0x53, 0x47, 0x50, 0x18,
+  0xf1, 0x2e, 0xe5, 0x2b, 0x44, 0xdd, 0xdb, 0xaa, 0xc5, 0x2e, 0xd1, 0x5e, 0x96, 0x6b, 0x3e, 0x64,
+  0x2e, 0x6c, 0xe9, 0xb4, 0xdd, 0x42, 0xed, 0x3c, 0x3c, 0xba, 0xca, 0xbd, 0x03, 0x19, 0x3a, 0xb4,
+  0x50, 0x19, 0x0c, 0xa1, 0x10, 0x86, 0x4d, 0x22, 0x81, 0xb3, 0x2d, 0x41, 0x2f, 0x19, 0x58, 0xe9,
+  0x3d, 0x68, 0x55, 0x08, 0x6d, 0xf7, 0x68, 0xb4, 0x4a, 0x51, 0xcc, 0x57, 0x2b, 0x45, 0xb6, 0x4c,
+  0x87, 0x2b, 0x08, 0xa0, 0x03, 0x58, 0x17, 0x21, 0x07, 0xce, 0xe1, 0x39, 0xbd, 0x20, 0x79, 0x04,
+  0x40, 0x4f, 0xa0, 0x2d, 0xc4, 0x86, 0xc0, 0x73, 0x87, 0x09, 0x7e, 0x2c, 0xe7, 0xf3, 0xfb, 0x9f,
+  0x73, 0xb9, 0xe0, 0x7c, 0x93, 0xac, 0xf5, 0xc8, 0x7c, 0x95, 0x5b, 0x7a, 0x4e, 0xcc, 0xc3, 0xf1,
+  0x97, 0xaa, 0x5e, 0xf6, 0x3b, 0xd5, 0x66, 0xfe, 0x41, 0xec, 0xe6, 0x61, 0xb5, 0x02, 0x54, 0xca,
+  0x53, 0x08, 0xa7, 0x1e, 0xa4, 0x74, 0xa3, 0xe9, 0xec, 0x78, 0x9b, 0xf2, 0xcc, 0x24, 0x43, 0xb6,
+  0x80, 0x39, 0x59, 0x21, 0xaa, 0x91, 0x0a, 0x0b, 0xa1, 0x71, 0x1c, 0xd3, 0xb9, 0x10, 0x93, 0x02,
+  0x70, 0x63, 0x08, 0x36, 0xce, 0x2b, 0xf2, 0xc5, 0x9b, 0x53, 0xda, 0x13, 0x7f, 0x86, 0x9c, 0xc9,
+  0x98, 0xb0, 0xa2, 0x3a, 0x13, 0x67, 0x55, 0xa8, 0xc1, 0xf2, 0xd4, 0x78, 0x17, 0x59, 0x20, 0xa9,
+  0x94, 0xe8, 0x9d, 0x31, 0xa4, 0xae, 0x5e, 0xbe, 0x4e, 0x55, 0x56, 0x04, 0xad, 0x6b, 0xc9, 0x46,
+  0xf4, 0xc7, 0xff, 0xf2, 0xe6, 0x1e, 0xec, 0x78, 0xfa, 0x57, 0x7d, 0x41, 0xd7, 0x3c, 0x15, 0x1e,
+  0x1c, 0xff, 0xd2, 0x74, 0x9c, 0x35, 0xc7, 0xdc, 0xce, 0x4b, 0xd4, 0x3a, 0x83, 0x9d, 0x2a, 0x03,
+  0x34, 0x07, 0x3c, 0x06, 0x98, 0x96, 0xf3, 0x17, 0x8f, 0xba, 0xbe, 0xb8, 0x7c, 0xda, 0x5a, 0xe7,
+  0x27, 0x3e, 0x3b, 0x1a, 0x6a, 0xe0, 0x47, 0xee, 0x52, 0xd6, 0xf3, 0x54, 0x01, 0x79, 0x28, 0xd9,
+  0x3c, 0x74, 0x92, 0x41, 0x98, 0xb6, 0x49, 0x63, 0x2a, 0xee, 0x4b, 0xa9, 0x6d, 0xd7, 0x47, 0x88,
+  0xc7, 0x8e, 0xb5, 0x3f, 0x88, 0x44, 0x80, 0xc5, 0x96, 0xc6, 0xc9, 0x67, 0xa8, 0x51, 0x03, 0x53,
+  0xd7, 0xd0, 0x6f, 0x5a, 0xcd, 0x0b, 0xc8, 0x12, 0xed, 0xf9, 0xf8, 0x0d, 0xf7, 0x13, 0x4e, 0x2f,
+  0x75, 0x85, 0x56, 0xf1, 0xe2, 0xc6, 0xde, 0xb3, 0x6c, 0x1d, 0x6f, 0x92, 0x1e, 0x56, 0x3b, 0xd3,
+  0x1a, 0x79, 0xf3, 0x23, 0xa9, 0x80, 0xdf, 0x49, 0x31, 0xcc, 0x73, 0x54, 0x33, 0x8b, 0x48, 0xe2,
+  0xb8, 0xe4, 0x0b, 0x51, 0xbe, 0xc7, 0x6a, 0x77, 0xc6, 0xf8, 0xf3, 0x63, 0x01, 0x37, 0xbd, 0x0d,
+  0x4c, 0x44, 0xe5, 0x7d, 0x86, 0x83, 0x36, 0x06, 0x36, 0x69, 0x7a, 0x21, 0xde, 0xca, 0x05, 0x96,
+  0x19, 0x6e, 0x91, 0x3b, 0xc1, 0x3b, 0xca, 0x1f, 0xa9, 0x72, 0xf6, 0x1b, 0x8f, 0x49, 0x71, 0x5d,
+  0xbc, 0x04, 0x00, 0x00,
+};
+
+const uint8_t WEB_INDEX_HTML[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x58, 0xdd, 0x6f, 0xdb, 0x36,
+  0x10, 0x7f, 0xf7, 0x5f, 0xc1, 0xe9, 0x65, 0x2d, 0x90, 0xc4, 0x4d, 0xd2, 0x6e, 0x45, 0x20, 0x6b,
+  0x70, 0x9d, 0x66, 0x2d, 0x9a, 0x64, 0x41, 0xec, 0xb6, 0xe8, 0xde, 0x68, 0x89, 0xb2, 0xd8, 0x48,
+  0xa4, 0x40, 0x9e, 0xe2, 0x7a, 0x7f, 0xfd, 0x8e, 0x1f, 0xfa, 0xb0, 0x2d, 0x3b, 0x2e, 0x02, 0x6c,
+  0x2f, 0x49, 0x78, 0xdf, 0x77, 0xfc, 0xdd, 0xf1, 0x94, 0xf0, 0x97, 0xcb, 0xbf, 0x26, 0xb3, 0x6f,
+  0x77, 0xef, 0xc9, 0x87, 0xd9, 0xcd, 0x75, 0x34, 0x08, 0x33, 0x28, 0x72, 0x92, 0x53, 0xb1, 0x18,
+  0x05, 0x4c, 0x04, 0x51, 0x98, 0x31, 0x9a, 0x44, 0x61, 0xc1, 0x80, 0x92, 0x38, 0xa3, 0x4a, 0x33,
+  0x18, 0x05, 0x15, 0xa4, 0xc7, 0x6f, 0x91, 0x07, 0x1c, 0x72, 0x16, 0x2d, 0xf9, 0x95, 0x62, 0x09,
+  0x89, 0xa5, 0x48, 0xf9, 0xa2, 0x52, 0x14, 0xb8, 0x14, 0xa4, 0xa4, 0x0b, 0x16, 0x0e, 0x9d, 0xc0,
+  0x20, 0xcc, 0xb9, 0x78, 0x20, 0x8a, 0xe5, 0xa3, 0x40, 0xc3, 0x2a, 0x67, 0x3a, 0x63, 0x0c, 0x02,
+  0x92, 0x29, 0x96, 0x8e, 0x82, 0x25, 0x4f, 0x51, 0xfd, 0x24, 0xd6, 0x1a, 0x2d, 0xea, 0x58, 0xf1,
+  0x12, 0x88, 0x56, 0x71, 0xc3, 0xf8, 0xae, 0x03, 0x92, 0xb0, 0x94, 0xa9, 0x28, 0x1c, 0x3a, 0x36,
+  0xfe, 0x61, 0xa3, 0x1a, 0x84, 0x73, 0x99, 0xac, 0x48, 0x42, 0x81, 0x1e, 0x1b, 0x7f, 0xa3, 0xa0,
+  0xa0, 0xdc, 0xc6, 0x7c, 0xba, 0x2f, 0x28, 0xe4, 0x62, 0x9a, 0x2a, 0xfa, 0x93, 0x09, 0xa6, 0x68,
+  0xbe, 0x21, 0x43, 0x45, 0x42, 0x34, 0x50, 0xa8, 0xb4, 0x91, 0x19, 0x84, 0xa9, 0x54, 0x05, 0xa1,
+  0xb1, 0xe1, 0x8d, 0x02, 0x27, 0x1a, 0x10, 0x2c, 0x47, 0x26, 0x93, 0x51, 0x50, 0x4a, 0x0d, 0xa6,
+  0x0e, 0x74, 0x9e, 0x33, 0x32, 0x97, 0x2a, 0x61, 0x6a, 0xf4, 0x0a, 0x95, 0x00, 0x83, 0x85, 0x24,
+  0x9a, 0x65, 0x4a, 0x02, 0x56, 0x80, 0x08, 0x5a, 0xb0, 0x0b, 0x2c, 0x47, 0x62, 0xc9, 0x21, 0x17,
+  0x65, 0x05, 0x04, 0x56, 0x25, 0x86, 0x0c, 0xec, 0x07, 0x96, 0xc2, 0x08, 0xe0, 0xdf, 0x5e, 0xfe,
+  0x16, 0x4f, 0x01, 0xe1, 0xc9, 0x06, 0x25, 0xb2, 0x16, 0x06, 0x5b, 0x26, 0x74, 0x35, 0x2f, 0x38,
+  0x1a, 0x79, 0xa4, 0x79, 0x85, 0xc7, 0x29, 0x7d, 0x74, 0x1e, 0xbd, 0x02, 0xfe, 0x30, 0xb5, 0xb3,
+  0x41, 0xe2, 0x6f, 0x93, 0x90, 0x31, 0xb2, 0x23, 0xe6, 0x77, 0x14, 0x80, 0xa9, 0x15, 0x79, 0x94,
+  0x39, 0x60, 0xb9, 0x2e, 0x48, 0x1b, 0xb6, 0x2e, 0xa9, 0xb0, 0x51, 0xcd, 0x9d, 0xcc, 0x17, 0x27,
+  0x62, 0xdc, 0x18, 0x56, 0x44, 0x8a, 0x2f, 0x5b, 0x32, 0xd7, 0x72, 0xd9, 0xf0, 0xdb, 0x68, 0x1a,
+  0x6f, 0x57, 0x5c, 0x15, 0x4b, 0xaa, 0x18, 0x82, 0xe3, 0x91, 0x6b, 0xac, 0x71, 0xeb, 0xcf, 0x5a,
+  0x49, 0x3d, 0xff, 0xde, 0xb3, 0xfb, 0x52, 0xf2, 0xb9, 0x44, 0xb5, 0xcd, 0x31, 0x5e, 0x16, 0x56,
+  0xe0, 0x2b, 0xbf, 0xe2, 0x44, 0x30, 0x58, 0x4a, 0xf5, 0x40, 0xa6, 0xd3, 0x8f, 0x97, 0x17, 0x6b,
+  0x96, 0xb5, 0xe6, 0x49, 0xd0, 0x17, 0xd2, 0x94, 0x2f, 0x04, 0xa2, 0x42, 0x83, 0x62, 0x62, 0x01,
+  0xd9, 0x86, 0x96, 0x65, 0x4e, 0x3d, 0xaf, 0x5f, 0x9f, 0xa9, 0x47, 0xa6, 0x88, 0x92, 0x15, 0x22,
+  0x09, 0x10, 0xaf, 0xeb, 0x16, 0x2c, 0x7d, 0x86, 0xe4, 0x5e, 0xe5, 0xd9, 0xe4, 0x0e, 0x4b, 0x01,
+  0x8a, 0x0a, 0x5d, 0x70, 0x6d, 0x32, 0xd6, 0xeb, 0xea, 0x10, 0x97, 0xf7, 0x35, 0x1f, 0x74, 0xaf,
+  0x0d, 0x9b, 0xf8, 0x74, 0x36, 0x26, 0x37, 0xe3, 0x09, 0xa1, 0x49, 0xa2, 0x98, 0xde, 0x30, 0x62,
+  0xf0, 0x8d, 0xa6, 0x91, 0xdf, 0x67, 0x00, 0x1b, 0x22, 0x37, 0xf7, 0x35, 0x3a, 0x8b, 0x42, 0xea,
+  0x9b, 0xf4, 0x64, 0x98, 0xe6, 0x54, 0x67, 0xa6, 0x1f, 0xcd, 0x80, 0x08, 0xa2, 0x2b, 0x73, 0x24,
+  0xa6, 0xc5, 0xae, 0xdf, 0x5f, 0x12, 0x90, 0x68, 0x97, 0x09, 0xe0, 0xe9, 0x8a, 0xb8, 0xce, 0x0b,
+  0x87, 0xf4, 0x60, 0xd3, 0x26, 0x1c, 0xa6, 0xbd, 0xe1, 0xa9, 0x39, 0x90, 0x82, 0xc6, 0x19, 0x17,
+  0xcc, 0x76, 0x22, 0xd7, 0xc0, 0x63, 0xbd, 0x6e, 0xb0, 0xb9, 0xfb, 0x41, 0x98, 0xf0, 0x47, 0x9b,
+  0x54, 0x2e, 0x63, 0x69, 0x0b, 0x82, 0x04, 0xe3, 0x90, 0x15, 0x65, 0x6e, 0x4c, 0xd5, 0xbc, 0x99,
+  0x27, 0x04, 0xae, 0xfb, 0xaf, 0x91, 0xb4, 0xd1, 0xfa, 0xd8, 0x19, 0xc4, 0x48, 0x22, 0x06, 0x2d,
+  0x8c, 0x63, 0xcc, 0x51, 0x3b, 0xe5, 0x06, 0xc3, 0xcf, 0x1b, 0x08, 0x97, 0x93, 0xf6, 0x46, 0xc8,
+  0x8b, 0xe3, 0x53, 0x53, 0xb8, 0x84, 0x6b, 0x23, 0xfd, 0xd2, 0x26, 0x47, 0xf6, 0xce, 0x07, 0x13,
+  0xc9, 0x89, 0xd7, 0xef, 0xc7, 0x5e, 0xc9, 0xf0, 0x46, 0xa6, 0xc0, 0x4a, 0x72, 0x23, 0x93, 0xba,
+  0x79, 0x9d, 0x51, 0xcd, 0x72, 0x16, 0x43, 0xd7, 0x52, 0x81, 0x22, 0x36, 0x31, 0xcb, 0xe9, 0xb3,
+  0x77, 0xc9, 0x15, 0xb3, 0x99, 0xb6, 0xc3, 0x6b, 0xb0, 0x16, 0x9d, 0xa2, 0x09, 0x97, 0x6b, 0xe1,
+  0x25, 0xb5, 0x4a, 0x33, 0x8f, 0x5e, 0x21, 0x5a, 0xa4, 0xc2, 0x2e, 0x4e, 0x7e, 0x5e, 0xf7, 0x34,
+  0x88, 0xb0, 0xf5, 0x19, 0x3e, 0x3b, 0x3f, 0xaf, 0x7b, 0x16, 0x44, 0x97, 0x52, 0xfc, 0x0a, 0xe6,
+  0xdd, 0x12, 0x0b, 0x34, 0xb0, 0x9d, 0xdf, 0xb5, 0x14, 0x0b, 0x32, 0x76, 0x05, 0xfd, 0x63, 0xc7,
+  0x05, 0xc4, 0x19, 0x8b, 0x1f, 0xe6, 0xf2, 0xc7, 0x9a, 0xb7, 0x1c, 0x15, 0xc7, 0xbb, 0x2f, 0x62,
+  0x1d, 0xe7, 0x1e, 0x47, 0x69, 0x25, 0xe2, 0x82, 0x96, 0xf5, 0xbb, 0xe7, 0x8f, 0x75, 0x3f, 0xe1,
+  0xc9, 0x82, 0x10, 0x49, 0x25, 0x17, 0x8b, 0x1d, 0x70, 0x5f, 0x8b, 0x2c, 0xe3, 0x09, 0x36, 0x5d,
+  0x37, 0xae, 0xe0, 0xe9, 0x87, 0x21, 0x6f, 0x71, 0x1f, 0xb4, 0xaf, 0xc1, 0xb0, 0x6e, 0x17, 0xd3,
+  0x51, 0xd8, 0x1d, 0x76, 0x86, 0xac, 0x75, 0x87, 0x7b, 0x0d, 0x37, 0x80, 0xbd, 0x99, 0xee, 0x79,
+  0xdb, 0xd6, 0x3a, 0xa6, 0xe2, 0x2b, 0x4f, 0x79, 0xdd, 0xd6, 0x78, 0xb4, 0x0d, 0xe6, 0x27, 0xb2,
+  0x7e, 0x62, 0x40, 0x9c, 0x47, 0x9f, 0x84, 0x5c, 0xba, 0xe7, 0x98, 0x09, 0xe3, 0x35, 0x59, 0x9b,
+  0xe8, 0xf5, 0x44, 0xf3, 0xca, 0x76, 0x11, 0x30, 0x9d, 0xee, 0x65, 0x6f, 0xbd, 0x94, 0xbd, 0x1c,
+  0xc3, 0xdc, 0xed, 0x61, 0x8e, 0xe5, 0xf2, 0x3d, 0x78, 0x98, 0x8b, 0x5a, 0xf8, 0x20, 0x1f, 0x87,
+  0x8c, 0x8b, 0xc1, 0x2d, 0x5b, 0xba, 0x17, 0x8a, 0xec, 0x6c, 0x7d, 0x5c, 0x86, 0xb8, 0x11, 0xf1,
+  0xd2, 0x77, 0xd3, 0x4f, 0x4f, 0x08, 0x7f, 0x7a, 0xff, 0x2d, 0xd8, 0xc0, 0xcb, 0x06, 0x1c, 0x6e,
+  0xa8, 0xa8, 0x68, 0x9e, 0xaf, 0xcc, 0x44, 0xaa, 0x73, 0x6e, 0x20, 0xd1, 0x87, 0xbd, 0xfa, 0x6a,
+  0x11, 0xf5, 0x40, 0x15, 0xf8, 0x9b, 0xbd, 0x77, 0x27, 0x3f, 0xf7, 0xcd, 0x44, 0x73, 0x77, 0x80,
+  0x26, 0x97, 0xae, 0x9e, 0xb8, 0x33, 0x02, 0x42, 0xda, 0x5e, 0xf9, 0x60, 0x8d, 0x82, 0x4a, 0x79,
+  0x4e, 0x84, 0x04, 0x32, 0x67, 0xb6, 0x48, 0x08, 0xd0, 0x0a, 0x9f, 0x91, 0x9c, 0xd4, 0x3e, 0x06,
+  0xed, 0xb0, 0xd6, 0xee, 0x61, 0xed, 0x41, 0xe5, 0x73, 0x46, 0x72, 0xd7, 0xb4, 0x01, 0x5b, 0x29,
+  0x15, 0xf8, 0xb9, 0x39, 0x78, 0x7a, 0x18, 0x3b, 0xc5, 0x76, 0x5f, 0xeb, 0x9c, 0xa3, 0x8b, 0x43,
+  0x54, 0xef, 0xd0, 0x5d, 0x57, 0xd5, 0x9e, 0x7b, 0x1b, 0xc3, 0x0d, 0x11, 0xc5, 0x17, 0x19, 0x04,
+  0x07, 0x4c, 0x28, 0x5a, 0x81, 0x2c, 0xb0, 0x46, 0x71, 0xd7, 0xfa, 0xb8, 0x21, 0x46, 0xcd, 0x40,
+  0xbf, 0xe2, 0x66, 0xe3, 0xf5, 0x05, 0xa8, 0xf9, 0x16, 0x17, 0x66, 0xf9, 0xac, 0x16, 0x19, 0xf9,
+  0x9b, 0x29, 0x69, 0xaa, 0x3a, 0x7c, 0x27, 0xc5, 0x77, 0x59, 0x29, 0xc2, 0x85, 0x06, 0x5c, 0xc0,
+  0x4f, 0xf6, 0x0e, 0xbe, 0xcf, 0x1a, 0x6f, 0x98, 0xb4, 0x0b, 0xa1, 0x73, 0x61, 0xa9, 0x7b, 0x36,
+  0xc2, 0xd6, 0x40, 0x47, 0xe9, 0x92, 0xeb, 0x58, 0xe2, 0xef, 0xd5, 0x53, 0xb3, 0xf6, 0xa0, 0xe1,
+  0xe7, 0x73, 0xad, 0x31, 0xb8, 0x6f, 0x4b, 0xb6, 0xe0, 0xf3, 0xc0, 0xd6, 0x2b, 0x4c, 0xba, 0x78,
+  0x3e, 0xe0, 0x26, 0xb8, 0x27, 0xa1, 0x7b, 0x94, 0xe2, 0x76, 0xe0, 0xcb, 0x94, 0x34, 0x6f, 0x17,
+  0xd1, 0x4b, 0x0e, 0x71, 0xd6, 0xf9, 0x54, 0xf0, 0xaf, 0xb6, 0xa9, 0x45, 0x6c, 0x15, 0xa7, 0x56,
+  0xa2, 0xbe, 0xea, 0x35, 0x1a, 0xfa, 0x90, 0xa5, 0x35, 0xe3, 0x73, 0x3e, 0xc6, 0x27, 0xf0, 0x56,
+  0xfa, 0x40, 0xc3, 0xa1, 0x63, 0x6e, 0x4b, 0xe1, 0x23, 0x6b, 0xae, 0x98, 0x68, 0xb3, 0x3d, 0x74,
+  0xc4, 0x9a, 0xc5, 0xe0, 0xa9, 0xb2, 0xfa, 0x52, 0xee, 0xfd, 0xde, 0x78, 0xd6, 0x77, 0x14, 0x2f,
+  0x90, 0x8c, 0x13, 0x8a, 0x31, 0xe1, 0xa2, 0xc4, 0x4b, 0x2f, 0x0a, 0x6c, 0x57, 0x4d, 0x5e, 0xc0,
+  0x92, 0xc7, 0x0c, 0xb1, 0xca, 0x3a, 0x2b, 0x37, 0x01, 0xd4, 0x38, 0x22, 0x71, 0xa5, 0x70, 0x51,
+  0x07, 0x84, 0x72, 0x07, 0x86, 0x46, 0xfd, 0x83, 0xcc, 0x13, 0x99, 0xa6, 0x9d, 0x2f, 0x17, 0xfd,
+  0xf2, 0xa2, 0xed, 0x79, 0x0a, 0x24, 0x67, 0x54, 0xc3, 0xee, 0x09, 0xdb, 0xb5, 0x72, 0x83, 0xdf,
+  0x9c, 0x5b, 0xa6, 0x2d, 0x51, 0xf3, 0x7f, 0xd8, 0xe8, 0x8d, 0xb1, 0x7e, 0x34, 0x40, 0x9b, 0x85,
+  0x3c, 0xd8, 0x24, 0xfd, 0xd1, 0x63, 0xd2, 0x10, 0x5b, 0x93, 0x83, 0xff, 0xfd, 0x5a, 0xdc, 0xb6,
+  0xf9, 0x20, 0xe4, 0x9c, 0xa4, 0x3c, 0x47, 0x1c, 0xb6, 0xb8, 0x2d, 0x58, 0xc2, 0xa9, 0xc5, 0xf6,
+  0xfa, 0xde, 0xe9, 0xe4, 0x6e, 0x2c, 0x37, 0xf0, 0x5f, 0x78, 0x1d, 0x4a, 0x83, 0xcd, 0xe8, 0xb4,
+  0xc1, 0x61, 0x4d, 0x39, 0xdf, 0xa2, 0xbc, 0xd9, 0xa2, 0xfc, 0xde, 0x83, 0xde, 0x23, 0xec, 0xfa,
+  0x25, 0x7e, 0xfa, 0x6b, 0xdd, 0x1b, 0xcb, 0xc7, 0x8f, 0xf7, 0xdd, 0x40, 0xcc, 0x71, 0xab, 0x43,
+  0x70, 0x83, 0xc5, 0xfa, 0x6f, 0x7a, 0xeb, 0xec, 0xa8, 0xa7, 0xc3, 0xb3, 0x5d, 0xdc, 0x33, 0xc3,
+  0x7d, 0xbd, 0x8b, 0x7b, 0x6e, 0xb8, 0x6f, 0x77, 0x71, 0x5f, 0x1b, 0xee, 0xe9, 0x6f, 0xbd, 0x49,
+  0xed, 0x7d, 0x01, 0x5c, 0x2e, 0xef, 0xb8, 0x10, 0xe6, 0xfe, 0x3b, 0xe9, 0xd5, 0xa4, 0x88, 0xcc,
+  0xb9, 0x30, 0x6f, 0xb5, 0xeb, 0x26, 0x9c, 0x6c, 0x25, 0xb6, 0xd2, 0xce, 0x7e, 0x31, 0x5f, 0x14,
+  0xba, 0xe9, 0x96, 0x97, 0xff, 0x1d, 0xf4, 0x76, 0xaf, 0xbb, 0xb8, 0x20, 0x30, 0xb8, 0x93, 0xc0,
+  0x1b, 0xc7, 0xa0, 0x2a, 0xb6, 0x7f, 0x01, 0xbe, 0x37, 0x3a, 0xf5, 0x00, 0xa1, 0x39, 0x9f, 0xbb,
+  0x25, 0x22, 0xf8, 0xa9, 0x98, 0xc6, 0x31, 0xe0, 0xda, 0x44, 0xe6, 0x5b, 0xff, 0x27, 0xd9, 0xd5,
+  0xd8, 0xb8, 0x07, 0xd5, 0xff, 0x29, 0xb1, 0x15, 0xed, 0x9c, 0xf7, 0x46, 0x3b, 0x91, 0xca, 0x3c,
+  0x0b, 0x9b, 0x9e, 0x76, 0x44, 0xde, 0x59, 0xce, 0x18, 0x4c, 0x6c, 0xe4, 0xed, 0x82, 0xc6, 0xba,
+  0xeb, 0x59, 0x8a, 0xf9, 0x49, 0xb4, 0x97, 0xb0, 0x94, 0x56, 0x39, 0xb8, 0xb5, 0xac, 0xd1, 0xaf,
+  0xca, 0xc4, 0x7e, 0x24, 0x7f, 0xb6, 0xbf, 0x6b, 0xb5, 0xfa, 0xff, 0x30, 0x4e, 0x76, 0x68, 0xb7,
+  0xdd, 0x70, 0x68, 0xec, 0x47, 0x83, 0x7f, 0x01, 0x46, 0x06, 0xcf, 0x26, 0x43, 0x14, 0x00, 0x00,
+};
+
+const uint8_t WEB_SCANWIFI_HTML[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x52, 0x4b, 0x6f, 0xdb, 0x30,
+  0x0c, 0xbe, 0xfb, 0x57, 0x70, 0x3a, 0x75, 0xc0, 0x6a, 0x37, 0xb7, 0x1d, 0x64, 0x5f, 0xb6, 0x0e,
+  0x3b, 0xb4, 0x58, 0x91, 0x05, 0x28, 0x7a, 0x94, 0x2d, 0x3a, 0x56, 0xa3, 0x48, 0x86, 0x48, 0x2f,
+  0xcd, 0xbf, 0x1f, 0x65, 0xe7, 0x85, 0x61, 0x27, 0x4b, 0xfc, 0x1e, 0xfc, 0x4c, 0x4a, 0x7f, 0xfa,
+  0xfe, 0xeb, 0xdb, 0xe6, 0xed, 0xe5, 0x11, 0x7e, 0x6e, 0x9e, 0x9f, 0x9a, 0x42, 0x0f, 0xbc, 0xf7,
+  0xe0, 0x4d, 0xd8, 0xd6, 0x0a, 0x83, 0x6a, 0xf4, 0x80, 0xc6, 0x36, 0x7a, 0x8f, 0x6c, 0xa0, 0x1b,
+  0x4c, 0x22, 0xe4, 0x5a, 0x4d, 0xdc, 0xdf, 0x7f, 0x15, 0x8c, 0x1d, 0x7b, 0x6c, 0x7e, 0x77, 0x26,
+  0x40, 0x1f, 0x13, 0xbc, 0xba, 0x1f, 0x0e, 0x02, 0xf2, 0x21, 0xa6, 0x1d, 0xe9, 0x6a, 0x41, 0x0b,
+  0xed, 0x5d, 0xd8, 0x41, 0x42, 0x5f, 0x2b, 0xe2, 0xa3, 0x47, 0x1a, 0x10, 0x59, 0xc1, 0x90, 0xb0,
+  0xaf, 0xd5, 0xc1, 0xf5, 0x09, 0x6d, 0xd9, 0x11, 0x89, 0x1d, 0x75, 0xc9, 0x8d, 0x0c, 0x94, 0xba,
+  0x0b, 0xf0, 0x4e, 0x0a, 0x2c, 0xf6, 0x98, 0x1a, 0x5d, 0x2d, 0xb0, 0x1c, 0xe6, 0x48, 0x85, 0x6e,
+  0xa3, 0x3d, 0x82, 0x35, 0x6c, 0xee, 0x47, 0xb3, 0x45, 0x71, 0x97, 0x1c, 0x39, 0xf0, 0xaa, 0x59,
+  0x23, 0x4d, 0x9e, 0x09, 0x62, 0xbf, 0x64, 0xca, 0x88, 0xc8, 0x56, 0x22, 0x1a, 0xa5, 0xcd, 0x28,
+  0x79, 0x9d, 0x5d, 0x04, 0x01, 0xad, 0x64, 0x71, 0xd6, 0x62, 0x98, 0x7f, 0x44, 0xee, 0x70, 0x65,
+  0x88, 0xaf, 0xca, 0x9d, 0xe5, 0xde, 0x00, 0x81, 0xd9, 0xc6, 0x12, 0x4e, 0xd7, 0xe2, 0x1f, 0x1f,
+  0x17, 0xb6, 0x6a, 0x71, 0x90, 0x53, 0x59, 0x5e, 0x78, 0x57, 0xda, 0xc1, 0x38, 0xce, 0xac, 0x73,
+  0xbb, 0xbb, 0x5c, 0x20, 0x98, 0x02, 0x3b, 0x0f, 0x21, 0x82, 0x8f, 0x5d, 0x04, 0x47, 0xd0, 0xa2,
+  0xb0, 0xc0, 0x26, 0xf7, 0x07, 0xc3, 0xe7, 0xff, 0xb4, 0x93, 0xc1, 0x4d, 0x74, 0x13, 0x7b, 0x8d,
+  0x32, 0x2a, 0x1a, 0xe0, 0x54, 0xff, 0x92, 0x67, 0x8d, 0x86, 0x10, 0x8c, 0xf7, 0xb3, 0x29, 0x41,
+  0xef, 0x12, 0xf1, 0x4d, 0xf4, 0x76, 0x62, 0x8e, 0x17, 0xb7, 0xac, 0x56, 0xc0, 0xc7, 0x51, 0x86,
+  0xb8, 0x20, 0xea, 0x6c, 0xaa, 0xab, 0xa5, 0x20, 0x43, 0x18, 0x45, 0xc7, 0xa6, 0xf5, 0x08, 0x6d,
+  0x4c, 0x16, 0x53, 0xfd, 0x20, 0x0f, 0x60, 0xde, 0x41, 0xb6, 0x39, 0xaf, 0x3d, 0x8f, 0x6b, 0xae,
+  0xe6, 0x6f, 0x66, 0x8b, 0xca, 0x9c, 0x96, 0x5d, 0xb9, 0x60, 0xf1, 0xa3, 0xcc, 0x2f, 0x2c, 0x37,
+  0xe0, 0x29, 0x05, 0xe0, 0x08, 0x7b, 0xe3, 0x02, 0xe4, 0x15, 0xea, 0xca, 0x88, 0xea, 0x24, 0xce,
+  0xac, 0xa6, 0xf8, 0x0b, 0x19, 0xa0, 0xa8, 0xe9, 0x9f, 0x02, 0x00, 0x00,
+};
+
+const uint8_t WEB_WIFRED_CSS[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x5d, 0xcb, 0x41, 0x0a, 0x84, 0x30,
+  0x0c, 0x46, 0xe1, 0xfd, 0x9c, 0x22, 0xe0, 0x46, 0x17, 0xf5, 0x00, 0xf5, 0x34, 0x35, 0xfe, 0xd3,
+  0x16, 0x4b, 0x0a, 0x31, 0x8a, 0x20, 0xde, 0xdd, 0x71, 0x56, 0xe2, 0xf6, 0xf1, 0xbd, 0x5e, 0x73,
+  0x4c, 0x46, 0x07, 0x19, 0x76, 0x73, 0xa1, 0xe4, 0x28, 0x9e, 0xfe, 0x6d, 0xa0, 0xf3, 0x63, 0x61,
+  0x2c, 0xe8, 0xbf, 0xab, 0xb0, 0xe5, 0x2a, 0x0b, 0x99, 0xbe, 0x24, 0x43, 0x0c, 0x7a, 0xd3, 0xe6,
+  0xa9, 0xbc, 0x58, 0x72, 0x9c, 0x72, 0x99, 0x5a, 0x6c, 0x90, 0xee, 0x77, 0x8d, 0x81, 0xe7, 0xa8,
+  0x75, 0x95, 0xc9, 0x71, 0x2d, 0x55, 0x3d, 0x35, 0x00, 0xee, 0xf3, 0x02, 0x42, 0x45, 0x5f, 0x08,
+  0x83, 0x00, 0x00, 0x00,
+};
+
+const uint8_t WEB_WIFRED_JS[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x59, 0x5b, 0x6f, 0xdb, 0x46,
+  0x16, 0x7e, 0xf7, 0xaf, 0x98, 0xe6, 0xa1, 0x94, 0x1a, 0x95, 0x72, 0x52, 0xa0, 0xd8, 0x5a, 0x71,
+  0x03, 0xc5, 0xb1, 0x1b, 0x6d, 0x7d, 0x83, 0x24, 0x6f, 0x10, 0x04, 0x7e, 0x18, 0x91, 0x23, 0x6b,
+  0x62, 0x8a, 0x64, 0x87, 0x43, 0x2b, 0x42, 0x9a, 0xff, 0xbe, 0xdf, 0x99, 0x0b, 0x6f, 0x92, 0x9d,
+  0xec, 0x2e, 0xb0, 0x09, 0x60, 0x91, 0x73, 0x2e, 0x73, 0xe6, 0xdc, 0xcf, 0x70, 0xf8, 0xd3, 0x01,
+  0xfb, 0x89, 0xcd, 0x57, 0xb2, 0x60, 0x4b, 0x99, 0x08, 0x86, 0xdf, 0x9c, 0x2b, 0xcd, 0xb2, 0x25,
+  0xd3, 0x2b, 0xc1, 0x36, 0xf2, 0x4c, 0x89, 0x18, 0x3f, 0x4a, 0x24, 0xa2, 0x28, 0xd8, 0x3a, 0x8b,
+  0x45, 0xc2, 0x14, 0x97, 0x89, 0xca, 0x78, 0x2c, 0xd3, 0x3b, 0x60, 0xa9, 0x4c, 0x6b, 0x50, 0xe6,
+  0x2a, 0xfb, 0x24, 0x22, 0x4d, 0xec, 0x4e, 0xb2, 0x7c, 0xab, 0xe4, 0xdd, 0x4a, 0xb3, 0xde, 0x49,
+  0x9f, 0xbd, 0x3c, 0x7c, 0xf1, 0x8f, 0x9f, 0x5f, 0x1e, 0xbe, 0xfc, 0x95, 0xbd, 0x13, 0xf2, 0x3e,
+  0x63, 0xd3, 0xac, 0x10, 0x6b, 0x9e, 0xa6, 0xc0, 0xac, 0xf6, 0x06, 0xf1, 0x9d, 0xe2, 0x6b, 0xda,
+  0x7e, 0xa9, 0x84, 0x60, 0x45, 0xb6, 0xd4, 0x1b, 0xae, 0xc4, 0x11, 0xdb, 0x66, 0x25, 0x8b, 0x78,
+  0xca, 0x20, 0x86, 0x2c, 0xb4, 0x92, 0x8b, 0x52, 0x43, 0x4a, 0xcd, 0x78, 0x1a, 0x0f, 0x33, 0x45,
+  0x02, 0xc9, 0xe5, 0x96, 0xf8, 0x60, 0xad, 0x4c, 0x63, 0xa1, 0x8c, 0xdc, 0x5a, 0xa8, 0x75, 0xe1,
+  0x0f, 0xf1, 0xc7, 0xe5, 0x0d, 0xfb, 0x43, 0xa4, 0x42, 0xf1, 0x84, 0x5d, 0x97, 0x8b, 0x44, 0x46,
+  0xec, 0x5c, 0x46, 0x22, 0x2d, 0x04, 0xe3, 0xd8, 0x9a, 0x56, 0x8a, 0x15, 0x4e, 0xb9, 0x30, 0x7c,
+  0x88, 0xe2, 0x8c, 0x64, 0x98, 0x39, 0x19, 0xd8, 0x59, 0x06, 0xc6, 0x5c, 0xcb, 0x2c, 0x1d, 0x30,
+  0x21, 0x01, 0x57, 0xec, 0x41, 0xa8, 0x02, 0xef, 0xec, 0x17, 0xbf, 0x87, 0x63, 0x38, 0x60, 0x99,
+  0x22, 0x26, 0x3d, 0xae, 0x49, 0x72, 0xc5, 0xb2, 0x9c, 0xe8, 0xfa, 0x10, 0x77, 0xcb, 0x12, 0xae,
+  0x6b, 0xd2, 0xf0, 0x91, 0xe3, 0xd7, 0xa7, 0x8c, 0x99, 0x4c, 0x0d, 0xef, 0x55, 0x96, 0xe3, 0x44,
+  0x2b, 0xb0, 0xc4, 0x19, 0x37, 0x32, 0x49, 0xd8, 0x42, 0xb0, 0xb2, 0x10, 0xcb, 0x32, 0x19, 0x10,
+  0x0b, 0x20, 0xb3, 0xf7, 0x93, 0xf9, 0xbb, 0xab, 0x9b, 0x39, 0x1b, 0x5f, 0x7e, 0x60, 0xef, 0xc7,
+  0xd3, 0xe9, 0xf8, 0x72, 0xfe, 0x61, 0x04, 0x64, 0xbd, 0xca, 0x00, 0x15, 0x0f, 0xc2, 0xb2, 0x92,
+  0xeb, 0x3c, 0x91, 0x64, 0x50, 0xae, 0x14, 0x4f, 0xf5, 0x16, 0xe2, 0x13, 0x87, 0x8b, 0xd3, 0xe9,
+  0xc9, 0x3b, 0x90, 0x8c, 0xdf, 0x4c, 0xce, 0x27, 0xf3, 0x0f, 0x38, 0x04, 0x3b, 0x9b, 0xcc, 0x2f,
+  0x4f, 0x67, 0x33, 0x76, 0x76, 0x35, 0x65, 0x63, 0x76, 0x3d, 0x9e, 0xce, 0x27, 0x27, 0x37, 0xe7,
+  0xe3, 0x29, 0xbb, 0xbe, 0x99, 0x5e, 0x5f, 0xcd, 0x4e, 0x43, 0xc6, 0x66, 0x82, 0xc4, 0x12, 0xc4,
+  0xe0, 0x09, 0x15, 0x2f, 0x8d, 0x95, 0xa0, 0xc6, 0x58, 0x68, 0xf8, 0x4d, 0xe1, 0x0f, 0xfe, 0x01,
+  0x86, 0x2d, 0x20, 0x5d, 0x12, 0xb3, 0x15, 0x7f, 0x10, 0x30, 0x70, 0x24, 0xe4, 0x03, 0x64, 0xe3,
+  0x2c, 0x82, 0xff, 0x7c, 0xdb, 0x78, 0xc4, 0x84, 0x27, 0x19, 0x7c, 0x90, 0x8e, 0x09, 0xe4, 0x5a,
+  0x91, 0x10, 0x6e, 0xb2, 0x64, 0x69, 0xa6, 0x07, 0xac, 0x80, 0x90, 0xaf, 0x56, 0x5a, 0xe7, 0xc5,
+  0xd1, 0x70, 0xb8, 0xd9, 0x6c, 0xc2, 0xbb, 0xb4, 0x0c, 0x33, 0x75, 0x37, 0x4c, 0x2c, 0x97, 0x62,
+  0xf8, 0x7b, 0xd3, 0x12, 0x26, 0x08, 0xf0, 0x27, 0x29, 0xcc, 0xee, 0x85, 0x86, 0xdd, 0x23, 0x08,
+  0x94, 0x2e, 0xe5, 0x5d, 0xa9, 0x8c, 0x13, 0x20, 0x40, 0xee, 0x44, 0xe1, 0x37, 0x15, 0x2c, 0x2a,
+  0x95, 0x12, 0xa9, 0xc6, 0x4e, 0x5a, 0x23, 0x22, 0x0a, 0x23, 0x57, 0x1a, 0x1b, 0xda, 0xb2, 0x68,
+  0x47, 0xd2, 0x80, 0x2d, 0x85, 0x8e, 0xc8, 0xd9, 0x96, 0x2a, 0x5b, 0x1b, 0xc0, 0x3f, 0x67, 0x57,
+  0x97, 0x6c, 0x7c, 0x3d, 0x61, 0xb0, 0xef, 0x90, 0xe7, 0x72, 0xf8, 0xf0, 0x62, 0x48, 0x3a, 0x1a,
+  0x1e, 0x1c, 0x04, 0x30, 0x32, 0x23, 0x77, 0x88, 0x74, 0x30, 0x3a, 0x38, 0x58, 0x96, 0x69, 0x64,
+  0x04, 0x58, 0x6c, 0x27, 0x71, 0x4f, 0xc6, 0xfd, 0x83, 0x2f, 0x07, 0x0c, 0x7a, 0xd3, 0xa5, 0x4a,
+  0x59, 0x9c, 0x45, 0xe5, 0x1a, 0x62, 0x84, 0x77, 0x42, 0x9f, 0x26, 0x82, 0x1e, 0xdf, 0x38, 0xb4,
+  0xd1, 0xc1, 0xd7, 0x06, 0x31, 0xc4, 0x9c, 0x8b, 0xcf, 0x1a, 0x80, 0x01, 0xc2, 0xe4, 0xb3, 0xb6,
+  0x5c, 0x3c, 0xcb, 0x90, 0x96, 0x4e, 0xb2, 0x54, 0xd3, 0x89, 0x8e, 0x0d, 0x82, 0x21, 0x1f, 0xfe,
+  0x64, 0x74, 0x74, 0x46, 0xd2, 0x43, 0xeb, 0x09, 0xbb, 0x93, 0xe4, 0x53, 0x5e, 0x60, 0x26, 0xd2,
+  0x38, 0xcf, 0x64, 0xaa, 0x0b, 0x73, 0xf4, 0x88, 0x30, 0xe8, 0xcf, 0x82, 0x47, 0xf7, 0x95, 0xa6,
+  0xa4, 0x82, 0xb0, 0x45, 0x99, 0x00, 0xc9, 0x79, 0x76, 0xc1, 0xd7, 0x02, 0xce, 0x86, 0xa8, 0x35,
+  0x07, 0xae, 0x64, 0x4c, 0x90, 0x5c, 0x48, 0x2f, 0xbd, 0x8a, 0xed, 0xa0, 0x62, 0x67, 0xe5, 0xbd,
+  0x86, 0xfa, 0x64, 0x21, 0x42, 0x2c, 0xd6, 0x48, 0xe1, 0x9a, 0xe7, 0x3d, 0xcf, 0xa4, 0x5a, 0xee,
+  0x03, 0x9d, 0x48, 0x2a, 0x55, 0x19, 0x13, 0xf4, 0x02, 0x2f, 0x7b, 0xc0, 0x9e, 0x57, 0xe2, 0xe3,
+  0xfc, 0x2b, 0x91, 0xd6, 0x3c, 0x20, 0x6f, 0x9e, 0xc1, 0x4b, 0xfa, 0xec, 0x8b, 0xa7, 0xf6, 0x4b,
+  0xe1, 0xa7, 0x02, 0x08, 0xfd, 0x11, 0xfb, 0x0a, 0x05, 0x33, 0xfc, 0xdd, 0x43, 0x4b, 0x67, 0x25,
+  0x52, 0x2f, 0x7b, 0xc8, 0xf3, 0x3c, 0xd9, 0xf6, 0xd2, 0x32, 0x49, 0x06, 0x5e, 0x17, 0x8e, 0x43,
+  0xd3, 0x44, 0x3c, 0x8e, 0xaf, 0x4c, 0xde, 0xe8, 0x15, 0x48, 0xbb, 0x11, 0xbc, 0xf8, 0x81, 0x27,
+  0xd6, 0x5a, 0xe4, 0xd0, 0xb4, 0x24, 0x9c, 0xf5, 0x1f, 0xb8, 0xcf, 0x31, 0xb0, 0x56, 0xe5, 0x03,
+  0x91, 0x12, 0xc8, 0x35, 0xce, 0x0d, 0x7a, 0x81, 0x45, 0x08, 0x8c, 0x9c, 0xf6, 0x39, 0x04, 0xc3,
+  0x52, 0x80, 0x04, 0xbf, 0x8d, 0xd5, 0x7d, 0xc6, 0xaf, 0x80, 0x7e, 0x63, 0x40, 0xfc, 0x23, 0x41,
+  0xed, 0x33, 0x9d, 0x0c, 0x4a, 0x3c, 0x59, 0xc9, 0x24, 0xee, 0xb9, 0xa4, 0xd7, 0x74, 0x9c, 0xab,
+  0x14, 0x11, 0x9e, 0x6d, 0x7c, 0x34, 0xdc, 0xa7, 0xd9, 0x26, 0x65, 0xa9, 0xd0, 0x9b, 0x4c, 0xdd,
+  0x23, 0xd4, 0xf8, 0x22, 0x11, 0xd6, 0x4f, 0x38, 0xa5, 0x33, 0x8d, 0xe3, 0x50, 0xde, 0x10, 0x9c,
+  0xbc, 0xcd, 0x28, 0xa5, 0xed, 0x20, 0xd0, 0xd0, 0xa5, 0x25, 0xee, 0xe9, 0x45, 0x16, 0x6f, 0xa1,
+  0x96, 0x82, 0x1c, 0x3a, 0xe1, 0x0b, 0x01, 0x4d, 0x59, 0x92, 0xa2, 0x56, 0x11, 0x6d, 0x8d, 0x03,
+  0x11, 0x6a, 0x28, 0x61, 0x3c, 0xa5, 0xa7, 0xd9, 0xa6, 0x67, 0x14, 0x02, 0x90, 0x5b, 0x3a, 0x11,
+  0x70, 0xa6, 0x6e, 0x04, 0x18, 0x8e, 0xf0, 0x10, 0xe2, 0x4f, 0xe8, 0x8e, 0x75, 0x08, 0xf1, 0x4e,
+  0x21, 0x5d, 0x6d, 0x6e, 0x0b, 0xa8, 0x9d, 0x8d, 0xb6, 0x05, 0xd2, 0xfa, 0x09, 0xbb, 0x10, 0xd8,
+  0x5a, 0x85, 0x19, 0xd4, 0xd0, 0xf2, 0x00, 0x45, 0x60, 0x33, 0x4e, 0xd0, 0x80, 0xad, 0x05, 0x72,
+  0x39, 0x29, 0x3f, 0xc8, 0xb3, 0x42, 0x3b, 0x08, 0x6d, 0x22, 0xd3, 0xbc, 0xd4, 0x4f, 0xec, 0x62,
+  0xe0, 0x7e, 0x1b, 0xf3, 0x12, 0xea, 0x6d, 0x4e, 0xc6, 0x0f, 0x56, 0x32, 0x8e, 0x45, 0x1a, 0x34,
+  0x41, 0x29, 0x85, 0xe4, 0xb1, 0x3b, 0xe6, 0xc7, 0xc3, 0xdb, 0x26, 0xcc, 0x3b, 0x8d, 0xd7, 0x85,
+  0xdd, 0xbf, 0x28, 0x17, 0x6b, 0xf9, 0xdd, 0x02, 0x58, 0xec, 0x4a, 0x02, 0xfb, 0x1a, 0xb4, 0x60,
+  0x7e, 0x1b, 0x27, 0xc3, 0x8b, 0xdb, 0xa6, 0x86, 0x1a, 0x6e, 0x66, 0xf8, 0xf6, 0x1f, 0x01, 0x5a,
+  0x5e, 0x0e, 0xba, 0x63, 0xe3, 0x26, 0x26, 0x91, 0xba, 0x10, 0xee, 0x64, 0xca, 0x55, 0xb6, 0xb9,
+  0xe0, 0x32, 0xbd, 0x46, 0xbe, 0xef, 0xd9, 0x6c, 0x0e, 0x0f, 0xcb, 0xa2, 0x0c, 0x3f, 0xde, 0x75,
+  0x29, 0x1e, 0x15, 0x4a, 0x3a, 0x7e, 0xb7, 0x85, 0x16, 0xeb, 0xda, 0xe5, 0x36, 0x72, 0x29, 0x49,
+  0x57, 0x86, 0x2e, 0xa4, 0xb7, 0x91, 0x77, 0x46, 0xad, 0x6b, 0x80, 0xa2, 0xe6, 0x62, 0xae, 0x64,
+  0x8e, 0x04, 0xef, 0xd2, 0x70, 0xe0, 0x7b, 0xaa, 0x4b, 0xd8, 0x22, 0xe8, 0xd7, 0x6a, 0xb7, 0x14,
+  0x64, 0x21, 0x1b, 0x78, 0x36, 0x91, 0x07, 0x0b, 0xae, 0xd1, 0x58, 0x6c, 0xff, 0x95, 0x25, 0x1a,
+  0x92, 0x06, 0x03, 0x8f, 0xe8, 0xd6, 0xc3, 0x07, 0x0b, 0xe8, 0xef, 0x23, 0x3a, 0xcf, 0x36, 0xbb,
+  0x04, 0x09, 0xa2, 0xe5, 0x35, 0x0b, 0xd8, 0x1b, 0xfb, 0xce, 0xce, 0xaf, 0xde, 0x07, 0xec, 0x88,
+  0x05, 0x41, 0x9b, 0xc5, 0x52, 0xaa, 0x35, 0x35, 0x48, 0x53, 0xf1, 0x20, 0xa9, 0xa5, 0xa9, 0x19,
+  0x79, 0x48, 0x1b, 0x9f, 0xdc, 0x06, 0x38, 0xa4, 0x8a, 0x10, 0xfe, 0x9d, 0xda, 0x6c, 0xf2, 0xda,
+  0x2e, 0x10, 0x90, 0xf6, 0x40, 0xd1, 0x66, 0x15, 0xb0, 0xb3, 0x61, 0x21, 0xef, 0x52, 0x9e, 0xcc,
+  0x34, 0xca, 0xed, 0x9d, 0x5e, 0x3d, 0xca, 0x4a, 0x81, 0x17, 0x22, 0x36, 0x88, 0xdf, 0x04, 0xdf,
+  0xe2, 0x58, 0x69, 0x1f, 0xcc, 0x60, 0x96, 0x70, 0x8d, 0xc2, 0x04, 0x4a, 0x53, 0x13, 0xe8, 0x9d,
+  0x3f, 0xdc, 0xb5, 0xde, 0xf3, 0xdf, 0x7e, 0x6b, 0xbd, 0xaf, 0xf9, 0x67, 0xe3, 0x60, 0xf6, 0x1f,
+  0x20, 0x0c, 0x6d, 0x27, 0x98, 0x0c, 0x41, 0x38, 0x04, 0xf2, 0x10, 0x08, 0xac, 0xe7, 0xb1, 0x51,
+  0xee, 0x72, 0xb4, 0xd1, 0x06, 0xcf, 0x3d, 0x0f, 0x98, 0x07, 0xd6, 0x52, 0x53, 0x27, 0x90, 0xf0,
+  0x42, 0x3b, 0x9c, 0x7e, 0x47, 0x66, 0x1d, 0xe5, 0x53, 0xa1, 0xd1, 0xbe, 0x15, 0x70, 0xf0, 0x02,
+  0x82, 0x77, 0x57, 0xa8, 0xba, 0xba, 0xe6, 0xe3, 0xb5, 0xb7, 0x48, 0x1b, 0xc5, 0xab, 0x85, 0x3f,
+  0xa0, 0x23, 0xa3, 0xdc, 0xdb, 0x55, 0xb4, 0x36, 0x9d, 0xce, 0xc5, 0xf8, 0xc4, 0x2b, 0x79, 0xcd,
+  0xa3, 0xbe, 0xf1, 0x50, 0x72, 0x60, 0xf8, 0x79, 0x4e, 0xcd, 0x2c, 0x7c, 0xd2, 0x3a, 0x2c, 0x05,
+  0xc5, 0xdc, 0x2d, 0x5a, 0x56, 0x26, 0x4c, 0x42, 0xfb, 0x77, 0x27, 0x55, 0xd2, 0x72, 0x3b, 0x51,
+  0x16, 0xc2, 0x67, 0x3e, 0xcf, 0x9b, 0xcc, 0xaa, 0x4d, 0x32, 0x41, 0x8b, 0x27, 0x2e, 0x31, 0x77,
+  0xf4, 0xb4, 0x2a, 0x45, 0x7f, 0xd4, 0x4d, 0xae, 0x8e, 0x34, 0xfc, 0xab, 0x84, 0xab, 0xce, 0x4c,
+  0x31, 0xca, 0x54, 0x3b, 0xb7, 0x3e, 0x82, 0x62, 0xc4, 0x0b, 0x76, 0x12, 0x3e, 0x16, 0x43, 0x9f,
+  0xdf, 0x4c, 0x5a, 0x11, 0x36, 0x91, 0x15, 0x1f, 0xcd, 0x39, 0x83, 0xdb, 0x2a, 0x20, 0xbf, 0x85,
+  0x1a, 0xa2, 0x4c, 0xa1, 0xca, 0x17, 0x5d, 0x12, 0xb7, 0xec, 0x84, 0x33, 0x79, 0x23, 0xa4, 0xc9,
+  0x6a, 0x8f, 0xaa, 0x68, 0xb9, 0x6f, 0xf0, 0xbe, 0x38, 0x47, 0xab, 0x9b, 0x83, 0x7d, 0x3b, 0x12,
+  0x7e, 0x70, 0x3b, 0x30, 0x83, 0x9a, 0xdd, 0xb4, 0xf9, 0x6c, 0x3c, 0xef, 0x67, 0xe3, 0x72, 0x66,
+  0xd1, 0x76, 0x14, 0x0d, 0xf8, 0xb1, 0x93, 0xd0, 0x6c, 0x6b, 0xe5, 0xfb, 0xda, 0x7f, 0xfc, 0x7c,
+  0x31, 0xe6, 0x42, 0x23, 0x67, 0xf7, 0x84, 0x15, 0xe0, 0x71, 0x5a, 0xea, 0xdc, 0xc7, 0x95, 0x7e,
+  0xd0, 0x13, 0x47, 0xf7, 0xa6, 0xb7, 0xe8, 0x02, 0x9f, 0x36, 0x21, 0x29, 0x0a, 0x5d, 0x1f, 0xac,
+  0xb8, 0x52, 0x62, 0x49, 0x15, 0xc5, 0xad, 0x84, 0x2b, 0xbd, 0x4e, 0x5e, 0x13, 0xb3, 0x63, 0x3a,
+  0x6e, 0xcb, 0x54, 0xb5, 0xd3, 0x16, 0x41, 0xbb, 0x16, 0xb8, 0x6d, 0xaa, 0x72, 0xe0, 0x1c, 0x5e,
+  0xa4, 0x14, 0x24, 0x71, 0xe5, 0xef, 0xee, 0xdd, 0xb5, 0x20, 0x85, 0xf5, 0x33, 0x42, 0xc4, 0xf4,
+  0xd6, 0xc6, 0xf4, 0x0b, 0x6d, 0x54, 0x5f, 0x3d, 0xc2, 0xea, 0x61, 0xc7, 0xf0, 0x0e, 0x52, 0x87,
+  0x89, 0x5c, 0xfa, 0xb5, 0xd0, 0x6d, 0xbf, 0xe3, 0x17, 0xbe, 0x25, 0x72, 0xf0, 0xaa, 0x4a, 0x85,
+  0xb6, 0x39, 0x0a, 0x1c, 0x9c, 0x51, 0x05, 0x41, 0x06, 0x18, 0xb0, 0x8f, 0xf8, 0x1f, 0x28, 0xb1,
+  0xce, 0x1e, 0xa8, 0x6c, 0x04, 0x53, 0xf3, 0xc4, 0x1c, 0x5a, 0xc0, 0x6e, 0x09, 0xc3, 0x1f, 0x81,
+  0x10, 0xde, 0xda, 0xc7, 0x06, 0x06, 0xbb, 0xf5, 0x6e, 0x62, 0xfe, 0x8a, 0x84, 0xe6, 0xb2, 0xfd,
+  0x52, 0x79, 0x55, 0x3c, 0x26, 0xd6, 0xf7, 0x4b, 0x64, 0xcf, 0x47, 0xf0, 0xd3, 0xf4, 0x29, 0x79,
+  0xac, 0xeb, 0x7e, 0x64, 0x95, 0x3e, 0x2a, 0xf3, 0xdc, 0xee, 0x2a, 0xdc, 0x34, 0x87, 0x2d, 0x75,
+  0xdb, 0x76, 0x11, 0xbd, 0x03, 0x12, 0x99, 0xa9, 0x38, 0x14, 0x1e, 0x87, 0x6d, 0xad, 0x93, 0xd1,
+  0x23, 0xf4, 0x14, 0xfb, 0xba, 0xcb, 0x56, 0xcb, 0x31, 0x72, 0x04, 0x84, 0x8c, 0xdc, 0x96, 0xcc,
+  0x72, 0x4e, 0xe9, 0xee, 0x97, 0xd6, 0x7a, 0x3b, 0x13, 0x05, 0x97, 0xc8, 0x7c, 0x61, 0xd0, 0x3e,
+  0x4f, 0xed, 0x68, 0x11, 0x34, 0x83, 0xe2, 0x7c, 0xec, 0x3a, 0x90, 0xb0, 0x5a, 0x1a, 0x55, 0x8d,
+  0x84, 0x85, 0x74, 0xdb, 0x08, 0x8b, 0xee, 0xdb, 0x88, 0x26, 0xe6, 0x75, 0xa6, 0xf4, 0x2e, 0x66,
+  0x8e, 0xd5, 0x2e, 0xe6, 0xb8, 0xd4, 0xd9, 0x9a, 0x66, 0x63, 0xa0, 0xd7, 0xb1, 0xeb, 0x08, 0xb8,
+  0x07, 0xb6, 0x8b, 0x8a, 0x01, 0xde, 0x14, 0x98, 0x91, 0x03, 0xdf, 0x36, 0x85, 0x25, 0xbd, 0x52,
+  0x5a, 0x3a, 0xa2, 0x28, 0x6d, 0x6c, 0xd8, 0xdf, 0x43, 0xfb, 0xd6, 0x9f, 0x90, 0x4c, 0x7f, 0x6e,
+  0x2a, 0xa4, 0x59, 0xaf, 0xb5, 0x71, 0x64, 0x72, 0x5b, 0xf5, 0x1a, 0x52, 0x19, 0xad, 0xa8, 0xe6,
+  0x72, 0x2d, 0x7c, 0x8d, 0xee, 0xb5, 0xf1, 0xfc, 0x93, 0x74, 0xd5, 0xb9, 0xf1, 0xde, 0xc7, 0x5e,
+  0xed, 0x1a, 0x6f, 0x6a, 0xb3, 0xeb, 0x28, 0xf6, 0x6d, 0x78, 0x62, 0x41, 0x4f, 0x6c, 0x17, 0xc1,
+  0xf3, 0x84, 0x43, 0xb3, 0x1b, 0x9a, 0xeb, 0x00, 0xb3, 0x3c, 0xe8, 0x70, 0x74, 0x1b, 0x9d, 0xa1,
+  0x52, 0x97, 0xca, 0x89, 0xb7, 0xc4, 0x0b, 0xe2, 0xbf, 0x2b, 0x59, 0x4d, 0xa4, 0x04, 0x6c, 0x28,
+  0xed, 0xa5, 0x95, 0x25, 0xa1, 0xf1, 0xf3, 0xce, 0xb4, 0x3b, 0xcc, 0xd8, 0xab, 0xea, 0x5c, 0x19,
+  0x45, 0x58, 0xdc, 0xd9, 0xd4, 0x82, 0x2e, 0x0c, 0x84, 0xa8, 0x35, 0xce, 0x62, 0x72, 0xd7, 0x81,
+  0x77, 0x79, 0x38, 0xa9, 0x9a, 0x61, 0x62, 0xc3, 0x80, 0xe6, 0x73, 0x5d, 0x73, 0xd1, 0xe6, 0x39,
+  0x04, 0x59, 0xcf, 0x94, 0x6a, 0xe0, 0x1c, 0x8e, 0xf0, 0xf3, 0xea, 0xb8, 0xaa, 0x77, 0xfc, 0xf3,
+  0x99, 0x0b, 0x3d, 0x00, 0x9e, 0x3f, 0xaf, 0x23, 0xaf, 0x2e, 0x70, 0x4d, 0x86, 0x03, 0xb6, 0xc4,
+  0x71, 0x67, 0x42, 0xb3, 0x33, 0x12, 0x15, 0x2f, 0x4b, 0x8e, 0x64, 0x63, 0x33, 0xf5, 0x01, 0x6b,
+  0x49, 0x54, 0x3b, 0xb0, 0xdd, 0xab, 0x09, 0x33, 0x47, 0xa8, 0xfd, 0x2a, 0x17, 0x22, 0x7e, 0x97,
+  0x25, 0x71, 0xb6, 0x5c, 0xd6, 0xed, 0xab, 0x59, 0x0d, 0x57, 0x76, 0xb9, 0xdf, 0x70, 0xfd, 0x06,
+  0xf6, 0x85, 0x4c, 0x9b, 0x91, 0x62, 0x37, 0x6a, 0x22, 0x50, 0x2f, 0xf9, 0x08, 0x29, 0xff, 0xfc,
+  0x2d, 0x52, 0xfe, 0xb9, 0x31, 0x0e, 0x2c, 0x65, 0x02, 0xf1, 0x2f, 0x44, 0x2c, 0xf9, 0x63, 0x7b,
+  0x9e, 0x19, 0x14, 0xcc, 0x88, 0x84, 0x33, 0xea, 0x50, 0x4e, 0x26, 0xd3, 0xa7, 0xc9, 0xa4, 0x54,
+  0x5d, 0x9a, 0x37, 0x32, 0x4d, 0x29, 0x50, 0x5b, 0xd1, 0xbd, 0x4b, 0xb9, 0xb0, 0x68, 0xa3, 0x1d,
+  0x9d, 0xce, 0xb4, 0xc8, 0x8b, 0xae, 0x46, 0x0b, 0x5a, 0xec, 0x37, 0x4e, 0x96, 0x8a, 0x8d, 0x9f,
+  0x5a, 0x76, 0xc6, 0x9c, 0xce, 0xf4, 0xb2, 0x3b, 0x9a, 0x91, 0xfb, 0x5c, 0xf0, 0xdc, 0x4c, 0x67,
+  0xa6, 0x96, 0xd7, 0xb3, 0x97, 0x24, 0x71, 0xc1, 0x9c, 0xdd, 0x4c, 0xcf, 0x67, 0x82, 0xab, 0x68,
+  0x75, 0xcd, 0x15, 0x5f, 0x17, 0x84, 0xc7, 0xdd, 0x65, 0x06, 0xad, 0xf6, 0xe9, 0xb6, 0xcc, 0x76,
+  0x02, 0x75, 0x0d, 0xa7, 0x37, 0xd7, 0x87, 0x54, 0x1d, 0xac, 0x4c, 0xe3, 0x46, 0xfb, 0xda, 0xb8,
+  0x0d, 0x4a, 0x42, 0xda, 0xeb, 0x18, 0x3b, 0x8e, 0x7c, 0x7a, 0xae, 0xc6, 0xe0, 0x56, 0xaf, 0x32,
+  0x46, 0x11, 0xa8, 0x3a, 0xce, 0x9d, 0xe2, 0x53, 0xa0, 0x1a, 0x10, 0x57, 0xfa, 0xed, 0x54, 0x01,
+  0xcf, 0xd9, 0x94, 0xa4, 0x1f, 0xda, 0xad, 0xb3, 0xd5, 0xa2, 0x4c, 0x4d, 0xb0, 0x9f, 0x5b, 0xde,
+  0x76, 0xa6, 0x07, 0xa1, 0x89, 0x8f, 0x51, 0xe3, 0xe2, 0xcb, 0x86, 0x4a, 0xd3, 0x54, 0xbe, 0x3f,
+  0x1d, 0xb4, 0xfa, 0xd2, 0x86, 0xc7, 0x3b, 0x79, 0xf7, 0x34, 0xbc, 0x66, 0x0e, 0xa0, 0x8a, 0x57,
+  0x85, 0xbf, 0x3f, 0x4c, 0x51, 0x4f, 0x00, 0x61, 0xb5, 0xb6, 0xe7, 0xc8, 0xf6, 0xba, 0x14, 0x71,
+  0xdc, 0x1e, 0x05, 0x9e, 0xb8, 0xaa, 0xf9, 0xe6, 0x65, 0x4d, 0x60, 0x73, 0x83, 0xc5, 0x1d, 0x0e,
+  0xd9, 0xfc, 0xdd, 0xf4, 0x6a, 0x3e, 0x3f, 0x3f, 0x65, 0x61, 0x18, 0xb2, 0xc9, 0x1f, 0x97, 0x57,
+  0xd3, 0x53, 0x7b, 0x23, 0x2c, 0xd2, 0x72, 0xcd, 0xbc, 0x28, 0x93, 0x74, 0x99, 0xf9, 0x36, 0xd5,
+  0xa4, 0xab, 0x4f, 0x36, 0x5d, 0x7d, 0xa2, 0x74, 0xf5, 0x2b, 0x7e, 0x6d, 0x76, 0x6a, 0x17, 0x7d,
+  0xc5, 0x63, 0x99, 0x7d, 0xef, 0xa5, 0x07, 0xb3, 0xe8, 0xd5, 0xad, 0x87, 0x79, 0x0b, 0xda, 0x30,
+  0x77, 0xf1, 0x12, 0x2c, 0x1b, 0x47, 0xf0, 0x30, 0xaf, 0xff, 0x4f, 0xed, 0xe5, 0x66, 0xe1, 0x35,
+  0xca, 0x24, 0x4f, 0xac, 0x71, 0x9e, 0xba, 0xf4, 0x30, 0x0c, 0x76, 0x5a, 0xa5, 0xb6, 0x21, 0x4f,
+  0xec, 0x1d, 0xd4, 0xae, 0x4b, 0xc1, 0x89, 0xcc, 0xd0, 0x16, 0xf1, 0x74, 0xa6, 0xb9, 0xb2, 0x77,
+  0x82, 0x0e, 0xe6, 0x2f, 0xfc, 0x0c, 0x80, 0x71, 0x13, 0x85, 0xef, 0xe5, 0x99, 0x34, 0xd8, 0xf6,
+  0x5e, 0x1c, 0xb1, 0xcb, 0x68, 0x08, 0xf5, 0x97, 0xc1, 0x59, 0x1a, 0x99, 0x4f, 0x3a, 0x2b, 0x5e,
+  0xa0, 0xac, 0xd2, 0xc8, 0x0b, 0x8e, 0xed, 0xfb, 0x3e, 0xf4, 0xf6, 0xc0, 0x5e, 0xcd, 0xc0, 0xa3,
+  0x67, 0xc3, 0xbc, 0xbd, 0x39, 0x8d, 0x86, 0xf5, 0x01, 0x1c, 0x36, 0x24, 0x6f, 0xf4, 0xe3, 0x1e,
+  0xa5, 0x73, 0xfb, 0x4b, 0x7c, 0x86, 0x9e, 0x60, 0x80, 0x10, 0xb4, 0xf7, 0x6c, 0xa8, 0xeb, 0xd7,
+  0x57, 0xb3, 0x79, 0x00, 0xc5, 0x74, 0xae, 0x75, 0x29, 0x4c, 0xab, 0xfb, 0x69, 0x34, 0xa3, 0xc4,
+  0xc0, 0x34, 0xa6, 0x74, 0x2e, 0x12, 0xf0, 0xda, 0xdc, 0xb5, 0xec, 0xbd, 0x4d, 0xf2, 0xe0, 0x1e,
+  0x11, 0xd5, 0xe9, 0xaa, 0x1d, 0x47, 0xe9, 0xce, 0x54, 0xb1, 0x28, 0x0b, 0xd3, 0xe7, 0x81, 0x28,
+  0xa4, 0x3f, 0x94, 0x72, 0xd9, 0xdf, 0x7f, 0xdb, 0x05, 0xb2, 0xa9, 0x49, 0xc1, 0x75, 0xad, 0x71,
+  0x28, 0x4d, 0xcb, 0xfd, 0x40, 0x3c, 0x6a, 0x0d, 0x6d, 0xb8, 0xd4, 0x5d, 0x8c, 0x26, 0xb7, 0x8a,
+  0xbb, 0xe7, 0xd5, 0x52, 0x6e, 0x59, 0xd0, 0x45, 0x4a, 0x97, 0xd4, 0x01, 0x88, 0xb4, 0xbd, 0xd9,
+  0x5e, 0x73, 0x78, 0x14, 0x24, 0x35, 0x7a, 0xac, 0x73, 0x00, 0x25, 0x27, 0x74, 0x1b, 0x59, 0xa9,
+  0xff, 0x0b, 0x9d, 0x0f, 0xd8, 0x8b, 0xc3, 0xc3, 0xc3, 0xaa, 0x29, 0x00, 0x73, 0x23, 0x1a, 0xa0,
+  0x08, 0x8d, 0x63, 0xf3, 0x81, 0x10, 0xb9, 0xdc, 0x8e, 0x4e, 0x5f, 0x7c, 0x96, 0x48, 0x05, 0xb5,
+  0x41, 0xe6, 0xa4, 0xf4, 0x15, 0x50, 0x20, 0x0d, 0x08, 0x53, 0xb9, 0xe0, 0xc0, 0x74, 0x59, 0xbd,
+  0x94, 0x8a, 0x5a, 0x4d, 0xf3, 0x15, 0xd2, 0x7c, 0xd5, 0xe4, 0x1b, 0xbe, 0xf5, 0x43, 0x82, 0x51,
+  0x2c, 0xfb, 0xf1, 0x47, 0xab, 0x04, 0xe7, 0x91, 0xed, 0x74, 0xd1, 0x72, 0xde, 0xe6, 0xb4, 0xf4,
+  0x68, 0x5a, 0xb6, 0xb7, 0x78, 0x4e, 0xf2, 0x66, 0x03, 0x62, 0x65, 0xdc, 0x9b, 0xe5, 0x71, 0x90,
+  0x7b, 0x21, 0x72, 0xfb, 0x5d, 0x65, 0x45, 0xd7, 0xeb, 0x3e, 0xbe, 0x7a, 0x14, 0x75, 0xf7, 0x62,
+  0x5b, 0x30, 0xca, 0x3f, 0xf4, 0x59, 0xb1, 0x0f, 0x4d, 0x68, 0x99, 0x18, 0x5c, 0x0a, 0x50, 0x73,
+  0x36, 0xfa, 0xf8, 0x88, 0x81, 0xa3, 0xb6, 0x09, 0x9d, 0x6a, 0x77, 0x06, 0xfa, 0xdd, 0x8e, 0x40,
+  0x5f, 0x76, 0x4e, 0xc0, 0x3c, 0xb2, 0xc8, 0x13, 0x1e, 0x09, 0x93, 0x67, 0x94, 0x70, 0x47, 0xf6,
+  0x96, 0xa8, 0x06, 0xde, 0xce, 0x44, 0x65, 0xd9, 0x3d, 0x3d, 0x42, 0xed, 0x8e, 0x47, 0x36, 0xb3,
+  0x54, 0x9f, 0x11, 0x96, 0xd4, 0xde, 0x86, 0x6c, 0x6a, 0xf5, 0xcd, 0x74, 0x06, 0xf9, 0x72, 0x64,
+  0x65, 0xab, 0xca, 0xc0, 0x8b, 0xd9, 0x16, 0xe4, 0xb1, 0xc9, 0x7b, 0xc0, 0xe4, 0x7f, 0x50, 0x98,
+  0xfe, 0x2f, 0xb7, 0xfd, 0x06, 0x62, 0x7a, 0x1b, 0x9f, 0x24, 0xa8, 0x56, 0xc8, 0x26, 0x10, 0xee,
+  0xa1, 0xde, 0xcd, 0x2f, 0xce, 0x09, 0xe7, 0x95, 0xfd, 0x32, 0x40, 0x46, 0x3f, 0x7e, 0x66, 0x1d,
+  0xe6, 0x99, 0x99, 0xfd, 0x8f, 0x9f, 0xd1, 0x9d, 0xde, 0x6c, 0x36, 0x79, 0xfb, 0xec, 0xf7, 0x60,
+  0xef, 0x0d, 0x8d, 0x87, 0x37, 0xee, 0x75, 0x9a, 0x43, 0xfb, 0x93, 0xb7, 0xea, 0xbd, 0xf6, 0x78,
+  0x5f, 0x5d, 0xaf, 0x5b, 0x25, 0xc1, 0x0f, 0xc1, 0xac, 0x4b, 0x3a, 0xea, 0x5e, 0x71, 0x64, 0xe0,
+  0xd4, 0x8e, 0x22, 0x10, 0x76, 0x1d, 0xe0, 0x26, 0x15, 0x69, 0xa4, 0xb6, 0x39, 0xd5, 0x00, 0xaf,
+  0x90, 0x27, 0x6f, 0x23, 0x88, 0x47, 0x4b, 0x45, 0xd7, 0xb3, 0x3f, 0x8f, 0x58, 0x4b, 0x4f, 0xb4,
+  0x45, 0x53, 0x4b, 0x7f, 0x9e, 0x7e, 0xa8, 0x94, 0x64, 0x19, 0x74, 0xae, 0xa0, 0x5c, 0xa1, 0x47,
+  0x47, 0xa9, 0xc7, 0xda, 0x7d, 0xba, 0x77, 0xc6, 0x1e, 0x78, 0x8b, 0xb5, 0xa3, 0xbe, 0xab, 0xb6,
+  0xc7, 0x8d, 0x66, 0x3f, 0x62, 0x3c, 0x63, 0xc6, 0x06, 0xc7, 0xcf, 0xc6, 0x71, 0x75, 0xce, 0x4a,
+  0x26, 0xe2, 0x46, 0x77, 0x07, 0xc5, 0xc7, 0x97, 0xb7, 0xff, 0x83, 0x68, 0xdf, 0x6a, 0xac, 0x66,
+  0xe6, 0xea, 0x9d, 0x3e, 0x46, 0x9b, 0xb8, 0xb5, 0x63, 0xaf, 0x37, 0x56, 0xe3, 0xc2, 0xbd, 0xf1,
+  0x1d, 0xa5, 0x8a, 0x03, 0xb4, 0x95, 0xa7, 0x0f, 0x78, 0x38, 0x97, 0x18, 0x00, 0x70, 0xd4, 0x5e,
+  0xf0, 0xf6, 0xea, 0xc2, 0xf1, 0x3e, 0x47, 0x56, 0x17, 0xf4, 0x55, 0xa0, 0xce, 0xf5, 0xb6, 0xbc,
+  0x9b, 0x61, 0xad, 0x57, 0xf1, 0x30, 0x51, 0x87, 0x79, 0x96, 0xe3, 0x2c, 0x21, 0x7d, 0x80, 0xaf,
+  0x63, 0x33, 0xc2, 0x1a, 0x0b, 0xd6, 0x1c, 0x03, 0xd9, 0x91, 0x33, 0x53, 0xab, 0x56, 0x98, 0x71,
+  0x82, 0x6e, 0x0c, 0xec, 0x85, 0xdf, 0x80, 0xd5, 0x15, 0x16, 0xcf, 0x76, 0xd2, 0x35, 0x4f, 0x66,
+  0xbc, 0xa9, 0xca, 0x8a, 0xff, 0xf2, 0x53, 0xb5, 0x70, 0x0b, 0x84, 0xf3, 0xfd, 0xa8, 0xb1, 0xa5,
+  0xbf, 0x7b, 0xdc, 0xb7, 0xab, 0xdd, 0xcb, 0xf3, 0x6a, 0x8c, 0x2a, 0x8f, 0xb3, 0x33, 0x45, 0xcd,
+  0xf3, 0xea, 0x56, 0xce, 0x5d, 0x1d, 0x46, 0x89, 0x8c, 0xee, 0xe9, 0xb3, 0x45, 0x5d, 0x5d, 0x2a,
+  0xde, 0xdf, 0x51, 0x2b, 0xbb, 0x52, 0x7c, 0x3d, 0x20, 0xb3, 0xfd, 0x1b, 0x4f, 0xf3, 0x7e, 0x61,
+  0x0f, 0x24, 0x00, 0x00,
+};
+
+const webAsset WEB_ASSETS[] = {
+  { "/funcmap.html", "text/html", "\"5cdf316a533c868e\"", WEB_FUNCMAP_HTML, sizeof(WEB_FUNCMAP_HTML) },
+  { "/index.html", "text/html", "\"cb1fbaf4b5d59d76\"", WEB_INDEX_HTML, sizeof(WEB_INDEX_HTML) },
+  { "/scanWifi.html", "text/html", "\"3224fb2c03d149d0\"", WEB_SCANWIFI_HTML, sizeof(WEB_SCANWIFI_HTML) },
+  { "/wifred.css", "text/css", "\"7253b411c81ec04c\"", WEB_WIFRED_CSS, sizeof(WEB_WIFRED_CSS) },
+  { "/wifred.js", "application/javascript", "\"9dd58522b302c392\"", WEB_WIFRED_JS, sizeof(WEB_WIFRED_JS) },
+};
+
+#define WEB_ASSETS_COUNT (sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]))
+
+#endif
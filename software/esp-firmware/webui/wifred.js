@@ -0,0 +1,285 @@
+/*
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file fills the static configuration pages with the current settings
+ * and status of the wiFred, fetched from the JSON API at /api/v1/.
+ */
+
+'use strict';
+
+function byId(id)
+{
+  return document.getElementById(id);
+}
+
+function setText(id, text)
+{
+  byId(id).textContent = text;
+}
+
+/**
+ * Fetch all given /api/v1/ endpoints and call callback with their results in the same order
+ */
+function loadJSON(endpoints, callback)
+{
+  Promise.all(endpoints.map(function(endpoint)
+  {
+    return fetch('/api/v1/' + endpoint).then(function(response) { return response.json(); });
+  })).then(function(results) { callback.apply(null, results); });
+}
+
+function addOption(select, val, text, selected)
+{
+  var option = document.createElement('option');
+  option.value = val;
+  option.textContent = text;
+  option.selected = selected;
+  select.appendChild(option);
+}
+
+/**
+ * One row of the known networks table with a button for each action
+ */
+function addNetwork(tbody, ssid, label, actions)
+{
+  var row = tbody.insertRow();
+  row.insertCell().textContent = label + ssid;
+  actions.forEach(function(action)
+  {
+    var form = document.createElement('form');
+    form.action = 'config';
+    form.method = 'post';
+    var input = document.createElement('input');
+    input.type = 'hidden';
+    input.name = action[0];
+    input.value = ssid;
+    var submit = document.createElement('input');
+    submit.type = 'submit';
+    submit.value = action[1];
+    form.appendChild(input);
+    form.appendChild(submit);
+    row.insertCell().appendChild(form);
+  });
+}
+
+function showMainPage(status, locos, networks, server, system)
+{
+  var wifi = status.wifi;
+  var rtt = status.roundTrip;
+
+  byId('throttleName').value = status.name;
+  setText('batteryVoltage', status.battery.voltage);
+  setText('batteryLow', status.battery.low ? ' Battery LOW' : '');
+  setText('firmwareRevision', status.firmware);
+  setText('ssid', wifi.connected ? wifi.ssid : 'not connected');
+  setText('signalStrength', wifi.connected ? wifi.rssi + 'dB' : 'not connected');
+  setText('roundTrip', rtt.min + '/' + rtt.avg + '/' + rtt.p99 + '/' + rtt.max
+          + ' ms min/avg/p99/max (' + rtt.samples + ' samples, ' + rtt.rssi + 'dB at last sample)');
+  setText('tcpRetransmits', 'tcpRetransmits' in status ? status.tcpRetransmits : 'not available');
+  setText('stationMAC', wifi.mac);
+
+  var template = byId('locoTemplate');
+  locos.locos.forEach(function(loco)
+  {
+    var section = template.content.cloneNode(true);
+    var form = section.querySelector('form');
+    section.querySelector('.loco').textContent = loco.id;
+    form.elements['loco'].value = loco.id;
+    form.elements['loco.address'].value = loco.address;
+    system.modes.forEach(function(mode)
+    {
+      addOption(form.elements['loco.mode'], mode.value, mode.value + ' - ' + mode.text, mode.value == loco.mode);
+    });
+    form.elements['loco.direction'].value = loco.direction;
+    form.elements['loco.longAddress'].checked = loco.longAddress;
+    section.querySelector('.funcmap').href = 'funcmap.html?loco=' + loco.id;
+    byId('locos').appendChild(section);
+  });
+
+  var enabled = byId('enabledNetworks');
+  var disabled = byId('disabledNetworks');
+  networks.networks.forEach(function(network)
+  {
+    if(network.enabled)
+    {
+      addNetwork(enabled, network.ssid, 'Network name: ', [ [ 'remove', 'Remove Network' ], [ 'disable', 'Disable Network' ] ]);
+    }
+    else
+    {
+      addNetwork(disabled, network.ssid, 'Network: ', [ [ 'remove', 'Remove Network' ], [ 'enable', 'Enable Network' ] ]);
+    }
+  });
+  [ enabled, disabled ].forEach(function(tbody)
+  {
+    if(tbody.rows.length == 0)
+    {
+      var cell = tbody.insertRow().insertCell();
+      cell.colSpan = 3;
+      cell.textContent = 'None.';
+    }
+  });
+
+  var discovery = server.discovery;
+  byId('serverName').value = server.name;
+  byId('serverPort').value = server.port;
+  byId('serverAutomatic').checked = server.automatic;
+  setText('serverUsing', server.using + ':' + server.port);
+  setText('serverDiscovery', 'Last server discovery: ' + discovery.lastDiscoveryTime + ' ms (' + discovery.discoveries + ' discoveries), '
+          + 'last connect: ' + discovery.lastConnectTime + ' ms (' + discovery.cacheConnects + ' from cache, ' + discovery.connectFailures + ' failed), '
+          + discovery.revalidations + ' background checks, server moved ' + discovery.serverMoved + ' times');
+
+  var centerSwitch = byId('centerSwitch');
+  for(var f = 0; f <= system.maxFunction; f++)
+  {
+    addOption(centerSwitch, f, 'Set F' + f, false);
+  }
+  centerSwitch.value = system.centerSwitch;
+
+  setText('speedHoldoff', status.speed.holdoff);
+  byId('speedHoldoffMin').value = system.speedHoldoff.min;
+  byId('speedHoldoffMax').value = system.speedHoldoff.max;
+
+  byId('filterMedian').value = system.speedFilter.median;
+  byId('filterIIR').value = system.speedFilter.iir;
+  byId('filterBinning').checked = system.speedFilter.binning;
+  setText('speedSteps', status.speed.steps);
+
+  byId('newVoltage').value = status.battery.voltage;
+}
+
+function showFuncMapPage(locos)
+{
+  var id = new URLSearchParams(location.search).get('loco');
+  var loco = locos.locos.find(function(l) { return l.id == id; });
+
+  document.querySelectorAll('.loco').forEach(function(span) { span.textContent = id; });
+  if(!loco)
+  {
+    byId('invalidLoco').hidden = false;
+    return;
+  }
+
+  setText('address', loco.address);
+  byId('loco').value = loco.id;
+  var tbody = byId('functions');
+  loco.functions.forEach(function(setting, f)
+  {
+    var row = tbody.insertRow();
+    row.insertCell().textContent = 'F' + f;
+    // THROTTLE ... IGNORE, see enum functionInfo
+    for(var j = 0; j <= 6; j++)
+    {
+      var radio = document.createElement('input');
+      radio.type = 'radio';
+      radio.name = 'f' + f;
+      radio.value = j;
+      radio.checked = setting == j;
+      row.insertCell().appendChild(radio);
+    }
+  });
+  byId('functionConfig').hidden = false;
+}
+
+var scanStarted = false;
+
+/**
+ * Start a new WiFi scan and show its results once it has completed
+ */
+function refreshScan()
+{
+  scanStarted = true;
+  byId('refresh').disabled = true;
+  fetch('/api/v1/scan/refresh', { method: 'POST' }).then(function() { loadJSON([ 'scan' ], showScanPage); });
+}
+
+function showScanPage(scan)
+{
+  var tbody = byId('networks');
+  var busy = scan.scanning || scan.pending;
+
+  byId('scanning').hidden = !busy;
+  byId('waiting').hidden = !scan.pending || scan.scanning;
+  byId('refused').hidden = !scan.refused || busy;
+  byId('refresh').disabled = busy;
+  if(busy)
+  {
+    setTimeout(function() { loadJSON([ 'scan' ], showScanPage); }, 1000);
+  }
+  if(scan.age === undefined)
+  {
+    // never scanned before, start the first scan right away
+    if(!busy && !scanStarted)
+    {
+      refreshScan();
+    }
+    return;
+  }
+
+  setText('age', scan.age);
+  byId('scanned').hidden = false;
+  // keep the shown results (and keys typed in) until the new scan is done
+  if(busy && tbody.rows.length > 0)
+  {
+    return;
+  }
+  tbody.replaceChildren();
+  if(scan.networks.length == 0)
+  {
+    tbody.insertRow().insertCell().textContent = 'No WiFi networks found. Refresh to repeat scan.';
+  }
+  scan.networks.forEach(function(network, i)
+  {
+    var row = tbody.insertRow();
+    var form = document.createElement('form');
+    form.action = 'config';
+    form.method = 'post';
+    form.id = 'network' + i;
+    form.innerHTML = '<input type="hidden" name="wifiSSID">';
+    form.elements['wifiSSID'].value = network.ssid;
+    row.insertCell().append(network.ssid, form);
+    var key = row.insertCell();
+    if(network.open)
+    {
+      key.textContent = 'Unencrypted network';
+    }
+    else
+    {
+      key.innerHTML = 'PSK: <input type="text" name="wifiKEY">';
+      key.querySelector('input').setAttribute('form', form.id);
+    }
+    row.insertCell().innerHTML = '<input type="submit" value="Add network">';
+    row.cells[2].querySelector('input').setAttribute('form', form.id);
+    row.insertCell().textContent = 'Signal strength: ' + network.rssi + 'dB';
+  });
+}
+
+document.addEventListener('DOMContentLoaded', function()
+{
+  switch(document.body.dataset.page)
+  {
+    case 'main':
+      loadJSON([ 'status', 'locos', 'networks', 'server', 'system' ], showMainPage);
+      break;
+    case 'funcmap':
+      loadJSON([ 'locos' ], showFuncMapPage);
+      break;
+    case 'scan':
+      byId('refresh').addEventListener('click', refreshScan);
+      loadJSON([ 'scan' ], showScanPage);
+      break;
+  }
+});
@@ -0,0 +1,121 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides a fixed-size, stack-allocated builder for single lines
+ * of the wiThrottle protocol, so sending a command does not need any heap
+ * allocation.
+ */
+
+#include "wiThrottleCommand.h"
+
+/**
+ * Start a new command line, optionally with a prefix like "MTA*<;>"
+ */
+wiThrottleCommand::wiThrottleCommand(const char * prefix)
+{
+  len = 0;
+  buffer[0] = '\0';
+  add(prefix);
+}
+
+/**
+ * Append a string - silently truncated if the buffer is full
+ */
+wiThrottleCommand & wiThrottleCommand::add(const char * text)
+{
+  // always keep space for newline and terminating zero
+  while(*text != '\0' && len < COMMAND_BUFFER_SIZE - 2)
+  {
+    buffer[len++] = *text++;
+  }
+  buffer[len] = '\0';
+  return *this;
+}
+
+/**
+ * Append a single character
+ */
+wiThrottleCommand & wiThrottleCommand::add(char c)
+{
+  if(len < COMMAND_BUFFER_SIZE - 2)
+  {
+    buffer[len++] = c;
+    buffer[len] = '\0';
+  }
+  return *this;
+}
+
+/**
+ * Append a decimal number
+ */
+wiThrottleCommand & wiThrottleCommand::add(int value)
+{
+  char digits[12];
+  uint8_t n = 0;
+  unsigned int magnitude = value < 0 ? 0u - (unsigned int) value : (unsigned int) value;
+
+  do
+  {
+    digits[n++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while(magnitude > 0);
+
+  if(value < 0)
+  {
+    add('-');
+  }
+  while(n > 0)
+  {
+    add(digits[--n]);
+  }
+  return *this;
+}
+
+/**
+ * Append a number in hexadecimal notation (lower case, without leading zeros)
+ */
+wiThrottleCommand & wiThrottleCommand::addHex(unsigned int value)
+{
+  char digits[8];
+  uint8_t n = 0;
+
+  do
+  {
+    digits[n++] = "0123456789abcdef"[value & 0x0f];
+    value >>= 4;
+  } while(value > 0);
+
+  while(n > 0)
+  {
+    add(digits[--n]);
+  }
+  return *this;
+}
+
+/**
+ * Terminate the line with a newline character
+ * (keeps space for it even if the rest has been truncated)
+ */
+wiThrottleCommand & wiThrottleCommand::end(void)
+{
+  if(len < COMMAND_BUFFER_SIZE - 1)
+  {
+    buffer[len++] = '\n';
+    buffer[len] = '\0';
+  }
+  return *this;
+}
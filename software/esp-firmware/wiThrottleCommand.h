@@ -0,0 +1,94 @@
+/**
+ * This file is part of the wiFred wireless model railroading throttle project
+ * Copyright (C) 2018-2026 Heiko Rosemann
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>
+ *
+ * This file provides a fixed-size, stack-allocated builder for single lines
+ * of the wiThrottle protocol, so sending a command does not need any heap
+ * allocation.
+ */
+
+#ifndef _WITHROTTLE_COMMAND_H_
+#define _WITHROTTLE_COMMAND_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Maximum length of a single wiThrottle line including the trailing newline
+ * Longest loco line sent is "MT+L10239<;>L10239\n"
+ */
+#define COMMAND_BUFFER_SIZE 64
+
+/**
+ * Longest loco key is "L10239"
+ */
+#define THROTTLE_ID_LENGTH 8
+
+/**
+ * Longest loco command prefix is "MTAL10239<;>"
+ */
+#define LOCO_PREFIX_LENGTH 16
+
+class wiThrottleCommand
+{
+  public:
+    /**
+     * Start a new command line, optionally with a prefix like "MTA*<;>"
+     */
+    wiThrottleCommand(const char * prefix = "");
+
+    /**
+     * Append a string - silently truncated if the buffer is full
+     */
+    wiThrottleCommand & add(const char * text);
+
+    /**
+     * Append a single character
+     */
+    wiThrottleCommand & add(char c);
+
+    /**
+     * Append a decimal number
+     */
+    wiThrottleCommand & add(int value);
+
+    /**
+     * Append a number in hexadecimal notation (lower case, without leading zeros)
+     */
+    wiThrottleCommand & addHex(unsigned int value);
+
+    /**
+     * Terminate the line with a newline character
+     * (keeps space for it even if the rest has been truncated)
+     */
+    wiThrottleCommand & end(void);
+
+    /**
+     * Access the zero-terminated line
+     */
+    const char * c_str(void) const { return buffer; }
+
+    /**
+     * Number of characters in the line
+     */
+    size_t length(void) const { return len; }
+
+  private:
+    char buffer[COMMAND_BUFFER_SIZE];
+    size_t len;
+};
+
+#endif
@@ -36,11 +36,37 @@
 #include "stateMachine.h"
 #include "throttleHandling.h"
 #include "gitVersion.h"
+#include "serverDiscovery.h"
+#include "eventHandling.h"
+#include "linkStats.h"
+#include "speedFilter.h"
+#include "pageWriter.h"
+#include "webAssets.h"
+#include "webApi.h"
 
 // #define DEBUG
 
 std::vector<wifiAPEntry> apList;
 
+lastAPInfo lastAP;
+
+/**
+ * millis() value until which the direct connection to lastAP is tried,
+ * 0 if no direct connection attempt is running
+ */
+uint32_t fastConnectUntil = 0;
+
+std::vector<scanEntry> scanResults;
+uint32_t scanTime = 0;
+bool scanRequested = false;
+bool scanRunning = false;
+bool scanRefused = false;
+
+/**
+ * millis() value of the last scan request
+ */
+uint32_t scanRequestTime = 0;
+
 WiFiMulti wifiMulti;
 
 WebServer server(80);
@@ -53,9 +79,115 @@ void readString(char * dest, size_t maxLength, String input)
   dest[maxLength - 1] = '\0';
 }
 
+/**
+ * Answer web requests in a task of its own, so slow clients or large pages
+ * never stall the main loop and with it driving
+ */
+void webServerTask(void * parameter)
+{
+  for(;;)
+  {
+    server.handleClient();
+    vTaskDelay(pdMS_TO_TICKS(WEB_SERVER_POLL_MS));
+  }
+}
+
+/**
+ * Start the configuration webserver and its task, only done once
+ */
+void startWebServer(void)
+{
+  static bool started = false;
+
+  if(started)
+  {
+    return;
+  }
+  server.begin();
+  // below the main loop task (tskIDLE_PRIORITY + 1), so pages are only served while it waits for events
+  xTaskCreate(webServerTask, "webServer", WEB_SERVER_STACK_SIZE, nullptr, tskIDLE_PRIORITY, nullptr);
+  started = true;
+}
+
+void requestWiFiScan(void)
+{
+  scanRequested = true;
+  scanRequestTime = millis();
+  scanRefused = false;
+}
+
+/**
+ * Scanning takes the radio off the channel of the access point for a while,
+ * so only scan while no loco is acquired, driven or waiting to be resumed
+ * after a reconnect, and not while WiFiMulti is scanning itself
+ */
+bool scanAllowed(void)
+{
+  switch(wiFredState)
+  {
+    case STATE_CONNECTED:
+    case STATE_LOCO_ONLINE:
+    case STATE_LOCOS_OFF:
+      return allLocosInactive();
+
+    case STATE_CONFIG_AP:
+    case STATE_CONFIG_STATION_WAITING:
+    case STATE_CONFIG_STATION:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * Start a requested WiFi scan in the background and collect its results
+ */
+void handleWiFiScan(void)
+{
+  if(scanRunning)
+  {
+    int16_t n = WiFi.scanComplete();
+    if(n == WIFI_SCAN_RUNNING)
+    {
+      return;
+    }
+    scanRunning = false;
+    if(n < 0)
+    {
+      log_d("WiFi scan failed, keeping previous results");
+      return;
+    }
+
+    scanResults.clear();
+    for(int16_t i = 0; i < n; i++)
+    {
+      scanEntry entry;
+      readString(entry.ssid, sizeof(entry.ssid), WiFi.SSID(i));
+      entry.rssi = WiFi.RSSI(i);
+      entry.open = WiFi.encryptionType(i) == WIFI_AUTH_OPEN;
+      scanResults.push_back(entry);
+    }
+    WiFi.scanDelete();
+    scanTime = millis();
+    log_d("WiFi scan found %d networks at %u ms", n, scanTime);
+  }
+  else if(scanRequested && scanAllowed())
+  {
+    scanRequested = false;
+    scanRunning = WiFi.scanNetworks(true, false, true, SCAN_CHANNEL_TIME_MS) == WIFI_SCAN_RUNNING;
+  }
+  else if(scanRequested && millis() - scanRequestTime >= SCAN_REQUEST_TIMEOUT_MS)
+  {
+    log_d("WiFi scan refused, locos still in use");
+    scanRequested = false;
+    scanRefused = true;
+  }
+}
+
 void handleWiFi(void)
 {
-  server.handleClient();
+  handleWiFiScan();
   switch(wiFredState)
   {
     case STATE_CONFIG_AP:
@@ -73,6 +205,17 @@ void handleWiFi(void)
       break;
 
     case STATE_CONNECTING:
+      if(fastConnectUntil != 0)
+      {
+        // give the direct connection attempt its time before scanning
+        if(millis() < fastConnectUntil)
+        {
+          break;
+        }
+        log_d("Boot phase: direct connection to %s failed at %u ms, scanning", lastAP.ssid, millis());
+        fastConnectUntil = 0;
+        WiFi.disconnect();
+      }
       wifiMulti.run(SINGLE_NETWORK_TIMEOUT_MS);
       break;
 
@@ -156,16 +299,56 @@ void initWiFiSTA(void)
   }
 
   // start configuration webserver
-  server.begin();
+  startWebServer();
 
   // no network found, quickly open config AP mode
   if(numNetworks == 0)
   {
-    initWiFiAP();
     switchState(STATE_CONFIG_AP);
+    return;
+  }
+
+  // try the last used access point directly, skipping the scan of all channels
+  fastConnectUntil = 0;
+  if(lastAP.valid)
+  {
+    for(std::vector<wifiAPEntry>::iterator it = apList.begin() ; it != apList.end(); it++)
+    {
+      if(!it->disabled && !strcmp(it->ssid, lastAP.ssid))
+      {
+        log_d("Boot phase: direct connection to %s on channel %d at %u ms", lastAP.ssid, lastAP.channel, millis());
+        WiFi.begin(it->ssid, it->key, lastAP.channel, lastAP.bssid);
+        fastConnectUntil = millis() + FAST_CONNECT_TIMEOUT_MS;
+        break;
+      }
+    }
   }
 }
 
+void wifiConnected(void)
+{
+  log_d("Boot phase: connected to %s after %u ms%s", WiFi.SSID().c_str(), millis(),
+        fastConnectUntil != 0 ? " (direct connection)" : "");
+  fastConnectUntil = 0;
+
+  uint8_t * bssid = WiFi.BSSID();
+  int32_t channel = WiFi.channel();
+  String ssid = WiFi.SSID();
+
+  // only write to flash if anything changed
+  if(bssid == nullptr || (lastAP.valid && lastAP.channel == channel
+     && !memcmp(lastAP.bssid, bssid, sizeof(lastAP.bssid)) && ssid == lastAP.ssid))
+  {
+    return;
+  }
+
+  readString(lastAP.ssid, sizeof(lastAP.ssid), ssid);
+  memcpy(lastAP.bssid, bssid, sizeof(lastAP.bssid));
+  lastAP.channel = channel;
+  lastAP.valid = true;
+  saveLastAP();
+}
+
 void shutdownWiFiSTA(void)
 {
   WiFi.disconnect();
@@ -219,10 +402,13 @@ void initWiFiAP(void)
   MDNS.addService("http", "tcp", 80);
 
   // start configuration webserver
-  server.begin();
+  startWebServer();
 }
 
-void writeMainPage()
+/**
+ * Apply the settings sent by one of the forms on the configuration pages
+ */
+void handleConfigArgs(void)
 {
   uint8_t loco = server.arg("loco").toInt();
 
@@ -242,8 +428,7 @@ void writeMainPage()
 
     if(!locoServer.automatic)
     {
-      free(automaticServer);
-      automaticServer = nullptr;
+      forgetServer();
     }
 
     saveLocoServer();    
@@ -305,6 +490,32 @@ void writeMainPage()
     }
   }
 
+  if (server.hasArg("speedHoldoffMin") && server.hasArg("speedHoldoffMax"))
+  {
+    int holdoffMin = server.arg("speedHoldoffMin").toInt();
+    int holdoffMax = server.arg("speedHoldoffMax").toInt();
+    if(0 <= holdoffMin && holdoffMin <= holdoffMax && holdoffMax <= 2000)
+    {
+      speedHoldoffMin = holdoffMin;
+      speedHoldoffMax = holdoffMax;
+      saveGeneralConfig();
+    }
+  }
+
+  if (server.hasArg("filterMedian") && server.hasArg("filterIIR"))
+  {
+    int median = server.arg("filterMedian").toInt();
+    int iir = server.arg("filterIIR").toInt();
+    if(1 <= median && median <= SPEED_MEDIAN_MAX && median % 2 == 1 && 0 <= iir && iir <= SPEED_IIR_SHIFT_MAX)
+    {
+      speedFilter.medianLength = median;
+      speedFilter.iirShift = iir;
+      speedFilter.binning = server.hasArg("filterBinning");
+      resetSpeedFilter();
+      saveGeneralConfig();
+    }
+  }
+
   // check if this is a "manually add WiFi network" request
   if (server.hasArg("wifiSSID"))
   {
@@ -393,210 +604,91 @@ void writeMainPage()
     battFactor = battFactor * server.arg("newVoltage").toInt() / batteryVoltage;
     saveAnalogConfig();
   }
+}
 
-  String resp = String("<!DOCTYPE HTML>\r\n")
-              + "<html lang=\"en\"><head><meta charset=\"utf-8\"><title>wiFred configuration page</title></head>\r\n"
-              + "<body><h1>wiFred configuration page</h1>\r\n"
-              + "<hr>General configuration and status<hr>\r\n"
-              + "<form action=\"index.html\" method=\"get\"><table border=0>"
-              + "<tr><td>Throttle name:</td><td><input type=\"text\" name=\"throttleName\" value=\"" + throttleName + "\"></td>"
-              + "<td><input type=\"submit\" value=\"Save name\"></td></tr></table></form>\r\n"
-              + "<table border=0>"
-              + "<tr><td>Battery voltage: </td><td>" + batteryVoltage + " mV" + (lowBattery ? " Battery LOW" : "" ) + "</td></tr>"
-              + "<tr><td>Firmware revision: </td><td>" + REV + "</td></tr></table>\r\n"
-              + "<table><tr><td>Active WiFi network SSID:</td><td>" + (WiFi.isConnected() ? WiFi.SSID() : "not connected") + "</td></tr>"
-              + "<tr><td>Signal strength:</td><td>" + (WiFi.isConnected() ? (String) WiFi.RSSI() + "dB" : "not connected") + "</td></tr>"
-              + "<tr><td>WiFi STA MAC address:</td><td>" + WiFi.macAddress() + "</td></tr>"
-              + "<tr><td colspan = 2><a href=\"./flashred.html\">Flash red LED to identify wiFred</a></td></tr></table>";
-  
-  for(uint8_t i=0; i<4; i++)
+/**
+ * Send one of the static pages, scripts or style sheets, or only tell the
+ * browser to use its cached copy if it is still the same
+ */
+void serveWebAsset(const webAsset &asset)
+{
+  server.sendHeader("ETag", asset.etag);
+  server.sendHeader("Cache-Control", "no-cache");
+  if(server.header("If-None-Match") == asset.etag)
   {
-    resp      += String("<hr>Loco configuration for loco: ") + (i+1) + "\r\n" 
-              + "<form action=\"index.html\" method=\"get\"><table border=0>"
-              + "<tr><td>DCC address: (-1 to disable)</td> <td><input type=\"text\" name=\"loco.address\" value=\"" + locos[i].address + "\"></td></tr>"
-              + "<tr><td>Speed Step Mode: </td> <td><select name='loco.mode'>";
-    for(int j=0; j<MODES_LENGTH; ++j)
-    {
-      resp += String("<option value=\"") + MODES[j].val + "\"";
-      if( strcmp(MODES[j].val, locos[i].mode) == 0 )
-      {
-         resp += String(" selected");
-      }
-      resp += String(">") + MODES[j].val + " - "+ MODES[j].text + "</option>";
-    }
-    resp      += String("</select></td></tr>")
-              + "<tr><td>Direction:</td><td>"
-              + "<input type=\"radio\" name=\"loco.direction\" value=\"" + DIR_NORMAL + "\"" + (locos[i].direction == DIR_NORMAL ? " checked" : "" ) + ">Forward"
-              + "<input type=\"radio\" name=\"loco.direction\" value=\"" + DIR_REVERSE + "\"" + (locos[i].direction == DIR_REVERSE ? " checked" : "" ) + ">Reverse"
-              + "<input type=\"radio\" name=\"loco.direction\" value=\"" + DIR_DONTCHANGE + "\"" + (locos[i].direction == DIR_DONTCHANGE ? " checked" : "" ) + ">Don't change"
-              + "</td></tr>"
-              + "<tr><td>Long Address?</td> <td><input type=\"checkbox\" name=\"loco.longAddress\"" + (locos[i].longAddress ? " checked" : "" ) + "></td></tr>"
-              + "<tr><td colspan=2><a href=\"funcmap.html?loco=" + (i+1) + "\">Function mapping</a></td></tr></table>"
-              + "<input type=\"hidden\" name=\"loco\" value=\"" + (i+1) + "\"><input type=\"submit\" value=\"Save loco config\"></form>";
+    server.send(304);
+    return;
   }
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, asset.contentType, (const char *) asset.data, asset.length);
+}
 
-  uint32_t numNetworks = 0;
-
-  resp        += String("<hr>WiFi configuration<hr>\r\n")
-              + "<table border=0><tr><td colspan=3><a href=scanWifi.html>Scan for networks</a></td></tr>"
-              + "<tr><td colspan=3>Known and enabled WiFi networks:</td></tr>";
-  for(std::vector<wifiAPEntry>::iterator it = apList.begin() ; it != apList.end(); ++it)
+/**
+ * @returns the static asset for path or nullptr if there is none
+ */
+const webAsset * findWebAsset(const char * path)
+{
+  for(size_t i = 0; i < WEB_ASSETS_COUNT; i++)
   {
-    if(!it->disabled)
+    if(strcmp(WEB_ASSETS[i].path, path) == 0)
     {
-      resp += String("<tr><td>Network name: ") + it->ssid + "</td>"
-          + "<td><form action=\"index.html\" method=\"get\"><input type=\"hidden\" name=\"remove\" value=\"" + it->ssid + "\"><input type=\"submit\" value=\"Remove Network\"></form></td>"
-          + "<td><form action=\"index.html\" method=\"get\"><input type=\"hidden\" name=\"disable\" value=\"" + it->ssid + "\"><input type=\"submit\" value=\"Disable Network\"></form></td></tr>\r\n";
-      numNetworks++;
+      return &WEB_ASSETS[i];
     }
   }
+  return nullptr;
+}
 
-  if(numNetworks == 0)
+/**
+ * Main page, also applies settings sent as GET arguments by older pages and scripts
+ */
+void writeMainPage()
+{
+  // GET arguments are applied and answered with the page itself, as before,
+  // only the form target /config redirects
+  if(server.args() > 0)
   {
-    resp += String("<tr><td colspan=3>None.</td></tr>");
+    runInMainLoop(handleConfigArgs);
   }
-  numNetworks = 0;
-
-  resp += String("<tr><td colspan=3>Known but disabled WiFi networks:</td></tr>");
 
-  for(std::vector<wifiAPEntry>::iterator it = apList.begin() ; it != apList.end(); ++it)
+  runInMainLoop([]()
   {
-    if(it->disabled)
+    if(wiFredState == STATE_CONFIG_STATION_WAITING)
     {
-      resp += String("<tr><td>Network: ") + it->ssid + "</td>"
-          + "<td><form action=\"index.html\" method=\"get\"><input type=\"hidden\" name=\"remove\" value=\"" + it->ssid + "\"><input type=\"submit\" value=\"Remove Network\"></form></td>"
-          + "<td><form action=\"index.html\" method=\"get\"><input type=\"hidden\" name=\"enable\" value=\"" + it->ssid + "\"><input type=\"submit\" value=\"Enable Network\"></form></td></tr>\r\n";
-      numNetworks++;          
+      switchState(STATE_CONFIG_STATION);
+      setLEDvalues("100/100", "100/100", "100/100");
     }
-  }
+  });
 
-  if(numNetworks == 0)
-  {
-    resp += String("<tr><td colspan=3>None.</td></tr>");
-  }
-  
-  resp        += String("<form action=\"index.html\" method=\"get\"><tr>")
-                 + "<td>New SSID: <input type=\"text\" name=\"wifiSSID\"></td>"
-                 + "<td>New PSK: <input type=\"text\" name=\"wifiKEY\"></td>"
-                 + "<td><input type = \"submit\" value=\"Manually add network\"></td>"
-                 +  "</tr></form></table>\r\n";
-
-  resp        += String("<a href=restart.html>Restart wiFred to enable new WiFi settings</a>\r\n")
-                 + " WiFi settings will not be active until restart.\r\n";
-              
-  resp        += String("<hr>Loco server configuration<hr>\r\n")
-              + "<form action=\"index.html\" method=\"get\"><table border=0>"
-              + "<tr><td>Loco server and port: </td>"
-              + "<td><input type=\"text\" name=\"loco.serverName\" value=\"" + locoServer.name + "\">:<input type=\"text\" name=\"loco.serverPort\" value=\"" + locoServer.port + "\"></td></tr>"
-              + "<tr><td style=\"text-align: right\"><input type=\"checkbox\" name=\"loco.automatic\"" + (locoServer.automatic ? " checked" : "") + "></td><td>Find server automatically through Zeroconf/Bonjour instead.</td></tr>"
-              + "<tr><td colspan=2>Using " + (locoServer.automatic && automaticServer != nullptr ? automaticServer : locoServer.name) + ":" + locoServer.port + "</td></tr>"
-              + "<tr><td colspan=2><input type=\"submit\" value=\"Save loco server settings\"></td></tr></table></form>";
-
-  resp        += String("<hr>wiFred system<hr>\r\n")
-              + "<form action=\"index.html\" method=\"get\"><table border=0>"
-              + "<tr><td>Center position of direction switch:</td><td><select id=\"centerSwitch\" name=\"centerSwitch\">"
-              + "<option value=\"-2\"" + (centerFunction == -2 ? " selected" : "") + ">No action</option>"
-              + "<option value=\"-1\"" + (centerFunction == -1 ? " selected" : "") + ">Zero speed</option>";
-  
-  for(int f=0; f <= MAX_FUNCTION; f++)
-  {
-    resp += String("<option value=\"") + f + "\"" + (centerFunction == f ? " selected" : "") + ">Set F" + f + "</option>";
-  }
-              
-  resp        += String("</select><input type=\"submit\" value=\"Save setting\"></td></tr></table></form>")
-              + "<form action=\"index.html\" method=\"get\"><input type=\"hidden\" name=\"resetPoti\" value=\"true\"><input type=\"submit\" value=\"Reset speed calibration\"></form>"
-              + "<form action=\"index.html\" method=\"get\">Actual battery voltage: <input type=\"text\" name=\"newVoltage\" value=\"" + batteryVoltage + "\"><input type=\"submit\" value=\"Correct battery voltage calibration\"></form>"
-              + "<a href=resetConfig.html>Reset wiFred to factory defaults</a>\r\n"
-              + "<a href=update>Update wiFred firmware</a>\r\n"
-              + "</body></html>";
-  
-  server.send(200, "text/html", resp);
+  serveWebAsset(*findWebAsset("/index.html"));
 }
 
-void writeFuncMapPage()
+/**
+ * Form target of all configuration pages, returns to the main page afterwards
+ */
+void handleConfigForm()
 {
-  uint8_t loco = server.arg("loco").toInt();
-
-  // check if this is a "set configuration" request
-  if(loco >= 1 && loco <= 4 && server.hasArg("f0") && server.hasArg("f1"))
-  {
-    for(uint8_t i=0; i<= MAX_FUNCTION; i++)
-    {
-      locos[loco-1].functions[i] = (functionInfo) server.arg(String("f") + i).toInt();
-    }
-
-    saveLocoConfig(loco-1);
-  }
-
-  String resp = String("<!DOCTYPE HTML>\r\n")
-              + "<html><head><title>wiFred configuration page</title></head>\r\n"
-              + "<body><h1>Function mapping for Loco: " + loco + "</h1>\r\n";
-  if(loco < 1 || loco > 4)
-  {
-    resp      += String("Loco ") + loco + " is not valid. Valid locos are in the range [1..4].";
-  }
-  else
-  {
-    resp      += String("<hr>Function configuration for loco ") + loco + " (DCC address: " + locos[loco-1].address + ")<hr>"
-              + "<form action=\"index.html\" method=\"get\"><table border=0>"
-              + "<tr style=\"text-align: center\">"
-              + "<td>Function</td>"
-              + "<td>Throttle controlled</td>"
-              + "<td>Throttle controlled, force momentary</td>"
-              + "<td>Throttle controlled, force locking</td>"
-              + "<td>Throttle controlled if this is the only loco</td>"
-              + "<td>Force function always on</td>"
-              + "<td>Force function always off</td>"
-              + "<td>Ignore function key</td></tr>";
-
-    for(uint8_t i=0; i<=MAX_FUNCTION; i++)
-    {
-      resp    += String("<tr style=\"text-align: center");
-      if(i%2)
-      {
-        resp  += String("; background-color: #eee");
-      }
-      resp += String("\"><td>F") + i + "</td>";
-      for(uint8_t j=THROTTLE; j<=IGNORE; j++)
-      {
-        resp += String("<td><input type=\"radio\" name=\"f") + i + "\" value=\"" + j + "\"" 
-             + (locos[loco-1].functions[i] == j ? " checked" : "" ) + "></td>";
-      }
-      resp    += String("</tr>");
-    }
-    resp      += String("<tr><td colspan=4><input type=\"hidden\" name=\"loco\" value=\"") + loco + "\"><input type=\"submit\" value=\"Save function configuration and return to main page\"></td></tr></table></form>\r\n";
-  }
-  resp        += String("<hr><a href=\"/\">Back to main configuration page (unsaved data will be lost)</a><hr></body></html>");
-  server.send(200, "text/html", resp);
+  runInMainLoop(handleConfigArgs);
+  server.sendHeader("Location", "/");
+  server.send(303);
 }
 
-void scanWifi()
+/**
+ * Write text with the characters which are special in XML (and HTML) escaped
+ */
+void printEscaped(Print &out, const char * text)
 {
-  uint32_t n = WiFi.scanNetworks(false, false, true, 100);
-  
-  String resp = String("<!DOCTYPE HTML>\r\n")
-                + "<html><head><title>Scan for WiFi networks</title></head>"
-                + "<body><h1>Results of WiFi scan</h1>"
-                + "<table border=0>";
-
-  if(n == 0)
+  for(; *text; text++)
   {
-    resp += String("<tr><td>No WiFi networks found. Reload to repeat scan.</td></tr>");
-  }
-  
-  for(uint32_t i = 0; i < n; i++)
-  {
-    resp += String("<form action=\"index.html\" method = \"get\">")
-            + "<tr><td>" + WiFi.SSID(i) + "<input type=\"hidden\" name=\"wifiSSID\" value=\"" + WiFi.SSID(i) + "\"></td>" 
-            + "<td>" + (WiFi.encryptionType(i) == WIFI_AUTH_OPEN ? "Unencrypted network" : "PSK: <input type=\"text\" name=\"wifiKEY\">") + "</td>"
-            + "<td><input type=\"submit\" value=\"Add network\"></td>"
-            + "<td>Signal strength: " + WiFi.RSSI(i) + "dB</td></tr></form>";
+    switch(*text)
+    {
+      case '&':  out.print("&amp;");  break;
+      case '<':  out.print("&lt;");   break;
+      case '>':  out.print("&gt;");   break;
+      case '"':  out.print("&quot;"); break;
+      case '\'': out.print("&#39;");  break;
+      default:   out.print(*text);    break;
+    }
   }
-
-  resp += String("</table>")
-          + "<a href=\"/index.html\">Return to main page</a></body></html>";
-
-  server.send(200, "text/html", resp);
 }
 
 void restartESP()
@@ -621,7 +713,7 @@ void resetESP()
                   + "<a href=\"/index.html\">Return to main page</a> (Might require reconnecting to wiFred WiFi)\r\n"
                   + "</body></html>";
     server.send(200, "text/html", resp);    
-    deleteAllConfig();
+    runInMainLoop(deleteAllConfig);
     delay(500);
     restartESP();
   }
@@ -643,110 +735,233 @@ void resetESP()
    return wiFred Config as XML-Data for using with Application as api */
 void getConfigXML()
 {
-   /* get macadress */
-   uint8_t mac[6];
-   String macAdress = "";
-   
-  
-     WiFi.macAddress(mac);
-     macAdress = String(mac[0], 16) + String(mac[1], 16) + String(mac[2], 16) + String(mac[3], 16) + String(mac[4], 16) + String(mac[5], 16);
-     
-//     char * hostName = strdup(throttleName);
-
-   /* collect response */      
-   String resp = String("<?XML version=\"1.0\" encoding=\"UTF?8\"?>\r\n")
-               
-          + "<wiFred>\r\n"
-                  + "<structurVersion value=\"1\"/>\r\n"
-          
-          + "<throttleName value=\"" + throttleName + "\"/>\r\n"
-        //  + "<ownWifiName value=\"" + "? todo"+  "\"/>\r\n"  // name of the WiFi when device create one
-        //  + "<computerName value=\"" + hostName + "\"/>\r\n" // name of the device shown in the network
-          + "<localIP value=\"" + WiFi.localIP().toString() + "\"/>\r\n"
-                  + "<firmwareRevision value=\"" + REV + "\"/>\r\n"
-
-                  + "<batteryVoltage value=\""+ batteryVoltage+ "\"/>\r\n" 
-          + "<batteryLow value=\"" + (lowBattery ? "1" : "0" )+ "\"/>\r\n"
-
-          +"<WiFi>\r\n"
-            + "  <Connected value=\"" + (WiFi.isConnected() ? "1" : "0" )+ "\"/>\r\n"
-                    + "  <SSID value=\"" + (WiFi.isConnected() ? WiFi.SSID() : " " )+ "\"/>\r\n"
-                    + "  <signalStrength value=\"" + (WiFi.isConnected() ?  (String) WiFi.RSSI() : " " )+ "\"/>\r\n"
-                    + "  <macAdress value=\"" + macAdress + "\"/>\r\n"
-                    
-              +"</WiFi>\r\n";
-
-          resp +="<LOCOS>\r\n";
-
-          for(uint8_t i=0; i<4; i++)
-          {
-           resp      += " <LOCO ID=\"" + String(i+1) + "\">\r\n" 
-              + "  <DCCadress value=\""+ locos[i].address + "\"/>\r\n"
-              + "  <Mode value=\""+ locos[i].mode + "\" />\r\n"
-              + "  <Direction value=\""+ locos[i].direction + "\" />\r\n"
-              + "  <LongAdress value=\""+ locos[i].longAddress + "\" />\r\n"
-              + "  <FUNCTIONS>\r\n" ; 
-
-              for(uint8_t j=0; j<= MAX_FUNCTION; j++)
-              {
-                resp +=  "     <Function ID=\""+String(j)+"\" value=\""+ locos[i].functions[j] +"\" />\r\n" ;
-              }
-
-              resp +=  "  </FUNCTIONS>\r\n </LOCO>\r\n"; 
-           }
-           resp +="</LOCOS>\r\n";
-
-           resp +="<NETWORKS>\r\n";
-           for(std::vector<wifiAPEntry>::iterator it = apList.begin() ; it != apList.end(); ++it)
-           {
-                resp += String(" <NETWORK>\r\n  <SSID value=\"") + it->ssid + "\"/>\r\n";
-                resp += String("  <Key value=\"") + it->key + "\"/>\r\n";
-                if(!it->disabled)
-                {
-                  resp += "  <Enabled value=\"1\" />\r\n";     
-                }
-                else
-                {
-                  resp += "  <Enabled value=\"0\" />\r\n"; 
-                }
-                resp += " </NETWORK>\r\n";
-                
-           }
-           resp +="</NETWORKS>\r\n";
-
-           resp += "<LOCOSERVER>\r\n";
-            resp += "   <ServerName value=\""  + String(locoServer.name) + "\" />\r\n";
-            resp += "   <Port value=\"" + String(locoServer.port) + "\" />\r\n";
-            resp += "   <Automatic value=\"" + String(locoServer.automatic) +"\" />\r\n";
-           resp +="</LOCOSERVER>\r\n";
-
-           resp += "<centerSwitch value=\"" + String(centerFunction) + "\" />\r\n";
-           
-    resp      +=   "</wiFred>\r\n";
-        
-   server.send(200, "text/html", resp);      
+  rttSummary rtt;
+  int8_t rssi;
+  uint16_t voltage;
+  bool batteryLow;
+  locoInfo locoConfig[4];
+  std::vector<wifiAPEntry> networks;
+  char usingServer[SERVER_HOSTNAME_LENGTH];
+  serverDiscoveryStatistics discovery;
+  uint32_t holdoff;
+  uint8_t steps;
+
+  // copy what the main loop changes, the page is streamed afterwards so a slow client does not hold up driving
+  // (the mode strings are only replaced through the config form, i.e. by this task)
+  runInMainLoop([&]()
+  {
+    rtt = getRTTSummary();
+    rssi = linkRSSI;
+    voltage = batteryVoltage;
+    batteryLow = lowBattery;
+    memcpy(locoConfig, locos, sizeof(locoConfig));
+    networks = apList;
+    readString(usingServer, sizeof(usingServer), locoServer.automatic && serverCache.valid ? serverCache.hostname : locoServer.name);
+    discovery = discoveryStats;
+    holdoff = getSpeedHoldoff();
+    steps = getSpeedSteps();
+  });
+
+  /* get macadress */
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+
+  /* collect response */
+  pageWriter page(server, "text/xml");
+
+  page.print("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n"
+             "<wiFred>\r\n"
+             "<structurVersion value=\"1\"/>\r\n"
+             "<throttleName value=\"");
+  printEscaped(page, throttleName);
+  page.print("\"/>\r\n"
+             "<localIP value=\"");
+  page.print(WiFi.localIP().toString());
+  page.print("\"/>\r\n"
+             "<firmwareRevision value=\"" REV "\"/>\r\n");
+  page.printf("<batteryVoltage value=\"%u\"/>\r\n", voltage);
+  page.printf("<batteryLow value=\"%u\"/>\r\n", batteryLow);
+
+  page.print("<WiFi>\r\n");
+  page.printf("  <Connected value=\"%u\"/>\r\n", WiFi.isConnected());
+  page.print("  <SSID value=\"");
+  printEscaped(page, WiFi.isConnected() ? WiFi.SSID().c_str() : " ");
+  page.print("\"/>\r\n"
+             "  <signalStrength value=\"");
+  page.print(WiFi.isConnected() ? (String) WiFi.RSSI() : " ");
+  page.print("\"/>\r\n");
+  page.printf("  <roundTrip samples=\"%u\" min=\"%u\" avg=\"%u\" p99=\"%u\" max=\"%u\" rssi=\"%d\"/>\r\n",
+              rtt.count, rtt.min, rtt.avg, rtt.p99, rtt.max, rssi);
+  page.printf("  <tcpRetransmits value=\"%d\"/>\r\n", getTCPRetransmits());
+  page.printf("  <macAdress value=\"%x%x%x%x%x%x\"/>\r\n", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  page.print("  <stationMAC value=\"");
+  page.print(WiFi.macAddress());
+  page.print("\"/>\r\n"
+             "</WiFi>\r\n");
+
+  page.print("<LOCOS>\r\n");
+  for(uint8_t i=0; i<4; i++)
+  {
+    page.printf(" <LOCO ID=\"%u\">\r\n", i+1);
+    page.printf("  <DCCadress value=\"%d\"/>\r\n", locoConfig[i].address);
+    page.print("  <Mode value=\"");
+    printEscaped(page, locoConfig[i].mode);
+    page.print("\" />\r\n");
+    page.printf("  <Direction value=\"%u\" />\r\n", locoConfig[i].direction);
+    page.printf("  <LongAdress value=\"%u\" />\r\n", locoConfig[i].longAddress);
+    page.print("  <FUNCTIONS>\r\n");
+    for(uint8_t j=0; j<= MAX_FUNCTION; j++)
+    {
+      page.printf("     <Function ID=\"%u\" value=\"%u\" />\r\n", j, locoConfig[i].functions[j]);
+    }
+    page.print("  </FUNCTIONS>\r\n </LOCO>\r\n");
+  }
+  page.print("</LOCOS>\r\n");
+
+  page.print("<MODES>\r\n");
+  for(int j=0; j<MODES_LENGTH; ++j)
+  {
+    page.printf(" <Mode value=\"%s\" text=\"%s\" />\r\n", MODES[j].val, MODES[j].text);
+  }
+  page.print("</MODES>\r\n");
+
+  page.print("<NETWORKS>\r\n");
+  for(std::vector<wifiAPEntry>::iterator it = networks.begin() ; it != networks.end(); ++it)
+  {
+    page.print(" <NETWORK>\r\n  <SSID value=\"");
+    printEscaped(page, it->ssid);
+    page.print("\"/>\r\n  <Key value=\"");
+    printEscaped(page, it->key);
+    page.print("\"/>\r\n");
+    page.printf("  <Enabled value=\"%u\" />\r\n", !it->disabled);
+    page.print(" </NETWORK>\r\n");
+  }
+  page.print("</NETWORKS>\r\n");
+
+  page.print("<LOCOSERVER>\r\n"
+             "   <ServerName value=\"");
+  printEscaped(page, locoServer.name);
+  page.print("\" />\r\n");
+  page.printf("   <Port value=\"%u\" />\r\n", locoServer.port);
+  page.printf("   <Automatic value=\"%u\" />\r\n", locoServer.automatic);
+  page.print("   <Using value=\"");
+  printEscaped(page, usingServer);
+  page.print("\" />\r\n");
+  page.printf("   <Discovery discoveries=\"%u\" lastDiscoveryTime=\"%u\" cacheConnects=\"%u\" connectFailures=\"%u\""
+              " lastConnectTime=\"%u\" revalidations=\"%u\" serverMoved=\"%u\" />\r\n",
+              discovery.discoveries, discovery.lastDiscoveryTime, discovery.cacheConnects, discovery.connectFailures,
+              discovery.lastConnectTime, discovery.revalidations, discovery.serverMoved);
+  page.print("</LOCOSERVER>\r\n");
+
+  page.printf("<centerSwitch value=\"%d\" />\r\n", centerFunction);
+  page.printf("<speedHoldoff min=\"%u\" max=\"%u\" current=\"%u\" />\r\n", speedHoldoffMin, speedHoldoffMax, holdoff);
+  page.printf("<speedFilter median=\"%u\" iir=\"%u\" binning=\"%u\" steps=\"%u\" />\r\n",
+              speedFilter.medianLength, speedFilter.iirShift, speedFilter.binning, steps);
+
+  page.print("</wiFred>\r\n");
+  page.end();
 }
+
 /* end db211109*/
 
 void doFlashRED(void)
 {
-  if(server.hasArg("count"))
-  {
-    setLEDblink(server.arg("count").toInt());
-  }
-  else  
-  {
-    setLEDblink(10);
-  }
+  unsigned int count = server.hasArg("count") ? server.arg("count").toInt() : 10;
+  runInMainLoop([count]() { setLEDblink(count); });
   String resp = String("<!DOCTYPE HTML>\r\n")
               + "<html><head><title>Blinking red LED</title></head>\r\n"
               + "<body><h1>Blinking red LED</h1>\r\n"
-              + "Red LED will blink " + (server.hasArg("count") ? server.arg("count").toInt() : 10) + " times.\r\n"
+              + "Red LED will blink " + count + " times.\r\n"
               + "<a href=\"/index.html\">Return to main page</a> (will not stop blinking)\r\n"
               + "</body></html>";
   server.send(200, "text/html", resp);    
 }
 
+void writeStatePage(void)
+{
+  uint32_t now;
+  state current;
+  uint32_t entered;
+  stateStatistics stats[NUM_STATES];
+  uint16_t transitions[NUM_STATES][NUM_STATES];
+  uint32_t resumes, outage, sent, suppressed, inputLatency, loopMax;
+  uint32_t passes[LOOP_LATENCY_BUCKETS];
+
+  runInMainLoop([&]()
+  {
+    now = millis();
+    current = wiFredState;
+    entered = stateEntered;
+    memcpy(stats, stateStats, sizeof(stats));
+    memcpy(transitions, stateTransitions, sizeof(transitions));
+    resumes = sessionResumes;
+    outage = lastOutageTime;
+    sent = speedCommandsSent;
+    suppressed = speedCommandsSuppressed;
+    inputLatency = inputLatencyMax;
+    loopMax = loopLatencyMax;
+    memcpy(passes, loopLatency, sizeof(passes));
+  });
+
+  pageWriter page(server, "text/html");
+
+  page.print("<!DOCTYPE HTML>\r\n"
+             "<html><head><title>wiFred state statistics</title></head>\r\n"
+             "<body><h1>State machine statistics</h1>\r\n");
+  page.printf("Current state: %s for %u ms, up for %u ms<hr>\r\n", getStateName(current), now - entered, now);
+  page.print("<table border=1><tr><th>State</th><th>Entries</th><th>Total time (ms)</th><th>First entered (ms since boot)</th></tr>\r\n");
+
+  for(uint8_t i = 0; i < NUM_STATES; i++)
+  {
+    if(stats[i].entries == 0)
+    {
+      continue;
+    }
+    uint32_t totalTime = stats[i].totalTime + (i == current ? now - entered : 0);
+    page.printf("<tr><td>%s</td><td>%u</td><td>%u</td><td>%u</td></tr>\r\n",
+                getStateName((state) i), stats[i].entries, totalTime, stats[i].firstEntered);
+  }
+
+  page.print("</table><hr>Transitions<hr>\r\n"
+             "<table border=1><tr><th>From</th><th>To</th><th>Count</th></tr>\r\n");
+
+  for(uint8_t i = 0; i < NUM_STATES; i++)
+  {
+    for(uint8_t j = 0; j < NUM_STATES; j++)
+    {
+      if(transitions[i][j] != 0)
+      {
+        page.printf("<tr><td>%s</td><td>%s</td><td>%u</td></tr>\r\n",
+                    getStateName((state) i), getStateName((state) j), transitions[i][j]);
+      }
+    }
+  }
+
+  page.printf("</table><hr>Sessions resumed after lost connection: %u, last outage: %u ms\r\n", resumes, outage);
+  page.printf("<hr>Speed commands sent: %u, not sent because no speed step changed: %u\r\n", sent, suppressed);
+  page.printf("<hr>Longest wait of a key or speed event for the main loop: %u ms, %u events dropped\r\n",
+              inputLatency, inputQueue.dropped.load());
+
+  page.printf("<hr>Main loop pass duration (longest: %u ms)<hr>\r\n", loopMax);
+  page.print("<table border=1><tr><th>Duration</th><th>Count</th></tr>\r\n");
+
+  for(uint8_t i = 0; i < LOOP_LATENCY_BUCKETS; i++)
+  {
+    if(i < LOOP_LATENCY_BUCKETS - 1)
+    {
+      page.printf("<tr><td>&lt; %u ms</td><td>%u</td></tr>\r\n", LOOP_LATENCY_LIMITS[i], passes[i]);
+    }
+    else
+    {
+      page.printf("<tr><td>&gt;= %u ms</td><td>%u</td></tr>\r\n", LOOP_LATENCY_LIMITS[i - 1], passes[i]);
+    }
+  }
+
+  page.print("</table>\r\n"
+             "<a href=\"/index.html\">Return to main page</a></body></html>");
+  page.end();
+}
+
 void broadcastUDP(void)
 {
   AsyncUDP udp;
@@ -755,14 +970,26 @@ void broadcastUDP(void)
 
 void initWiFi(void)
 {
+  const char * headers[] = { "If-None-Match" };
+  server.collectHeaders(headers, 1);
+
   server.on("/", writeMainPage);
-  server.on("/funcmap.html", writeFuncMapPage);
-  server.on("/scanWifi.html", scanWifi);
+  server.on("/index.html", writeMainPage);
+  for(size_t i = 0; i < WEB_ASSETS_COUNT; i++)
+  {
+    if(strcmp(WEB_ASSETS[i].path, "/index.html") != 0)
+    {
+      server.on(WEB_ASSETS[i].path, [i]() { serveWebAsset(WEB_ASSETS[i]); });
+    }
+  }
+  server.on("/config", HTTP_POST, handleConfigForm);
   server.on("/restart.html", restartESP);
   server.on("/resetConfig.html", resetESP);
   server.on("/api/getConfigXML", getConfigXML); // db211109 return config as xml
   server.on("/flashred.html", doFlashRED);  //db 220828 let red LED flash from extern x times
+  server.on("/states.html", writeStatePage);
   server.onNotFound(writeMainPage);
+  initWebApi(server);
 
   updater.setup(&server);
 }
@@ -22,12 +22,35 @@
 #define _WIFI_H_
 
 #include <vector>
+#include <stdint.h>
 
 #define SINGLE_NETWORK_TIMEOUT_MS 20000
 #define TOTAL_NETWORK_TIMEOUT_MS 60000
 
+/**
+ * Time to wait for a direct connection to the last used access point
+ * before falling back to scanning for all configured networks
+ */
+#define FAST_CONNECT_TIMEOUT_MS 4000
+
 #define UDP_BROADCAST_PORT 51289
 
+/**
+ * Time spent listening on each channel during a (passive) WiFi scan
+ */
+#define SCAN_CHANNEL_TIME_MS 100
+
+/**
+ * Time a requested WiFi scan waits for the locos to be released before it is refused
+ */
+#define SCAN_REQUEST_TIMEOUT_MS 30000
+
+/**
+ * Interval in which the web server task polls for requests, and its stack size
+ */
+#define WEB_SERVER_POLL_MS 2
+#define WEB_SERVER_STACK_SIZE 8192
+
 typedef struct
 {
   char * ssid;
@@ -37,12 +60,68 @@ typedef struct
 
 extern std::vector<wifiAPEntry> apList;
 
+/**
+ * Access point of the last successful connection,
+ * used to connect without scanning all channels after power up
+ */
+typedef struct
+{
+  char ssid[33];
+  uint8_t bssid[6];
+  int32_t channel;
+  bool valid = false;
+} lastAPInfo;
+
+extern lastAPInfo lastAP;
+
+/**
+ * One network found by the last WiFi scan
+ */
+typedef struct
+{
+  char ssid[33];
+  int32_t rssi;
+  bool open;
+} scanEntry;
+
+/**
+ * Results of the last completed WiFi scan, only to be used from the main loop
+ */
+extern std::vector<scanEntry> scanResults;
+
+/**
+ * millis() value when scanResults were taken, 0 if no scan has completed yet
+ */
+extern uint32_t scanTime;
+
+/**
+ * A scan has been requested but not started yet / is running in the background
+ */
+extern bool scanRequested;
+extern bool scanRunning;
+
+/**
+ * The last requested scan has been dropped after waiting SCAN_REQUEST_TIMEOUT_MS
+ */
+extern bool scanRefused;
+
+/**
+ * Request a new WiFi scan, started by handleWiFi() as soon as no
+ * wiThrottle session needs the radio, or refused after SCAN_REQUEST_TIMEOUT_MS
+ */
+void requestWiFiScan(void);
+
 void initWiFi(void);
 
 void initWiFiSTA(void);
 
 void shutdownWiFiSTA(void);
 
+/**
+ * Call once the station is connected, remembers the access point
+ */
+void wifiConnected(void);
+
 void initMDNS(void);
 
 void initWiFiAP(void);
@@ -53,8 +132,6 @@ void shutdownWiFiConfigSTA(void);
 
 void handleWiFi(void);
 
-void scanWifi(void);
-
 void broadcastUDP(void);
 
 #endif
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+
+# This file is part of the wiFred wireless model railroading throttle project
+# Copyright (C) 2018-2026 Heiko Rosemann
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>
+#
+# This file is a small HTTP load generator to check that requests to the
+# configuration webserver do not stall the main loop of the wiFred.
+#
+# It requests the given pages from a number of parallel clients for a while
+# and reports request rate and latency. Before and after the run it reads
+# /api/v1/status and reports the main loop pass durations seen during the
+# run, i.e. the worst case loop latency under HTTP load. Run it together with
+# withrottle-standin.py --simulate to drive while the pages are loaded.
+#
+# Usage:
+#   http-load.py HOST [--duration 30] [--concurrency 4]
+#                     [--paths / /wifred.js /api/v1/status /api/getConfigXML]
+
+import argparse
+import json
+import statistics
+import threading
+import time
+import urllib.request
+
+DEFAULT_PATHS = ["/", "/wifred.js", "/api/v1/status", "/api/getConfigXML"]
+
+
+def getStatus(base):
+    with urllib.request.urlopen(base + "/api/v1/status?fields=loop", timeout=10) as response:
+        return json.load(response)["loop"]
+
+
+def client(base, paths, until, times, errors, lock):
+    n = 0
+    while time.monotonic() < until:
+        path = paths[n % len(paths)]
+        n += 1
+        start = time.monotonic()
+        try:
+            with urllib.request.urlopen(base + path, timeout=10) as response:
+                response.read()
+        except Exception:
+            with lock:
+                errors.append(path)
+            continue
+        with lock:
+            times.append((time.monotonic() - start) * 1000)
+
+
+def bucketName(bucket, previous):
+    if "below" in bucket:
+        return f"< {bucket['below']} ms"
+    return f">= {previous['below']} ms"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="HTTP load generator for wiFred loop latency measurements")
+    parser.add_argument("host", help="wiFred host name or address")
+    parser.add_argument("--duration", type=float, default=30, help="run time (s)")
+    parser.add_argument("--concurrency", type=int, default=4, help="number of parallel clients")
+    parser.add_argument("--paths", nargs="+", default=DEFAULT_PATHS, help="pages to request in turn")
+    args = parser.parse_args()
+
+    base = args.host if args.host.startswith("http") else "http://" + args.host
+    before = getStatus(base)
+
+    times = []
+    errors = []
+    lock = threading.Lock()
+    until = time.monotonic() + args.duration
+    clients = [threading.Thread(target=client, args=(base, args.paths, until, times, errors, lock))
+               for n in range(args.concurrency)]
+    for thread in clients:
+        thread.start()
+    for thread in clients:
+        thread.join()
+
+    after = getStatus(base)
+
+    print(f"=== {args.concurrency} clients, {len(times)} requests in {args.duration:.0f} s "
+          f"({len(times) / args.duration:.1f}/s), {len(errors)} failed")
+    if times:
+        times.sort()
+        print(f"    request latency: median {statistics.median(times):.1f} ms, "
+              f"p99 {times[int(len(times) * 0.99)]:.1f} ms, max {times[-1]:.1f} ms")
+
+    print(f"=== main loop: {after['perSecond']} passes/s, longest pass since boot {after['maxLatency']} ms")
+    worst = None
+    for i, (old, new) in enumerate(zip(before["latency"], after["latency"])):
+        count = new["count"] - old["count"]
+        name = bucketName(new, after["latency"][i - 1] if i > 0 else None)
+        print(f"    {name:12s} {count}")
+        if count > 0:
+            worst = name
+    print(f"    worst pass during the run: {worst}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,281 @@
+#!/usr/bin/env python3
+
+# This file is part of the wiFred wireless model railroading throttle project
+# Copyright (C) 2018-2026 Heiko Rosemann
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>
+#
+# This file is a minimal stand-in for a wiThrottle server (like JMRI) to
+# measure how the wiFred firmware behaves on the wire without a layout.
+#
+# It answers the subset of the protocol used by the wiFred (greeting,
+# heartbeat, MT+/MT-/MTA including the function readout) and counts bytes,
+# TCP segments and commands per connection. Optionally it starts a number
+# of simulated throttles which drive a loco each and measure the round trip
+# time from a speed command to the server's echo.
+#
+# With --drop-after the server drops each connection a number of seconds
+# after the first loco has been acquired and measures the time until the
+# wiFred has reconnected and acquired all of its locos again.
+#
+# Usage:
+#   withrottle-standin.py [--port 12090] [--timeout 10] [--simulate N]
+#                         [--rate 10] [--duration 30] [--drop-after S]
+#
+# Point a wiFred at the machine running this script (manual server setting)
+# and press Ctrl-C to get the statistics of all connections.
+
+import argparse
+import asyncio
+import statistics
+import time
+
+NUM_FUNCTIONS = 29
+
+
+class Loco:
+    def __init__(self):
+        self.speed = 0
+        self.forward = True
+        self.mode = 1
+        self.functions = [False] * NUM_FUNCTIONS
+        self.momentary = [False] * NUM_FUNCTIONS
+
+
+class ConnectionStats:
+    def __init__(self, peer):
+        self.peer = peer
+        self.name = "?"
+        self.start = time.monotonic()
+        self.bytes = 0
+        self.segments = 0
+        self.commands = 0
+        self.kinds = {}
+        self.speedTimes = []
+        self.reported = False
+
+    def count(self, kind):
+        self.kinds[kind] = self.kinds.get(kind, 0) + 1
+
+    def report(self):
+        self.reported = True
+        duration = time.monotonic() - self.start
+        print(f"--- {self.name} ({self.peer}), {duration:.1f} s")
+        print(f"    {self.bytes} bytes, {self.segments} segments, {self.commands} commands")
+        if self.segments:
+            print(f"    {self.commands / self.segments:.2f} commands/segment, "
+                  f"{self.bytes / self.segments:.1f} bytes/segment")
+        for kind, number in sorted(self.kinds.items()):
+            print(f"    {kind:12s} {number}")
+        if len(self.speedTimes) > 1:
+            gaps = [(b - a) * 1000 for a, b in zip(self.speedTimes, self.speedTimes[1:])]
+            print(f"    speed updates: min gap {min(gaps):.0f} ms, "
+                  f"median gap {statistics.median(gaps):.0f} ms")
+
+
+class WiThrottleServer(asyncio.Protocol):
+    allStats = []
+    # host -> (time of the drop, keys of the locos not acquired again yet)
+    drops = {}
+    recoveryTimes = []
+
+    def __init__(self, timeout, verbose, dropAfter=0):
+        self.timeout = timeout
+        self.verbose = verbose
+        self.dropAfter = dropAfter
+        self.dropTimer = None
+        self.buffer = b""
+        self.locos = {}
+
+    def connection_made(self, transport):
+        self.transport = transport
+        self.stats = ConnectionStats(transport.get_extra_info("peername"))
+        WiThrottleServer.allStats.append(self.stats)
+        self.send("VN2.0", "RL0", "PPA1", "PW12080", f"*{self.timeout}")
+
+    def connection_lost(self, exc):
+        if self.dropTimer:
+            self.dropTimer.cancel()
+        if self.verbose:
+            self.stats.report()
+
+    def drop(self):
+        host = self.stats.peer[0]
+        print(f"*** dropping connection to {self.stats.name} ({host}) with {len(self.locos)} locos")
+        WiThrottleServer.drops[host] = (time.monotonic(), set(self.locos))
+        self.transport.abort()
+
+    def checkRecovery(self, key):
+        host = self.stats.peer[0]
+        if host not in WiThrottleServer.drops:
+            return
+        dropTime, pending = WiThrottleServer.drops[host]
+        pending.discard(key)
+        if not pending:
+            recovery = (time.monotonic() - dropTime) * 1000
+            WiThrottleServer.recoveryTimes.append(recovery)
+            print(f"*** {self.stats.name} recovered all locos {recovery:.0f} ms after the drop")
+            del WiThrottleServer.drops[host]
+
+    def send(self, *lines):
+        self.transport.write("".join(line + "\n" for line in lines).encode())
+
+    def data_received(self, data):
+        self.stats.bytes += len(data)
+        self.stats.segments += 1
+        self.buffer += data
+        while b"\n" in self.buffer:
+            line, self.buffer = self.buffer.split(b"\n", 1)
+            line = line.decode(errors="replace").strip()
+            if line:
+                self.stats.commands += 1
+                self.handleLine(line)
+
+    def handleLine(self, line):
+        if line.startswith("N"):
+            self.stats.name = line[1:]
+            self.stats.count("name")
+            self.send(f"*{self.timeout}")
+        elif line.startswith("HU"):
+            self.stats.count("id")
+        elif line.startswith("*"):
+            self.stats.count("heartbeat")
+        elif line == "Q":
+            self.stats.count("quit")
+            self.transport.close()
+        elif line.startswith("MT") and "<;>" in line:
+            self.handleThrottle(line[2], *line[3:].split("<;>", 1))
+        else:
+            self.stats.count("other")
+
+    def handleThrottle(self, kind, key, action):
+        if kind == "+":
+            self.stats.count("acquire")
+            self.checkRecovery(key)
+            if self.dropAfter and self.dropTimer is None:
+                self.dropTimer = asyncio.get_running_loop().call_later(self.dropAfter, self.drop)
+            loco = self.locos.setdefault(key, Loco())
+            self.send(f"MT+{key}<;>")
+            self.send(*[f"MTA{key}<;>F{int(on)}{f}" for f, on in enumerate(loco.functions)])
+            self.send(f"MTA{key}<;>V{loco.speed}", f"MTA{key}<;>R{int(loco.forward)}",
+                      f"MTA{key}<;>s{loco.mode}")
+        elif kind == "-":
+            self.stats.count("release")
+            self.locos.pop(key, None)
+            self.send(f"MT-{key}<;>")
+        elif kind == "A":
+            keys = list(self.locos) if key == "*" else [key]
+            self.stats.count("action" + ("*" if key == "*" else ""))
+            for k in keys:
+                if k in self.locos:
+                    self.handleAction(k, self.locos[k], action)
+
+    def handleAction(self, key, loco, action):
+        command, value = action[:1], action[1:]
+        if command == "V":
+            self.stats.speedTimes.append(time.monotonic())
+            loco.speed = int(value)
+            self.send(f"MTA{key}<;>V{loco.speed}")
+        elif command == "X":
+            loco.speed = -1
+            self.send(f"MTA{key}<;>V-1")
+        elif command == "R":
+            loco.forward = value == "1"
+            self.send(f"MTA{key}<;>R{value}")
+        elif command == "s":
+            self.send(f"MTA{key}<;>s{value}")
+        elif command in ("F", "f", "m"):
+            pressed, f = value[:1] == "1", int(value[1:])
+            if f >= NUM_FUNCTIONS:
+                return
+            if command == "m":
+                loco.momentary[f] = pressed
+                return
+            if command == "f":
+                loco.functions[f] = pressed
+            elif loco.momentary[f]:
+                loco.functions[f] = pressed
+            elif pressed:
+                loco.functions[f] = not loco.functions[f]
+            else:
+                return
+            self.send(f"MTA{key}<;>F{int(loco.functions[f])}{f}")
+        elif command == "q":
+            if value == "V":
+                self.send(f"MTA{key}<;>V{loco.speed}")
+            elif value == "R":
+                self.send(f"MTA{key}<;>R{int(loco.forward)}")
+
+
+async def simulatedThrottle(number, port, rate, duration, roundTrips):
+    reader, writer = await asyncio.open_connection("127.0.0.1", port)
+    key = f"L{1000 + number}"
+    writer.write(f"Nsimulated{number}\nHU{number:012x}\n*+\nMT+{key}<;>{key}\n".encode())
+    while not (await reader.readline()).startswith(f"MTA{key}<;>s".encode()):
+        pass
+    speed = 0
+    end = time.monotonic() + duration
+    while time.monotonic() < end:
+        speed = (speed + 1) % 127
+        sent = time.monotonic()
+        writer.write(f"MTA{key}<;>V{speed}\n".encode())
+        await writer.drain()
+        while not (await reader.readline()).startswith(f"MTA{key}<;>V".encode()):
+            pass
+        roundTrips.append((time.monotonic() - sent) * 1000)
+        await asyncio.sleep(1 / rate)
+    writer.write(f"MT-{key}<;>r\nQ\n".encode())
+    await writer.drain()
+    writer.close()
+
+
+async def main():
+    parser = argparse.ArgumentParser(description="wiThrottle stand-in server for wiFred measurements")
+    parser.add_argument("--port", type=int, default=12090)
+    parser.add_argument("--timeout", type=int, default=10, help="heartbeat timeout sent to clients (s)")
+    parser.add_argument("--simulate", type=int, default=0, help="number of simulated throttles to run")
+    parser.add_argument("--rate", type=float, default=10, help="speed commands per second per simulated throttle")
+    parser.add_argument("--duration", type=float, default=30, help="run time of simulated throttles (s)")
+    parser.add_argument("--drop-after", type=float, default=0,
+                        help="drop each connection this long after the first acquire to measure the recovery (s)")
+    args = parser.parse_args()
+
+    loop = asyncio.get_running_loop()
+    server = await loop.create_server(lambda: WiThrottleServer(args.timeout, args.simulate == 0, args.drop_after), "0.0.0.0", args.port)
+    print(f"wiThrottle stand-in listening on port {args.port}")
+
+    async with server:
+        if args.simulate > 0:
+            roundTrips = []
+            await asyncio.gather(*[simulatedThrottle(n, args.port, args.rate, args.duration, roundTrips)
+                                   for n in range(args.simulate)])
+            roundTrips.sort()
+            print(f"=== {args.simulate} simulated throttles, {len(roundTrips)} speed commands")
+            print(f"    round trip: median {statistics.median(roundTrips):.2f} ms, "
+                  f"p99 {roundTrips[int(len(roundTrips) * 0.99)]:.2f} ms, max {roundTrips[-1]:.2f} ms")
+        else:
+            await server.serve_forever()
+
+
+if __name__ == "__main__":
+    try:
+        asyncio.run(main())
+    except KeyboardInterrupt:
+        for stats in WiThrottleServer.allStats:
+            if not stats.reported:
+                stats.report()
+        times = WiThrottleServer.recoveryTimes
+        if times:
+            print(f"=== {len(times)} recoveries after dropped connections: "
+                  f"median {statistics.median(times):.0f} ms, max {max(times):.0f} ms")